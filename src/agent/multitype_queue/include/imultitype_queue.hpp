@@ -19,6 +19,11 @@ public:
     virtual ~IMultiTypeQueue() = default;
 
     /// @brief Pushes a single message onto the queue.
+    ///
+    /// If the message data is an array, each element is stored as a separate
+    /// message, all of them in a single transaction. The array is only stored
+    /// if the queue has room for all of its elements.
+    ///
     /// @param message The message to be pushed.
     /// @param shouldWait If true, the function waits until the message is pushed.
     /// @return int The number of messages pushed.
@@ -30,6 +35,11 @@ public:
     virtual boost::asio::awaitable<int> pushAwaitable(Message message) = 0;
 
     /// @brief Pushes a vector of messages onto the queue.
+    ///
+    /// Consecutive messages with the same type, module and metadata are pushed
+    /// together, in a single transaction. When the queue fills up the messages
+    /// that fit are kept and the rest are dropped.
+    ///
     /// @param messages The vector of messages to be pushed.
     /// @return int The number of messages pushed.
     virtual int push(std::vector<Message> messages) = 0;
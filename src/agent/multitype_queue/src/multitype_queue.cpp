@@ -12,6 +12,24 @@ namespace
     constexpr auto MAX_BATCH_INTERVAL = 60 * 60 * 1000;
     constexpr auto MIN_QUEUE_SIZE = 1000;
     constexpr auto MAX_QUEUE_SIZE = 60 * 60 * 1000;
+
+    /// @brief Gets the id of the item a stateful message holds the state of, empty for any other message
+    std::string GetItemId(const Message& message)
+    {
+        if (message.type != MessageType::STATEFUL || message.metaData.empty())
+        {
+            return {};
+        }
+
+        const auto metadata = nlohmann::json::parse(message.metaData, nullptr, false);
+
+        if (metadata.is_object() && metadata.contains("id") && metadata["id"].is_string())
+        {
+            return metadata["id"].get<std::string>();
+        }
+
+        return {};
+    }
 } // namespace
 
 MultiTypeQueue::MultiTypeQueue(std::shared_ptr<configuration::ConfigurationParser> configurationParser)
@@ -63,19 +81,24 @@ int MultiTypeQueue::push(Message message, bool shouldWait)
 
         const auto storedMessages = static_cast<size_t>(m_persistenceDest->GetElementCount(sMessageType));
         const auto spaceAvailable = (m_maxItems > storedMessages) ? m_maxItems - storedMessages : 0;
-        if (spaceAvailable)
+        const auto itemId = GetItemId(message);
+
+        // A full queue still takes the state of an item that replaces or cancels a queued one, the storage
+        // checks it as the message doesn't take any more space then
+        if (spaceAvailable || !itemId.empty())
         {
-            auto messageData = message.data;
-            if (messageData.is_array())
+            if (message.data.is_array())
             {
-                if (messageData.size() <= spaceAvailable)
+                if (message.data.size() <= spaceAvailable)
                 {
-                    for (const auto& singleMessageData : messageData)
-                    {
-                        result += m_persistenceDest->Store(
-                            singleMessageData, sMessageType, message.moduleName, message.moduleType, message.metaData);
-                        m_cv.notify_all();
-                    }
+                    result = m_persistenceDest->Store(message.data,
+                                                      sMessageType,
+                                                      message.moduleName,
+                                                      message.moduleType,
+                                                      message.metaData,
+                                                      itemId,
+                                                      spaceAvailable);
+                    m_cv.notify_all();
                 }
             }
             else
@@ -84,7 +107,9 @@ int MultiTypeQueue::push(Message message, bool shouldWait)
                                                   m_mapMessageTypeName.at(message.type),
                                                   message.moduleName,
                                                   message.moduleType,
-                                                  message.metaData);
+                                                  message.metaData,
+                                                  itemId,
+                                                  spaceAvailable);
                 m_cv.notify_all();
             }
         }
@@ -115,17 +140,17 @@ boost::asio::awaitable<int> MultiTypeQueue::pushAwaitable(Message message)
         const auto availableItems = (m_maxItems > storedItems) ? m_maxItems - storedItems : 0;
         if (availableItems)
         {
-            auto messageData = message.data;
-            if (messageData.is_array())
+            if (message.data.is_array())
             {
-                if (messageData.size() <= availableItems)
+                if (message.data.size() <= availableItems)
                 {
-                    for (const auto& singleMessageData : messageData)
-                    {
-                        result += m_persistenceDest->Store(
-                            singleMessageData, sMessageType, message.moduleName, message.moduleType, message.metaData);
-                        m_cv.notify_all();
-                    }
+                    result = m_persistenceDest->Store(message.data,
+                                                      sMessageType,
+                                                      message.moduleName,
+                                                      message.moduleType,
+                                                      message.metaData,
+                                                      GetItemId(message));
+                    m_cv.notify_all();
                 }
             }
             else
@@ -134,7 +159,8 @@ boost::asio::awaitable<int> MultiTypeQueue::pushAwaitable(Message message)
                                                   m_mapMessageTypeName.at(message.type),
                                                   message.moduleName,
                                                   message.moduleType,
-                                                  message.metaData);
+                                                  message.metaData,
+                                                  GetItemId(message));
                 m_cv.notify_all();
             }
         }
@@ -149,10 +175,59 @@ boost::asio::awaitable<int> MultiTypeQueue::pushAwaitable(Message message)
 int MultiTypeQueue::push(std::vector<Message> messages)
 {
     int result = 0;
-    for (const auto& singleMessage : messages)
+    auto first = messages.begin();
+
+    while (first != messages.end())
     {
-        result += push(singleMessage);
+        // Storing the whole batch in one call takes a single transaction
+        Message batch(first->type, nlohmann::json::array(), first->moduleName, first->moduleType, first->metaData);
+        auto last = first;
+
+        for (; last != messages.end() && last->type == batch.type && last->moduleName == batch.moduleName &&
+               last->moduleType == batch.moduleType && last->metaData == batch.metaData;
+             ++last)
+        {
+            if (last->data.is_array())
+            {
+                for (auto& singleMessageData : last->data)
+                {
+                    batch.data.push_back(std::move(singleMessageData));
+                }
+            }
+            else
+            {
+                batch.data.push_back(std::move(last->data));
+            }
+        }
+
+        if (m_mapMessageTypeName.contains(batch.type))
+        {
+            const auto& sMessageType = m_mapMessageTypeName.at(batch.type);
+            const auto storedMessages = static_cast<size_t>(m_persistenceDest->GetElementCount(sMessageType));
+            const auto spaceAvailable = (m_maxItems > storedMessages) ? m_maxItems - storedMessages : 0;
+            const auto itemId = GetItemId(batch);
+
+            // The messages that fit are stored, as if they had been pushed one at a time
+            if (spaceAvailable || !itemId.empty())
+            {
+                result += m_persistenceDest->Store(batch.data,
+                                                   sMessageType,
+                                                   batch.moduleName,
+                                                   batch.moduleType,
+                                                   batch.metaData,
+                                                   itemId,
+                                                   spaceAvailable);
+                m_cv.notify_all();
+            }
+        }
+        else
+        {
+            LogError("Error didn't find the queue.");
+        }
+
+        first = last;
     }
+
     return result;
 }
 
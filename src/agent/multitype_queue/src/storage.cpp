@@ -19,8 +19,27 @@ namespace
     const std::string MODULE_TYPE_COLUMN_NAME = "module_type";
     const std::string METADATA_COLUMN_NAME = "metadata";
     const std::string MESSAGE_COLUMN_NAME = "message";
+    const std::string ITEM_ID_COLUMN_NAME = "item_id";
 
-    nlohmann::json ProcessRequest(const std::vector<Row>& rows, size_t maxSize = 0)
+    // metadata operations
+    const std::string OPERATION_KEY = "operation";
+    const std::string CREATE_OPERATION = "create";
+    const std::string DELETE_OPERATION = "delete";
+
+    /// @brief Gets the operation of a message from its metadata, empty if it has none
+    std::string GetOperation(const std::string& metadata)
+    {
+        const auto metadataJson = nlohmann::json::parse(metadata, nullptr, false);
+
+        if (metadataJson.is_object() && metadataJson.contains(OPERATION_KEY) && metadataJson[OPERATION_KEY].is_string())
+        {
+            return metadataJson[OPERATION_KEY].get<std::string>();
+        }
+
+        return {};
+    }
+
+    nlohmann::json ProcessRequest(const std::vector<Row>& rows, int64_t& lastRowId, size_t maxSize = 0)
     {
         nlohmann::json messages = nlohmann::json::array();
         size_t sizeAccum = 0;
@@ -31,6 +50,7 @@ namespace
             const std::string moduleTypeString = row[1].Value;
             const std::string metadataString = row[2].Value;
             const std::string dataString = row[3].Value;
+            lastRowId = std::stoll(row[4].Value);
 
             nlohmann::json outputJson = {{"moduleName", ""}, {"moduleType", ""}, {"metadata", ""}, {"data", {}}};
 
@@ -85,6 +105,11 @@ Storage::Storage(const std::string& dbFolderPath, const std::vector<std::string>
             {
                 CreateTable(table);
             }
+            else
+            {
+                // Queues created before messages were keyed by item lack the column
+                m_db->AddColumn(table, ColumnKey(ITEM_ID_COLUMN_NAME, ColumnType::TEXT, UNIQUE));
+            }
         }
     }
     catch (const std::exception&)
@@ -104,6 +129,7 @@ void Storage::CreateTable(const std::string& tableName)
         columns.emplace_back(MODULE_TYPE_COLUMN_NAME, ColumnType::TEXT);
         columns.emplace_back(METADATA_COLUMN_NAME, ColumnType::TEXT);
         columns.emplace_back(MESSAGE_COLUMN_NAME, ColumnType::TEXT, NOT_NULL);
+        columns.emplace_back(ITEM_ID_COLUMN_NAME, ColumnType::TEXT, UNIQUE);
 
         m_db->CreateTable(tableName, columns);
     }
@@ -135,50 +161,77 @@ int Storage::Store(const nlohmann::json& message,
                    const std::string& tableName,
                    const std::string& moduleName,
                    const std::string& moduleType,
-                   const std::string& metadata)
+                   const std::string& metadata,
+                   const std::string& itemId,
+                   const size_t maxNewRows)
 {
-    Row fields;
-    fields.emplace_back(MODULE_NAME_COLUMN_NAME, ColumnType::TEXT, moduleName);
-    fields.emplace_back(MODULE_TYPE_COLUMN_NAME, ColumnType::TEXT, moduleType);
-    fields.emplace_back(METADATA_COLUMN_NAME, ColumnType::TEXT, metadata);
-
     int result = 0;
+    auto availableRows = maxNewRows;
 
     const std::unique_lock<std::mutex> lock(m_mutex);
 
     auto transaction = m_db->BeginTransaction();
 
-    if (message.is_array())
+    const auto storeSingleMessage = [&](const nlohmann::json& singleMessageData)
     {
-        for (const auto& singleMessageData : message)
+        try
         {
-            fields.emplace_back(MESSAGE_COLUMN_NAME, ColumnType::TEXT, singleMessageData.dump());
+            auto messageMetadata = metadata;
+            auto supersede = availableRows > 0 ? Supersede::ADD : Supersede::NO_SPACE;
 
-            try
+            if (!itemId.empty())
             {
-                m_db->Insert(tableName, fields);
-                result++;
+                supersede = SupersedePending(tableName, itemId, messageMetadata, availableRows > 0);
             }
-            catch (const std::exception& e)
+
+            if (supersede == Supersede::NO_SPACE)
             {
-                LogError("Error during Store operation: {}.", e.what());
+                return;
             }
-            fields.pop_back();
-        }
-    }
-    else
-    {
-        fields.emplace_back(MESSAGE_COLUMN_NAME, ColumnType::TEXT, message.dump());
 
-        try
-        {
-            m_db->Insert(tableName, fields);
+            if (supersede == Supersede::CANCEL && availableRows < std::numeric_limits<size_t>::max())
+            {
+                ++availableRows;
+            }
+
+            if (supersede != Supersede::CANCEL)
+            {
+                Row fields;
+                fields.emplace_back(MODULE_NAME_COLUMN_NAME, ColumnType::TEXT, moduleName);
+                fields.emplace_back(MODULE_TYPE_COLUMN_NAME, ColumnType::TEXT, moduleType);
+                fields.emplace_back(METADATA_COLUMN_NAME, ColumnType::TEXT, std::move(messageMetadata));
+                fields.emplace_back(MESSAGE_COLUMN_NAME, ColumnType::TEXT, singleMessageData.dump());
+
+                if (!itemId.empty())
+                {
+                    fields.emplace_back(ITEM_ID_COLUMN_NAME, ColumnType::TEXT, itemId);
+                }
+
+                m_db->Insert(tableName, fields);
+
+                if (supersede == Supersede::ADD)
+                {
+                    --availableRows;
+                }
+            }
             result++;
         }
         catch (const std::exception& e)
         {
             LogError("Error during Store operation: {}.", e.what());
         }
+    };
+
+    if (message.is_array())
+    {
+        for (const auto& singleMessageData : message)
+        {
+            storeSingleMessage(singleMessageData);
+        }
+    }
+    else
+    {
+        storeSingleMessage(message);
     }
 
     m_db->CommitTransaction(transaction);
@@ -186,6 +239,67 @@ int Storage::Store(const nlohmann::json& message,
     return result;
 }
 
+Storage::Supersede Storage::SupersedePending(const std::string& tableName,
+                                             const std::string& itemId,
+                                             std::string& metadata,
+                                             const bool hasSpace)
+{
+    Names columns;
+    columns.emplace_back(ROW_ID_COLUMN_NAME, ColumnType::INTEGER);
+    columns.emplace_back(METADATA_COLUMN_NAME, ColumnType::TEXT);
+
+    Criteria filters;
+    filters.emplace_back(ITEM_ID_COLUMN_NAME, ColumnType::TEXT, itemId);
+
+    const auto pending = m_db->Select(tableName, columns, filters, LogicalOperator::AND, {}, OrderType::ASC, 1);
+
+    if (pending.empty())
+    {
+        return hasSpace ? Supersede::ADD : Supersede::NO_SPACE;
+    }
+
+    Criteria pendingRow;
+    pendingRow.emplace_back(ROW_ID_COLUMN_NAME, ColumnType::INTEGER, pending[0][0].Value);
+
+    const auto retrievedIt = m_retrievedRowIds.find(tableName);
+
+    if (retrievedIt != m_retrievedRowIds.end() && std::stoll(pending[0][0].Value) <= retrievedIt->second)
+    {
+        if (!hasSpace)
+        {
+            return Supersede::NO_SPACE;
+        }
+
+        // The pending message may be on its way to the manager and will be removed by position once it is
+        // delivered, so it stays as it is. Only its key is cleared.
+        Row clearedKey;
+        clearedKey.emplace_back(ITEM_ID_COLUMN_NAME, ColumnType::TEXT, nullptr);
+        m_db->Update(tableName, clearedKey, pendingRow, LogicalOperator::AND);
+        return Supersede::ADD;
+    }
+
+    m_db->Remove(tableName, pendingRow, LogicalOperator::AND);
+
+    // The manager hasn't heard of an item whose creation is still queued
+    if (GetOperation(pending[0][1].Value) == CREATE_OPERATION)
+    {
+        if (GetOperation(metadata) == DELETE_OPERATION)
+        {
+            return Supersede::CANCEL;
+        }
+
+        auto metadataJson = nlohmann::json::parse(metadata, nullptr, false);
+
+        if (metadataJson.is_object())
+        {
+            metadataJson[OPERATION_KEY] = CREATE_OPERATION;
+            metadata = metadataJson.dump();
+        }
+    }
+
+    return Supersede::REPLACE;
+}
+
 int Storage::RemoveMultiple(int n,
                             const std::string& tableName,
                             const std::string& moduleName,
@@ -254,6 +368,7 @@ nlohmann::json Storage::RetrieveMultiple(int n,
     columns.emplace_back(MODULE_TYPE_COLUMN_NAME, ColumnType::TEXT);
     columns.emplace_back(METADATA_COLUMN_NAME, ColumnType::TEXT);
     columns.emplace_back(MESSAGE_COLUMN_NAME, ColumnType::TEXT);
+    columns.emplace_back(ROW_ID_COLUMN_NAME, ColumnType::INTEGER);
 
     Criteria filters;
     if (!moduleName.empty())
@@ -264,12 +379,17 @@ nlohmann::json Storage::RetrieveMultiple(int n,
     Names orderColumns;
     orderColumns.emplace_back(ROW_ID_COLUMN_NAME, ColumnType::INTEGER);
 
+    const std::unique_lock<std::mutex> lock(m_mutex);
+
     try
     {
         const auto results =
             m_db->Select(tableName, columns, filters, LogicalOperator::AND, orderColumns, OrderType::ASC, n);
 
-        return ProcessRequest(results);
+        int64_t lastRowId = 0;
+        auto messages = ProcessRequest(results, lastRowId);
+        m_retrievedRowIds[tableName] = lastRowId;
+        return messages;
     }
     catch (const std::exception& e)
     {
@@ -288,6 +408,7 @@ nlohmann::json Storage::RetrieveBySize(size_t n,
     columns.emplace_back(MODULE_TYPE_COLUMN_NAME, ColumnType::TEXT);
     columns.emplace_back(METADATA_COLUMN_NAME, ColumnType::TEXT);
     columns.emplace_back(MESSAGE_COLUMN_NAME, ColumnType::TEXT);
+    columns.emplace_back(ROW_ID_COLUMN_NAME, ColumnType::INTEGER);
 
     Criteria filters;
     if (!moduleName.empty())
@@ -298,12 +419,17 @@ nlohmann::json Storage::RetrieveBySize(size_t n,
     Names orderColumns;
     orderColumns.emplace_back(ROW_ID_COLUMN_NAME, ColumnType::INTEGER);
 
+    const std::unique_lock<std::mutex> lock(m_mutex);
+
     try
     {
         const auto results =
             m_db->Select(tableName, columns, filters, LogicalOperator::AND, orderColumns, OrderType::ASC);
 
-        return ProcessRequest(results, n);
+        int64_t lastRowId = 0;
+        auto messages = ProcessRequest(results, lastRowId, n);
+        m_retrievedRowIds[tableName] = lastRowId;
+        return messages;
     }
     catch (const std::exception& e)
     {
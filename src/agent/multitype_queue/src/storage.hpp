@@ -2,6 +2,9 @@
 
 #include <nlohmann/json.hpp>
 
+#include <cstdint>
+#include <limits>
+#include <map>
 #include <memory>
 #include <mutex>
 #include <string>
@@ -46,12 +49,19 @@ public:
     /// @param moduleName The name of the module that created the message.
     /// @param moduleType The type of the module that created the message.
     /// @param metadata The metadata message to store.
+    /// @param itemId Id of the item whose state the message holds, empty if it isn't keyed. A queued message of the
+    /// same item that hasn't been retrieved yet is replaced, and if that one created the item and this one deletes
+    /// it, both are dropped.
+    /// @param maxNewRows The number of rows the table can still grow. Messages that replace or cancel a queued one
+    /// are stored even when it is 0.
     /// @return The number of stored elements.
     int Store(const nlohmann::json& message,
               const std::string& tableName,
               const std::string& moduleName = "",
               const std::string& moduleType = "",
-              const std::string& metadata = "");
+              const std::string& metadata = "",
+              const std::string& itemId = "",
+              size_t maxNewRows = std::numeric_limits<size_t>::max());
 
     /// @brief Remove multiple JSON messages.
     /// @param n The number of messages to remove.
@@ -109,9 +119,33 @@ private:
     /// @param tableName The name of the table to create.
     void CreateTable(const std::string& tableName);
 
+    /// @brief What storing the message of an item does to the table.
+    enum class Supersede
+    {
+        ADD,     ///< The message takes a new row
+        REPLACE, ///< The message takes the row of the queued one
+        CANCEL,  ///< The message deletes an item whose creation was queued, neither of them is kept
+        NO_SPACE ///< The message needs a new row and the table can't grow
+    };
+
+    /// @brief Removes the queued message of an item that is superseded by a new one.
+    /// @param tableName The name of the table.
+    /// @param itemId The id of the item.
+    /// @param metadata The metadata of the new message, its operation stays "create" if the creation was removed.
+    /// @param hasSpace Whether the table can grow, nothing is changed if the message needs a new row and it can't.
+    /// @return How the new message is stored.
+    Supersede SupersedePending(const std::string& tableName,
+                               const std::string& itemId,
+                               std::string& metadata,
+                               bool hasSpace);
+
     /// @brief Pointer to the database connection.
     std::unique_ptr<Persistence> m_db;
 
     /// @brief Mutex to ensure thread-safe operations.
     std::mutex m_mutex;
+
+    /// @brief Highest rowid handed out by the last retrieval of each table. Those messages may be in flight, and
+    /// they are removed by position once delivered, so they are never replaced.
+    std::map<std::string, int64_t> m_retrievedRowIds;
 };
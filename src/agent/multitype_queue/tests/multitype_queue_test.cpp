@@ -434,6 +434,45 @@ TEST_F(MultiTypeQueueTest, PushVectorWithAMultipleInside)
     EXPECT_EQ(6, multiTypeQueue.push(messages));
 }
 
+// push message vector larger than the space left
+TEST_F(MultiTypeQueueTest, PushVectorStoresTheMessagesThatFit)
+{
+    MultiTypeQueue multiTypeQueue(MOCK_CONFIG_PARSER_SMALL_SIZE);
+    const MessageType messageType {MessageType::COMMAND};
+
+    for (const int i : std::views::iota(0, static_cast<int>(SMALL_QUEUE_CAPACITY) - 2))
+    {
+        EXPECT_EQ(1, multiTypeQueue.push({messageType, {{"Data", std::to_string(i)}}}));
+    }
+
+    std::vector<Message> messages;
+    for (const std::string i : {"0", "1", "2", "3"})
+    {
+        messages.emplace_back(messageType, nlohmann::json {{"command", i}});
+    }
+
+    EXPECT_EQ(2, multiTypeQueue.push(messages));
+    EXPECT_TRUE(multiTypeQueue.isFull(messageType));
+}
+
+// push message vector mixing types and modules
+TEST_F(MultiTypeQueueTest, PushVectorWithDifferentTypesAndModules)
+{
+    MultiTypeQueue multiTypeQueue(MOCK_CONFIG_PARSER);
+
+    std::vector<Message> messages;
+    messages.emplace_back(MessageType::STATELESS, nlohmann::json {{"content", "0"}}, "moduleA");
+    messages.emplace_back(MessageType::STATELESS, nlohmann::json {{"content", "1"}}, "moduleA");
+    messages.emplace_back(MessageType::STATEFUL, nlohmann::json {{"content", "2"}}, "moduleA");
+    messages.emplace_back(MessageType::STATELESS, nlohmann::json {{"content", "3"}}, "moduleB");
+
+    EXPECT_EQ(multiTypeQueue.push(messages), 4);
+    EXPECT_EQ(multiTypeQueue.storedItems(MessageType::STATELESS), 3);
+    EXPECT_EQ(multiTypeQueue.storedItems(MessageType::STATEFUL), 1);
+    EXPECT_EQ(multiTypeQueue.storedItems(MessageType::STATELESS, "moduleA"), 2);
+    EXPECT_EQ(multiTypeQueue.storedItems(MessageType::STATELESS, "moduleB"), 1);
+}
+
 // Push Multiple, pop multiples
 TEST_F(MultiTypeQueueTest, PushMultipleGetMultiple)
 {
@@ -573,3 +612,50 @@ TEST_F(MultiTypeQueueTest, GetByBelowMax)
     const auto messagesReceived = multiTypeQueue.getNextBytes(MessageType::STATELESS, sizeAsked);
     EXPECT_EQ(1, messagesReceived.size());
 }
+
+TEST_F(MultiTypeQueueTest, StatefulPushReplacesPendingStateOfSameItem)
+{
+    MultiTypeQueue multiTypeQueue(MOCK_CONFIG_PARSER);
+    const std::string moduleName = "inventory";
+    const std::string metadata = R"({"id":"item1","operation":"update"})";
+
+    EXPECT_EQ(1, multiTypeQueue.push({MessageType::STATEFUL, {{"version", "1"}}, moduleName, "", metadata}));
+    EXPECT_EQ(1, multiTypeQueue.push({MessageType::STATEFUL, {{"version", "2"}}, moduleName, "", metadata}));
+    EXPECT_EQ(1, multiTypeQueue.storedItems(MessageType::STATEFUL));
+    EXPECT_EQ("2", multiTypeQueue.getNext(MessageType::STATEFUL).data["version"]);
+
+    // Other queues aren't keyed
+    EXPECT_EQ(1, multiTypeQueue.push({MessageType::STATELESS, {{"version", "1"}}, moduleName, "", metadata}));
+    EXPECT_EQ(1, multiTypeQueue.push({MessageType::STATELESS, {{"version", "2"}}, moduleName, "", metadata}));
+    EXPECT_EQ(2, multiTypeQueue.storedItems(MessageType::STATELESS));
+}
+
+TEST_F(MultiTypeQueueTest, FullQueueTakesStatesThatReplaceOrCancelPendingOnes)
+{
+    MultiTypeQueue multiTypeQueue(MOCK_CONFIG_PARSER_SMALL_SIZE);
+    const std::string moduleName = "inventory";
+    const std::string updateItem1 = R"({"id":"item1","operation":"update"})";
+    const std::string createItem2 = R"({"id":"item2","operation":"create"})";
+    const std::string deleteItem2 = R"({"id":"item2","operation":"delete"})";
+    const std::string createItem3 = R"({"id":"item3","operation":"create"})";
+
+    EXPECT_EQ(1, multiTypeQueue.push({MessageType::STATEFUL, {{"version", "1"}}, moduleName, "", updateItem1}));
+    EXPECT_EQ(1, multiTypeQueue.push({MessageType::STATEFUL, {{"version", "1"}}, moduleName, "", createItem2}));
+
+    for (const int i : std::views::iota(2, static_cast<int>(SMALL_QUEUE_CAPACITY)))
+    {
+        EXPECT_EQ(1, multiTypeQueue.push({MessageType::STATEFUL, {{"Data", std::to_string(i)}}}));
+    }
+    EXPECT_TRUE(multiTypeQueue.isFull(MessageType::STATEFUL));
+
+    // A new item needs a row of its own
+    EXPECT_EQ(0, multiTypeQueue.push({MessageType::STATEFUL, {{"version", "1"}}, moduleName, "", createItem3}));
+
+    // Replacing the pending state of an item takes its row
+    EXPECT_EQ(1, multiTypeQueue.push({MessageType::STATEFUL, {{"version", "2"}}, moduleName, "", updateItem1}));
+    EXPECT_EQ(SMALL_QUEUE_CAPACITY, multiTypeQueue.storedItems(MessageType::STATEFUL));
+
+    // Deleting an item whose creation is pending frees its row
+    EXPECT_EQ(1, multiTypeQueue.push({MessageType::STATEFUL, {{"version", "2"}}, moduleName, "", deleteItem2}));
+    EXPECT_EQ(SMALL_QUEUE_CAPACITY - 1, multiTypeQueue.storedItems(MessageType::STATEFUL));
+}
@@ -207,6 +207,62 @@ TEST_F(StorageTest, GetMessagesByMoreSize)
     EXPECT_EQ(retrievedMessages.size(), 2);
 }
 
+TEST_F(StorageTest, StoreKeyedMessageReplacesPending)
+{
+    const std::string update = R"({"id":"item1","operation":"update"})";
+    EXPECT_EQ(storage->Store({{"key", "value1"}}, tableName, moduleName, "", update, "item1"), 1);
+    EXPECT_EQ(storage->Store({{"key", "other"}}, tableName, moduleName, "", "", ""), 1);
+    EXPECT_EQ(storage->Store({{"key", "value2"}}, tableName, moduleName, "", update, "item1"), 1);
+    EXPECT_EQ(storage->GetElementCount(tableName), 2);
+
+    // The latest state of the item goes after the messages queued before it
+    const auto retrievedMessages = storage->RetrieveMultiple(2, tableName);
+    ASSERT_EQ(retrievedMessages.size(), 2);
+    EXPECT_EQ(retrievedMessages[0]["data"]["key"], "other");
+    EXPECT_EQ(retrievedMessages[1]["data"]["key"], "value2");
+}
+
+TEST_F(StorageTest, StoreKeyedDeleteCancelsPendingCreate)
+{
+    EXPECT_EQ(storage->Store(
+                  {{"key", "value1"}}, tableName, moduleName, "", R"({"id":"item1","operation":"create"})", "item1"),
+              1);
+    EXPECT_EQ(storage->Store({}, tableName, moduleName, "", R"({"id":"item1","operation":"delete"})", "item1"), 1);
+    EXPECT_EQ(storage->GetElementCount(tableName), 0);
+}
+
+TEST_F(StorageTest, StoreKeyedUpdateKeepsPendingCreate)
+{
+    EXPECT_EQ(storage->Store(
+                  {{"key", "value1"}}, tableName, moduleName, "", R"({"id":"item1","operation":"create"})", "item1"),
+              1);
+    EXPECT_EQ(storage->Store(
+                  {{"key", "value2"}}, tableName, moduleName, "", R"({"id":"item1","operation":"update"})", "item1"),
+              1);
+
+    const auto retrievedMessages = storage->RetrieveMultiple(2, tableName);
+    ASSERT_EQ(retrievedMessages.size(), 1);
+    EXPECT_EQ(retrievedMessages[0]["data"]["key"], "value2");
+    EXPECT_EQ(nlohmann::json::parse(retrievedMessages[0]["metadata"].get<std::string>())["operation"], "create");
+}
+
+TEST_F(StorageTest, StoreKeyedMessageKeepsRetrievedOne)
+{
+    const std::string update = R"({"id":"item1","operation":"update"})";
+    EXPECT_EQ(storage->Store({{"key", "value1"}}, tableName, moduleName, "", update, "item1"), 1);
+
+    // Once retrieved the message may be in flight, it's removed by position when delivered
+    EXPECT_EQ(storage->RetrieveBySize(1, tableName).size(), 1);
+    EXPECT_EQ(storage->Store({{"key", "value2"}}, tableName, moduleName, "", update, "item1"), 1);
+    EXPECT_EQ(storage->Store({{"key", "value3"}}, tableName, moduleName, "", update, "item1"), 1);
+    EXPECT_EQ(storage->GetElementCount(tableName), 2);
+
+    EXPECT_EQ(storage->RemoveMultiple(1, tableName), 1);
+    const auto retrievedMessages = storage->RetrieveMultiple(2, tableName);
+    ASSERT_EQ(retrievedMessages.size(), 1);
+    EXPECT_EQ(retrievedMessages[0]["data"]["key"], "value3");
+}
+
 class StorageMultithreadedTest : public ::testing::Test
 {
 protected:
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstddef>
 #include <string>
 #include <vector>
 
@@ -33,7 +34,8 @@ namespace column
         NONE = 0,
         NOT_NULL = 1 << 0,
         PRIMARY_KEY = 1 << 1,
-        AUTO_INCREMENT = 1 << 2
+        AUTO_INCREMENT = 1 << 2,
+        UNIQUE = 1 << 3
     };
 
     /// @brief Represents a database column.
@@ -63,7 +65,7 @@ namespace column
         /// @brief Constructor for defining a table column with attributes.
         /// @param name The name of the column.
         /// @param type The data type of the column (INTEGER, TEXT, or REAL).
-        /// @param attributes The attributes of the column (NOT_NULL, PRIMARY_KEY, AUTO_INCREMENT).
+        /// @param attributes The attributes of the column (NOT_NULL, PRIMARY_KEY, AUTO_INCREMENT, UNIQUE).
         ColumnKey(std::string name, const ColumnType type, const int attributes = NONE)
             : ColumnName(std::move(name), type)
             , Attributes(attributes)
@@ -88,8 +90,20 @@ namespace column
         {
         }
 
+        /// @brief Constructor for defining a column without a value (SQL NULL).
+        /// @param name The name of the column.
+        /// @param type The data type of the column.
+        ColumnValue(std::string name, const ColumnType type, std::nullptr_t)
+            : ColumnName(std::move(name), type)
+            , IsNull(true)
+        {
+        }
+
         /// @brief The value of the column as a string
         std::string Value;
+
+        /// @brief Whether the column holds no value, Value is empty then
+        bool IsNull {false};
     };
 
     using Names = std::vector<ColumnName>;
@@ -24,6 +24,11 @@ public:
     /// @param cols Keys specifying the table schema.
     virtual void CreateTable(const std::string& tableName, const column::Keys& cols) = 0;
 
+    /// @brief Adds a column to an existing table, unless the table already has it.
+    /// @param tableName The name of the table to alter.
+    /// @param col Key specifying the new column.
+    virtual void AddColumn(const std::string& tableName, const column::ColumnKey& col) = 0;
+
     /// @brief Inserts data into a specified table.
     /// @param tableName The name of the table where data is inserted.
     /// @param cols Row with values to insert.
@@ -27,6 +27,28 @@ namespace
     {
         return std::regex_replace(str, std::regex(TO_SEARCH), TO_REPLACE);
     }
+
+    /// @brief Formats the value of a column as an SQL literal.
+    std::string ValueLiteral(const ColumnValue& col)
+    {
+        if (col.IsNull)
+        {
+            return "NULL";
+        }
+
+        if (col.Type == ColumnType::TEXT)
+        {
+            return fmt::format("'{}'", EscapeSingleQuotes(col.Value));
+        }
+
+        return col.Value;
+    }
+
+    /// @brief Formats a column as a condition that matches its value.
+    std::string Condition(const ColumnValue& col)
+    {
+        return col.IsNull ? fmt::format("{} IS NULL", col.Name) : fmt::format("{}={}", col.Name, ValueLiteral(col));
+    }
 } // namespace
 
 ColumnType SQLiteManager::ColumnTypeFromSQLiteType(const int type) const
@@ -68,8 +90,11 @@ void SQLiteManager::CreateTable(const std::string& tableName, const Keys& cols)
     std::vector<std::string> fields;
     for (const auto& col : cols)
     {
-        const std::string field = fmt::format(
-            "{} {}{}", col.Name, MAP_COL_TYPE_STRING.at(col.Type), (col.Attributes & NOT_NULL) ? " NOT NULL" : "");
+        const std::string field = fmt::format("{} {}{}{}",
+                                              col.Name,
+                                              MAP_COL_TYPE_STRING.at(col.Type),
+                                              (col.Attributes & NOT_NULL) ? " NOT NULL" : "",
+                                              (col.Attributes & UNIQUE) ? " UNIQUE" : "");
         if (col.Attributes & PRIMARY_KEY)
         {
             pk.push_back((col.Attributes & AUTO_INCREMENT) ? fmt::format("{} AUTOINCREMENT", col.Name) : col.Name);
@@ -84,6 +109,38 @@ void SQLiteManager::CreateTable(const std::string& tableName, const Keys& cols)
     Execute(queryString);
 }
 
+void SQLiteManager::AddColumn(const std::string& tableName, const ColumnKey& col)
+{
+    try
+    {
+        const std::lock_guard<std::mutex> lock(m_mutex);
+        SQLite::Statement query(*m_db,
+                                fmt::format("SELECT name FROM pragma_table_info('{}') WHERE name='{}';",
+                                            EscapeSingleQuotes(tableName),
+                                            EscapeSingleQuotes(col.Name)));
+
+        if (query.executeStep())
+        {
+            return;
+        }
+    }
+    catch (const std::exception& e)
+    {
+        LogError("Failed to check if column exists: {}.", e.what());
+        throw;
+    }
+
+    // SQLite can't add a UNIQUE column to an existing table, the constraint is enforced by an index instead.
+    // NOT NULL would need a default value for the existing rows, so it isn't applied.
+    Execute(fmt::format("ALTER TABLE {} ADD COLUMN {} {}", tableName, col.Name, MAP_COL_TYPE_STRING.at(col.Type)));
+
+    if (col.Attributes & UNIQUE)
+    {
+        Execute(fmt::format(
+            "CREATE UNIQUE INDEX IF NOT EXISTS {}_{}_unique ON {} ({})", tableName, col.Name, tableName, col.Name));
+    }
+}
+
 void SQLiteManager::Insert(const std::string& tableName, const Row& cols)
 {
     std::vector<std::string> names;
@@ -92,15 +149,7 @@ void SQLiteManager::Insert(const std::string& tableName, const Row& cols)
     for (const auto& col : cols)
     {
         names.push_back(col.Name);
-        if (col.Type == ColumnType::TEXT)
-        {
-            auto escapedValue = EscapeSingleQuotes(col.Value);
-            values.push_back(fmt::format("'{}'", escapedValue));
-        }
-        else
-        {
-            values.push_back(col.Value);
-        }
+        values.push_back(ValueLiteral(col));
     }
 
     const std::string queryString =
@@ -123,15 +172,7 @@ void SQLiteManager::Update(const std::string& tableName,
     std::vector<std::string> setFields;
     for (const auto& col : fields)
     {
-        if (col.Type == ColumnType::TEXT)
-        {
-            auto escapedValue = EscapeSingleQuotes(col.Value);
-            setFields.push_back(fmt::format("{}='{}'", col.Name, escapedValue));
-        }
-        else
-        {
-            setFields.push_back(fmt::format("{}={}", col.Name, col.Value));
-        }
+        setFields.push_back(fmt::format("{}={}", col.Name, ValueLiteral(col)));
     }
     std::string updateValues = fmt::format("{}", fmt::join(setFields, ", "));
 
@@ -141,15 +182,7 @@ void SQLiteManager::Update(const std::string& tableName,
         std::vector<std::string> conditions;
         for (const auto& col : selCriteria)
         {
-            if (col.Type == ColumnType::TEXT)
-            {
-                auto escapedValue = EscapeSingleQuotes(col.Value);
-                conditions.push_back(fmt::format("{}='{}'", col.Name, escapedValue));
-            }
-            else
-            {
-                conditions.push_back(fmt::format("{}={}", col.Name, col.Value));
-            }
+            conditions.push_back(Condition(col));
         }
         whereClause = fmt::format(" WHERE {}", fmt::join(conditions, fmt::format(" {} ", MAP_LOGOP_STRING.at(logOp))));
     }
@@ -167,15 +200,7 @@ void SQLiteManager::Remove(const std::string& tableName, const Criteria& selCrit
         std::vector<std::string> critFields;
         for (const auto& col : selCriteria)
         {
-            if (col.Type == ColumnType::TEXT)
-            {
-                auto escapedValue = EscapeSingleQuotes(col.Value);
-                critFields.push_back(fmt::format("{}='{}'", col.Name, escapedValue));
-            }
-            else
-            {
-                critFields.push_back(fmt::format("{}={}", col.Name, col.Value));
-            }
+            critFields.push_back(Condition(col));
         }
         whereClause = fmt::format(" WHERE {}", fmt::join(critFields, fmt::format(" {} ", MAP_LOGOP_STRING.at(logOp))));
     }
@@ -237,15 +262,7 @@ std::vector<Row> SQLiteManager::Select(const std::string& tableName,
         std::vector<std::string> conditions;
         for (const auto& col : selCriteria)
         {
-            if (col.Type == ColumnType::TEXT)
-            {
-                auto escapedValue = EscapeSingleQuotes(col.Value);
-                conditions.push_back(fmt::format("{}='{}'", col.Name, escapedValue));
-            }
-            else
-            {
-                conditions.push_back(fmt::format("{}={}", col.Name, col.Value));
-            }
+            conditions.push_back(Condition(col));
         }
         condition = fmt::format("WHERE {}", fmt::join(conditions, fmt::format(" {} ", MAP_LOGOP_STRING.at(logOp))));
     }
@@ -282,6 +299,14 @@ std::vector<Row> SQLiteManager::Select(const std::string& tableName,
             queryFields.reserve(static_cast<size_t>(nColumns));
             for (int i = 0; i < nColumns; i++)
             {
+                if (query.getColumn(i).isNull())
+                {
+                    queryFields.emplace_back(query.getColumn(i).getName(),
+                                             ColumnTypeFromSQLiteType(query.getColumn(i).getType()),
+                                             nullptr);
+                    continue;
+                }
+
                 queryFields.emplace_back(query.getColumn(i).getName(),
                                          ColumnTypeFromSQLiteType(query.getColumn(i).getType()),
                                          query.getColumn(i).getString());
@@ -305,15 +330,7 @@ int SQLiteManager::GetCount(const std::string& tableName, const Criteria& selCri
         std::vector<std::string> conditions;
         for (const auto& col : selCriteria)
         {
-            if (col.Type == ColumnType::TEXT)
-            {
-                auto escapedValue = EscapeSingleQuotes(col.Value);
-                conditions.push_back(fmt::format("{}='{}'", col.Name, escapedValue));
-            }
-            else
-            {
-                conditions.push_back(fmt::format("{}={}", col.Name, col.Value));
-            }
+            conditions.push_back(Condition(col));
         }
         condition = fmt::format("WHERE {}", fmt::join(conditions, fmt::format(" {} ", MAP_LOGOP_STRING.at(logOp))));
     }
@@ -370,15 +387,7 @@ size_t SQLiteManager::GetSize(const std::string& tableName,
         std::vector<std::string> conditions;
         for (const auto& col : selCriteria)
         {
-            if (col.Type == ColumnType::TEXT)
-            {
-                auto escapedValue = EscapeSingleQuotes(col.Value);
-                conditions.push_back(fmt::format("{}='{}'", col.Name, escapedValue));
-            }
-            else
-            {
-                conditions.push_back(fmt::format("{}={}", col.Name, col.Value));
-            }
+            conditions.push_back(Condition(col));
         }
         condition = fmt::format("WHERE {}", fmt::join(conditions, fmt::format(" {} ", MAP_LOGOP_STRING.at(logOp))));
     }
@@ -49,6 +49,11 @@ public:
     /// @param cols Keys specifying the table schema.
     void CreateTable(const std::string& tableName, const column::Keys& cols) override;
 
+    /// @brief Adds a column to an existing table, unless the table already has it.
+    /// @param tableName The name of the table to alter.
+    /// @param col Key specifying the new column.
+    void AddColumn(const std::string& tableName, const column::ColumnKey& col) override;
+
     /// @brief Inserts data into a specified table.
     /// @param tableName The name of the table where data is inserted.
     /// @param cols Row with values to insert.
@@ -10,6 +10,7 @@ class MockPersistence : public Persistence
 public:
     MOCK_METHOD(bool, TableExists, (const std::string& tableName), (override));
     MOCK_METHOD(void, CreateTable, (const std::string& tableName, const column::Keys& cols), (override));
+    MOCK_METHOD(void, AddColumn, (const std::string& tableName, const column::ColumnKey& col), (override));
     MOCK_METHOD(void, Insert, (const std::string& tableName, const column::Row& cols), (override));
     MOCK_METHOD(void,
                 Update,
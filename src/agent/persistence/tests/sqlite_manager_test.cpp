@@ -76,6 +76,50 @@ TEST_F(SQLiteManagerTest, CreateTableTest)
     EXPECT_TRUE(m_db->TableExists("TableTest2"));
 }
 
+TEST_F(SQLiteManagerTest, UniqueColumnTest)
+{
+    const ColumnKey col1 {"Name", ColumnType::TEXT, NOT_NULL};
+    const ColumnKey col2 {"Key", ColumnType::TEXT, UNIQUE};
+    EXPECT_NO_THROW(m_db->CreateTable("UniqueTable", {col1, col2}));
+    EXPECT_NO_THROW(m_db->Remove("UniqueTable"));
+
+    EXPECT_NO_THROW(m_db->Insert(
+        "UniqueTable", {ColumnValue("Name", ColumnType::TEXT, "Item1"), ColumnValue("Key", ColumnType::TEXT, "K1")}));
+    EXPECT_ANY_THROW(m_db->Insert(
+        "UniqueTable", {ColumnValue("Name", ColumnType::TEXT, "Item2"), ColumnValue("Key", ColumnType::TEXT, "K1")}));
+
+    // Rows without a key don't collide
+    EXPECT_NO_THROW(m_db->Insert("UniqueTable", {ColumnValue("Name", ColumnType::TEXT, "Item3")}));
+    EXPECT_NO_THROW(m_db->Insert("UniqueTable", {ColumnValue("Name", ColumnType::TEXT, "Item4")}));
+    EXPECT_EQ(m_db->GetCount("UniqueTable"), 3);
+}
+
+TEST_F(SQLiteManagerTest, AddColumnTest)
+{
+    if (m_db->TableExists("AlterTable"))
+    {
+        EXPECT_NO_THROW(m_db->DropTable("AlterTable"));
+    }
+
+    EXPECT_NO_THROW(m_db->CreateTable("AlterTable", {ColumnKey("Name", ColumnType::TEXT, NOT_NULL)}));
+    EXPECT_NO_THROW(m_db->Insert("AlterTable", {ColumnValue("Name", ColumnType::TEXT, "Item1")}));
+
+    const ColumnKey key {"Key", ColumnType::TEXT, UNIQUE};
+    EXPECT_NO_THROW(m_db->AddColumn("AlterTable", key));
+    // Adding it again does nothing
+    EXPECT_NO_THROW(m_db->AddColumn("AlterTable", key));
+
+    EXPECT_NO_THROW(m_db->Insert(
+        "AlterTable", {ColumnValue("Name", ColumnType::TEXT, "Item2"), ColumnValue("Key", ColumnType::TEXT, "K1")}));
+    EXPECT_ANY_THROW(m_db->Insert(
+        "AlterTable", {ColumnValue("Name", ColumnType::TEXT, "Item3"), ColumnValue("Key", ColumnType::TEXT, "K1")}));
+
+    const auto rows = m_db->Select(
+        "AlterTable", {ColumnName("Key", ColumnType::TEXT)}, {ColumnValue("Name", ColumnType::TEXT, "Item2")});
+    ASSERT_EQ(rows.size(), 1);
+    EXPECT_EQ(rows[0][0].Value, "K1");
+}
+
 TEST_F(SQLiteManagerTest, InsertTest)
 {
     const ColumnValue col1 {"Name", ColumnType::TEXT, "ItemName1"};
@@ -340,6 +384,39 @@ TEST_F(SQLiteManagerTest, UpdateTest)
     ret = m_db->Select(m_tableName, {}, {});
 }
 
+TEST_F(SQLiteManagerTest, NullValueTest)
+{
+    AddTestData();
+
+    // The first rows were inserted without a module
+    auto ret = m_db->Select(m_tableName, {}, {ColumnValue("Module", ColumnType::TEXT, nullptr)});
+    EXPECT_EQ(ret.size(), 3);
+
+    EXPECT_NO_THROW(m_db->Update(m_tableName,
+                                 {ColumnValue("Module", ColumnType::TEXT, nullptr)},
+                                 {ColumnValue("Name", ColumnType::TEXT, "ItemName3")}));
+
+    ret = m_db->Select(m_tableName, {}, {ColumnValue("Module", ColumnType::TEXT, nullptr)});
+    EXPECT_EQ(ret.size(), 4);
+
+    ret = m_db->Select(m_tableName,
+                       {ColumnName("Module", ColumnType::TEXT)},
+                       {ColumnValue("Name", ColumnType::TEXT, "ItemName3")});
+    ASSERT_EQ(ret.size(), 1);
+    EXPECT_TRUE(ret[0][0].IsNull);
+
+    EXPECT_NO_THROW(m_db->Insert(m_tableName,
+                                 {ColumnValue("Name", ColumnType::TEXT, "ItemName6"),
+                                  ColumnValue("Status", ColumnType::TEXT, "ItemStatus6"),
+                                  ColumnValue("Orden", ColumnType::INTEGER, nullptr)}));
+
+    ret = m_db->Select(m_tableName,
+                       {ColumnName("Orden", ColumnType::INTEGER)},
+                       {ColumnValue("Name", ColumnType::TEXT, "ItemName6")});
+    ASSERT_EQ(ret.size(), 1);
+    EXPECT_TRUE(ret[0][0].IsNull);
+}
+
 TEST_F(SQLiteManagerTest, TransactionTest)
 {
     {
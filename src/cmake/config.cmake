@@ -28,14 +28,24 @@ set(DEFAULT_VERIFICATION_MODE "none" CACHE STRING "Default Agent verification mo
 
 set(DEFAULT_LOGCOLLECTOR_ENABLED true CACHE BOOL "Default Logcollector enabled")
 
+set(DEFAULT_LOGCOLLECTOR_THREAD_COUNT 1 CACHE STRING "Default number of Logcollector threads (1)")
+
 set(BUFFER_SIZE 4096 CACHE STRING "Default Logcollector reading buffer size")
 
 set(DEFAULT_FILE_WAIT "\"500ms\"" CACHE STRING "Default Logcollector file reading interval (500ms)")
 
 set(DEFAULT_RELOAD_INTERVAL "\"60000ms\"" CACHE STRING "Default Logcollector reload interval (1m)")
 
+set(DEFAULT_FILE_NOTIFICATIONS true CACHE BOOL "Default Logcollector use of file change notifications")
+
 set(DEFAULT_CHANNEL_REFRESH_INTERVAL "\"5000ms\"" CACHE STRING "Default Logcollector Windows eventchannel reconnect time (5000ms)")
 
+set(DEFAULT_JOURNALD_MAX_CATCHUP "\"3600000ms\"" CACHE STRING "Default Logcollector journald maximum catch-up window (1h)")
+
+set(DEFAULT_SYSLOG_ADDRESS "\"0.0.0.0\"" CACHE STRING "Default Logcollector syslog listening address")
+
+set(DEFAULT_SYSLOG_PORT 514 CACHE STRING "Default Logcollector syslog listening port (514)")
+
 set(DEFAULT_INVENTORY_ENABLED true CACHE BOOL "Default inventory enabled")
 
 set(DEFAULT_INTERVAL "\"3600000ms\"" CACHE STRING "Default inventory interval (1h)")
@@ -58,6 +68,12 @@ set(DEFAULT_PROCESSES false CACHE BOOL "Default inventory processes")
 
 set(DEFAULT_HOTFIXES true CACHE BOOL "Default inventory hotfixes")
 
+set(DEFAULT_INVENTORY_THREAD_COUNT 4 CACHE STRING "Default number of inventory collector threads (4)")
+
+set(DEFAULT_PROCESS_EVENTS false CACHE BOOL "Default inventory process events")
+
+set(DEFAULT_NETWORK_EVENTS false CACHE BOOL "Default inventory network events")
+
 set(QUEUE_STATUS_REFRESH_TIMER 100 CACHE STRING "Default Agent's queue refresh timer (100ms)")
 
 set(QUEUE_DEFAULT_SIZE "\"10000B\"" CACHE STRING "Default Agent's queue size (10000)")
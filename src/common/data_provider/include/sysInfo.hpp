@@ -12,6 +12,7 @@
 #ifndef _SYS_INFO_HPP
 #define _SYS_INFO_HPP
 
+#include <cstdint>
 #include "sysInfoInterface.hpp"
 
 constexpr auto KByte
@@ -19,10 +20,46 @@ constexpr auto KByte
     1024
 };
 
+/**
+ * @brief Groups of process fields, used to only collect the ones a consumer stores.
+ * pid and tgid are always filled. Only supported on Linux, other systems fill every field.
+ */
+enum ProcessFields : uint32_t
+{
+    // name, state, ppid, pgrp, session, tty, utime, stime, priority, nice, nlwp, start_time and processor
+    PROCESS_FIELDS_STAT    = 1 << 0,
+    // cmd and argvs
+    PROCESS_FIELDS_CMDLINE = 1 << 1,
+    // euser, ruser and suser
+    PROCESS_FIELDS_USERS   = 1 << 2,
+    // egroup, rgroup, sgroup and fgroup
+    PROCESS_FIELDS_GROUPS  = 1 << 3,
+    // size, vm_size, resident and share
+    PROCESS_FIELDS_MEMORY  = 1 << 4,
+    PROCESS_FIELDS_ALL     = PROCESS_FIELDS_STAT | PROCESS_FIELDS_CMDLINE | PROCESS_FIELDS_USERS |
+                             PROCESS_FIELDS_GROUPS | PROCESS_FIELDS_MEMORY
+};
+
+/**
+ * @brief Sockets reported by ports(). Only honoured on Linux, other systems report every socket.
+ */
+enum PortsScope
+{
+    // Every TCP and UDP socket
+    PORTS_SCOPE_ALL,
+    // TCP sockets in the listening state and every UDP socket
+    PORTS_SCOPE_LISTENING
+};
+
 class SysInfo: public ISysInfo
 {
     public:
         SysInfo() = default;
+        explicit SysInfo(uint32_t processFields, PortsScope portsScope = PORTS_SCOPE_ALL)
+            : m_processFields { processFields }
+            , m_portsScope { portsScope }
+        {
+        }
         // LCOV_EXCL_START
         virtual ~SysInfo() = default;
         // LCOV_EXCL_STOP
@@ -35,6 +72,20 @@ class SysInfo: public ISysInfo
         void packages(std::function<void(nlohmann::json&)>);
         void processes(std::function<void(nlohmann::json&)>);
         nlohmann::json hotfixes();
+        nlohmann::json packagesFingerprint();
+        /**
+         * @brief Reports process start and finish events as the kernel notifies them, until stopRequested
+         * returns true. Blocks the calling thread.
+         * @return false if the events source isn't available on this system
+         */
+        bool processEvents(std::function<void(ProcessEventType, nlohmann::json&)> callback,
+                           std::function<bool()> stopRequested);
+        /**
+         * @brief Calls callback whenever network interfaces, addresses or routes change, until stopRequested
+         * returns true. Blocks the calling thread.
+         * @return false if the events source isn't available on this system
+         */
+        bool networkEvents(std::function<void()> callback, std::function<bool()> stopRequested);
     private:
         virtual nlohmann::json getHardware() const;
         virtual nlohmann::json getPackages() const;
@@ -43,8 +94,15 @@ class SysInfo: public ISysInfo
         virtual nlohmann::json getNetworks() const;
         virtual nlohmann::json getPorts() const;
         virtual nlohmann::json getHotfixes() const;
+        virtual nlohmann::json getPackagesFingerprint() const;
         virtual void getPackages(std::function<void(nlohmann::json&)>) const;
         virtual void getProcessesInfo(std::function<void(nlohmann::json&)>) const;
+        virtual bool getProcessEvents(std::function<void(ProcessEventType, nlohmann::json&)>,
+                                      std::function<bool()>) const;
+        virtual bool getNetworkEvents(std::function<void()>, std::function<bool()>) const;
+
+        uint32_t m_processFields { PROCESS_FIELDS_ALL };
+        PortsScope m_portsScope { PORTS_SCOPE_ALL };
 };
 
 #endif //_SYS_INFO_HPP
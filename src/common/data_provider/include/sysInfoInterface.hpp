@@ -12,8 +12,20 @@
 #ifndef _SYS_INFO_INTERFACE
 #define _SYS_INFO_INTERFACE
 
+#include <functional>
 #include <nlohmann/json.hpp>
 
+/**
+ * @brief Kind of process event reported by ISysInfo::processEvents.
+ */
+enum ProcessEventType
+{
+    // A process was forked or replaced its image. The payload holds the process information.
+    PROCESS_STARTED,
+    // A process finished. The payload only holds its pid.
+    PROCESS_FINISHED
+};
+
 class ISysInfo
 {
     public:
@@ -30,6 +42,10 @@ class ISysInfo
         virtual nlohmann::json hotfixes() = 0;
         virtual void packages(std::function<void(nlohmann::json&)>) = 0;
         virtual void processes(std::function<void(nlohmann::json&)>) = 0;
+        virtual nlohmann::json packagesFingerprint() = 0;
+        virtual bool processEvents(std::function<void(ProcessEventType, nlohmann::json&)>,
+                                   std::function<bool()>) = 0;
+        virtual bool networkEvents(std::function<void()>, std::function<bool()>) = 0;
 
 };
 
@@ -17,6 +17,7 @@
 #include <sys/socket.h>
 #include "inetworkWrapper.h"
 #include "networkHelper.h"
+#include "networkNetlinkLinux.h"
 #include <file_io.hpp>
 #include "stringHelper.h"
 #include "sharedDefs.h"
@@ -192,6 +193,7 @@ namespace NetDevFileFields
 class NetworkLinuxInterface final : public INetworkInterfaceWrapper
 {
         ifaddrs* m_interfaceAddress;
+        const NetlinkLinkData* m_link;
         std::string m_gateway;
         std::string m_metrics;
 
@@ -253,8 +255,13 @@ class NetworkLinuxInterface final : public INetworkInterfaceWrapper
         }
 
     public:
-        explicit NetworkLinuxInterface(ifaddrs* addrs)
+        /**
+         * @param addrs Address of the interface
+         * @param link  Attributes of the interface read through rtnetlink, or nullptr to read them from sysfs
+         */
+        explicit NetworkLinuxInterface(ifaddrs* addrs, const NetlinkLinkData* link = nullptr)
             : m_interfaceAddress{ addrs }
+            , m_link{ link }
             , m_gateway{}
         {
             if (!addrs)
@@ -451,6 +458,12 @@ class NetworkLinuxInterface final : public INetworkInterfaceWrapper
 
         void mtu(nlohmann::json& network) const override
         {
+            if (m_link)
+            {
+                network["mtu"] = m_link->mtu;
+                return;
+            }
+
             network["mtu"] = UNKNOWN_VALUE;
             const auto fileIoWrapper = std::make_unique<file_io::FileIO>();
             const auto mtuFileContent { fileIoWrapper->getFileContent(std::string(WM_SYS_IFDATA_DIR) + this->name() + "/mtu") };
@@ -463,6 +476,11 @@ class NetworkLinuxInterface final : public INetworkInterfaceWrapper
 
         LinkStats stats() const override
         {
+            if (m_link)
+            {
+                return m_link->stats;
+            }
+
             LinkStats retVal {};
 
             try
@@ -511,6 +529,12 @@ class NetworkLinuxInterface final : public INetworkInterfaceWrapper
 
         void type(nlohmann::json& network) const override
         {
+            if (m_link)
+            {
+                network["type"] = Utils::NetworkHelper::getNetworkTypeStringCode(m_link->type, NETWORK_INTERFACE_TYPE);
+                return;
+            }
+
             network["type"] = EMPTY_VALUE;
             const auto fileIoWrapper = std::make_unique<file_io::FileIO>();
             const auto networkTypeCode { fileIoWrapper->getFileContent(std::string(WM_SYS_IFDATA_DIR) + this->name() + "/type") };
@@ -523,6 +547,12 @@ class NetworkLinuxInterface final : public INetworkInterfaceWrapper
 
         void state(nlohmann::json& network) const override
         {
+            if (m_link)
+            {
+                network["state"] = m_link->operState;
+                return;
+            }
+
             network["state"] = UNKNOWN_VALUE;
             const auto fileIoWrapper = std::make_unique<file_io::FileIO>();
             const std::string operationalState { fileIoWrapper->getFileContent(std::string(WM_SYS_IFDATA_DIR) + this->name() + "/operstate") };
@@ -535,6 +565,12 @@ class NetworkLinuxInterface final : public INetworkInterfaceWrapper
 
         void MAC(nlohmann::json& network) const override
         {
+            if (m_link)
+            {
+                network["mac"] = m_link->mac;
+                return;
+            }
+
             network["mac"] = UNKNOWN_VALUE;
             const auto fileIoWrapper = std::make_unique<file_io::FileIO>();
             const std::string macContent { fileIoWrapper->getFileContent(std::string(WM_SYS_IFDATA_DIR) + this->name() + "/address")};
@@ -0,0 +1,332 @@
+/*
+ * Wazuh SYSINFO
+ * Copyright (C) 2015, Wazuh Inc.
+ * October 18, 2026.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation.
+ */
+
+#include "networkNetlinkLinux.h"
+#include <linux/if.h>
+#include <linux/if_link.h>
+#include <linux/netlink.h>
+#include <linux/rtnetlink.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <array>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+#include "processes/procfsWalkerLinux.h"
+
+constexpr auto NETLINK_RECEIVE_BUFFER_SIZE
+{
+    32 * 1024
+};
+
+// A dump is answered right away, this only protects the scan from a kernel that never ends it.
+constexpr auto NETLINK_RECEIVE_TIMEOUT_S
+{
+    5
+};
+
+constexpr auto NETWORK_EVENTS_POLL_TIMEOUT_MS
+{
+    500
+};
+
+static const std::array<std::string, 7> OPERATIONAL_STATES
+{
+    // Indexed by IF_OPER_*
+    "unknown", "notpresent", "down", "lowerlayerdown", "testing", "dormant", "up"
+};
+
+struct LinkDumpRequest
+{
+    nlmsghdr header;
+    ifinfomsg info;
+};
+
+static std::string macAddress(const unsigned char* address, size_t length)
+{
+    std::string retVal;
+    std::array<char, sizeof("ff:")> byte {};
+
+    for (size_t i = 0; i < length; ++i)
+    {
+        std::snprintf(byte.data(), byte.size(), i == 0 ? "%02x" : ":%02x", address[i]);
+        retVal += byte.data();
+    }
+
+    return retVal;
+}
+
+bool NetlinkNetworkReader::links(std::map<std::string, NetlinkLinkData>& links)
+{
+    const FileDescriptorCloser socketFd { socket(AF_NETLINK, SOCK_RAW | SOCK_CLOEXEC, NETLINK_ROUTE) };
+
+    if (socketFd.m_fd < 0)
+    {
+        return false;
+    }
+
+    const timeval timeout { NETLINK_RECEIVE_TIMEOUT_S, 0 };
+    setsockopt(socketFd.m_fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+
+    LinkDumpRequest message {};
+    message.header.nlmsg_len = sizeof(message);
+    message.header.nlmsg_type = RTM_GETLINK;
+    message.header.nlmsg_flags = NLM_F_REQUEST | NLM_F_DUMP;
+    message.info.ifi_family = AF_UNSPEC;
+
+    sockaddr_nl kernel {};
+    kernel.nl_family = AF_NETLINK;
+
+    if (sendto(socketFd.m_fd, &message, sizeof(message), 0, reinterpret_cast<sockaddr*>(&kernel), sizeof(kernel)) < 0)
+    {
+        return false;
+    }
+
+    std::vector<char> buffer(NETLINK_RECEIVE_BUFFER_SIZE);
+    std::map<std::string, NetlinkLinkData> dumped;
+    auto status { NETLINK_DUMP_MORE };
+
+    while (status == NETLINK_DUMP_MORE)
+    {
+        const auto received { recv(socketFd.m_fd, buffer.data(), buffer.size(), 0) };
+
+        if (received < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+
+            return false;
+        }
+
+        if (received == 0)
+        {
+            return false;
+        }
+
+        status = handleLinkMessages(buffer.data(), static_cast<size_t>(received), dumped);
+    }
+
+    if (status == NETLINK_DUMP_ERROR)
+    {
+        return false;
+    }
+
+    links.swap(dumped);
+    return true;
+}
+
+NetlinkDumpStatus NetlinkNetworkReader::handleLinkMessages(const char* buffer,
+                                                           size_t size,
+                                                           std::map<std::string, NetlinkLinkData>& links)
+{
+    auto remaining { static_cast<int>(size) };
+
+    for (auto header { reinterpret_cast<const nlmsghdr*>(buffer) }; NLMSG_OK(header, remaining);
+            header = NLMSG_NEXT(header, remaining))
+    {
+        if (header->nlmsg_type == NLMSG_DONE)
+        {
+            return NETLINK_DUMP_DONE;
+        }
+
+        if (header->nlmsg_type == NLMSG_ERROR)
+        {
+            return NETLINK_DUMP_ERROR;
+        }
+
+        if (header->nlmsg_type != RTM_NEWLINK || header->nlmsg_len < NLMSG_LENGTH(sizeof(ifinfomsg)))
+        {
+            continue;
+        }
+
+        const auto info { reinterpret_cast<const ifinfomsg*>(NLMSG_DATA(header)) };
+        std::string name;
+        NetlinkLinkData link;
+        link.type = info->ifi_type;
+        link.operState = OPERATIONAL_STATES.front();
+        auto attributesSize { static_cast<int>(IFLA_PAYLOAD(header)) };
+
+        for (auto attribute { IFLA_RTA(info) }; RTA_OK(attribute, attributesSize);
+                attribute = RTA_NEXT(attribute, attributesSize))
+        {
+            const auto data { static_cast<const unsigned char*>(RTA_DATA(attribute)) };
+            const auto dataSize { RTA_PAYLOAD(attribute) };
+
+            switch (attribute->rta_type)
+            {
+                case IFLA_IFNAME:
+                    name.assign(reinterpret_cast<const char*>(data), strnlen(reinterpret_cast<const char*>(data), dataSize));
+                    break;
+
+                case IFLA_ADDRESS:
+                    link.mac = macAddress(data, dataSize);
+                    break;
+
+                case IFLA_MTU:
+
+                    if (dataSize >= sizeof(uint32_t))
+                    {
+                        uint32_t mtu { 0 };
+                        std::memcpy(&mtu, data, sizeof(mtu));
+                        link.mtu = mtu;
+                    }
+
+                    break;
+
+                case IFLA_OPERSTATE:
+
+                    if (dataSize >= sizeof(uint8_t) && data[0] < OPERATIONAL_STATES.size())
+                    {
+                        link.operState = OPERATIONAL_STATES.at(data[0]);
+                    }
+
+                    break;
+
+                case IFLA_STATS64:
+
+                    if (dataSize >= sizeof(rtnl_link_stats64))
+                    {
+                        // Attributes are only 4-byte aligned, the 64-bit counters are copied out.
+                        rtnl_link_stats64 stats {};
+                        std::memcpy(&stats, data, sizeof(stats));
+                        link.stats.rxPackets = static_cast<unsigned int>(stats.rx_packets);
+                        link.stats.txPackets = static_cast<unsigned int>(stats.tx_packets);
+                        link.stats.rxBytes = static_cast<int64_t>(stats.rx_bytes);
+                        link.stats.txBytes = static_cast<int64_t>(stats.tx_bytes);
+                        link.stats.rxErrors = static_cast<unsigned int>(stats.rx_errors);
+                        link.stats.txErrors = static_cast<unsigned int>(stats.tx_errors);
+                        // /proc/net/dev reports missed packets as dropped too.
+                        link.stats.rxDropped = static_cast<unsigned int>(stats.rx_dropped + stats.rx_missed_errors);
+                        link.stats.txDropped = static_cast<unsigned int>(stats.tx_dropped);
+                    }
+
+                    break;
+
+                default:
+                    break;
+            }
+        }
+
+        if (!name.empty())
+        {
+            links[name] = std::move(link);
+        }
+    }
+
+    return NETLINK_DUMP_MORE;
+}
+
+bool NetworkEventsListener::listen(const std::function<void()>& callback, const std::function<bool()>& stopRequested)
+{
+    const FileDescriptorCloser socketFd { socket(AF_NETLINK, SOCK_RAW | SOCK_CLOEXEC, NETLINK_ROUTE) };
+
+    if (socketFd.m_fd < 0)
+    {
+        return false;
+    }
+
+    sockaddr_nl address {};
+    address.nl_family = AF_NETLINK;
+    // Only IPv4 routes are watched, they are the only ones the gateway is read from.
+    address.nl_groups = RTMGRP_LINK | RTMGRP_IPV4_IFADDR | RTMGRP_IPV6_IFADDR | RTMGRP_IPV4_ROUTE;
+
+    if (bind(socketFd.m_fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0)
+    {
+        return false;
+    }
+
+    std::vector<char> buffer(NETLINK_RECEIVE_BUFFER_SIZE);
+    pollfd pollFd { socketFd.m_fd, POLLIN, 0 };
+
+    while (!stopRequested())
+    {
+        const auto ready { poll(&pollFd, 1, NETWORK_EVENTS_POLL_TIMEOUT_MS) };
+
+        if (ready <= 0)
+        {
+            if (ready < 0 && errno != EINTR)
+            {
+                break;
+            }
+
+            continue;
+        }
+
+        auto changed { false };
+
+        // Changes come in bursts, the whole burst is drained before reporting it once.
+        for (;;)
+        {
+            sockaddr_nl sender {};
+            socklen_t senderSize { sizeof(sender) };
+            const auto received
+            {
+                recvfrom(socketFd.m_fd, buffer.data(), buffer.size(), MSG_DONTWAIT, reinterpret_cast<sockaddr*>(&sender),
+                         &senderSize)
+            };
+
+            if (received < 0)
+            {
+                // ENOBUFS means notifications were dropped, something changed anyway.
+                changed = changed || errno == ENOBUFS;
+
+                if (errno == EINTR || errno == ENOBUFS)
+                {
+                    continue;
+                }
+
+                break;
+            }
+
+            // Only trust messages sent by the kernel.
+            if (sender.nl_pid == 0 && isChange(buffer.data(), static_cast<size_t>(received)))
+            {
+                changed = true;
+            }
+        }
+
+        if (changed)
+        {
+            callback();
+        }
+    }
+
+    return true;
+}
+
+bool NetworkEventsListener::isChange(const char* buffer, size_t size)
+{
+    auto remaining { static_cast<int>(size) };
+
+    for (auto header { reinterpret_cast<const nlmsghdr*>(buffer) }; NLMSG_OK(header, remaining);
+            header = NLMSG_NEXT(header, remaining))
+    {
+        switch (header->nlmsg_type)
+        {
+            case RTM_NEWLINK:
+            case RTM_DELLINK:
+            case RTM_NEWADDR:
+            case RTM_DELADDR:
+            case RTM_NEWROUTE:
+            case RTM_DELROUTE:
+                return true;
+
+            default:
+                break;
+        }
+    }
+
+    return false;
+}
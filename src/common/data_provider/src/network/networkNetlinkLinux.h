@@ -0,0 +1,89 @@
+/*
+ * Wazuh SYSINFO
+ * Copyright (C) 2015, Wazuh Inc.
+ * October 18, 2026.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation.
+ */
+
+#ifndef _NETWORK_NETLINK_LINUX_H
+#define _NETWORK_NETLINK_LINUX_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <string>
+#include "inetworkInterface.h"
+#include "sharedDefs.h"
+
+/**
+ * @brief Attributes of a network interface, as reported by an RTM_GETLINK dump.
+ */
+struct NetlinkLinkData
+{
+    // ARPHRD_* hardware type
+    int type { 0 };
+    // Operational state, named like /sys/class/net/<iface>/operstate
+    std::string operState;
+    // Hardware address, empty if the interface has none
+    std::string mac;
+    int64_t mtu { 0 };
+    LinkStats stats {};
+};
+
+/**
+ * @brief Reads the network interfaces through rtnetlink (NETLINK_ROUTE).
+ *
+ * One RTM_GETLINK dump returns the type, state, hardware address, MTU and 64-bit counters of every interface,
+ * which otherwise take five sysfs and procfs reads per interface.
+ */
+class NetlinkNetworkReader final
+{
+    public:
+        /**
+         * @brief Dumps the attributes of every network interface.
+         * @param links Map from interface name to its attributes
+         * @return false if rtnetlink isn't available, links is left untouched in that case
+         */
+        static bool links(std::map<std::string, NetlinkLinkData>& links);
+
+        /**
+         * @brief Reads the interfaces held by a datagram of an RTM_GETLINK dump.
+         * @param buffer Netlink messages as received
+         * @param size   Amount of bytes received
+         * @param links  Map from interface name to its attributes
+         * @return Whether the dump continues, finished or was refused by the kernel
+         */
+        static NetlinkDumpStatus handleLinkMessages(const char* buffer,
+                                                    size_t size,
+                                                    std::map<std::string, NetlinkLinkData>& links);
+};
+
+/**
+ * @brief Listens to the rtnetlink multicast groups of links, addresses and IPv4 routes.
+ */
+class NetworkEventsListener final
+{
+    public:
+        /**
+         * @brief Subscribes to rtnetlink and calls callback after every batch of changes, until stopRequested
+         * returns true.
+         * @param callback      Callback to be called when interfaces, addresses or routes changed
+         * @param stopRequested Predicate checked at least every poll timeout
+         * @return false if the subscription failed
+         */
+        bool listen(const std::function<void()>& callback, const std::function<bool()>& stopRequested);
+
+        /**
+         * @brief Tells whether a datagram received from rtnetlink holds any interface, address or route change.
+         * @param buffer Netlink messages as received
+         * @param size   Amount of bytes received
+         */
+        static bool isChange(const char* buffer, size_t size);
+};
+
+#endif // _NETWORK_NETLINK_LINUX_H
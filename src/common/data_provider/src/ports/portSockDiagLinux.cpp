@@ -0,0 +1,190 @@
+/*
+ * Wazuh SYSINFO
+ * Copyright (C) 2015, Wazuh Inc.
+ * October 18, 2026.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation.
+ */
+
+#include "portSockDiagLinux.h"
+#include <arpa/inet.h>
+#include <linux/inet_diag.h>
+#include <linux/netlink.h>
+#include <linux/sock_diag.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <cerrno>
+#include <vector>
+#include "networkHelper.h"
+#include "stringHelper.h"
+#include "portLinuxWrapper.h"
+#include "processes/procfsWalkerLinux.h"
+
+// Big enough for a few hundred sockets per datagram, the kernel fills it up to this size.
+constexpr auto SOCK_DIAG_RECEIVE_BUFFER_SIZE
+{
+    64 * 1024
+};
+
+// A dump is answered right away, this only protects the scan from a kernel that never ends it.
+constexpr auto SOCK_DIAG_RECEIVE_TIMEOUT_S
+{
+    5
+};
+
+constexpr uint32_t SOCK_DIAG_ALL_STATES
+{
+    0xFFFFFFFF
+};
+
+struct SockDiagRequest
+{
+    nlmsghdr header;
+    inet_diag_req_v2 request;
+};
+
+SockDiagPortReader::SockDiagPortReader(bool listeningOnly)
+    : m_listeningOnly { listeningOnly }
+{
+}
+
+bool SockDiagPortReader::read(PortType type, nlohmann::json& ports) const
+{
+    const auto ipv6 { IPVERSION_TYPE.at(type) == IPV6 };
+    const auto tcp { PROTOCOL_TYPE.at(type) == TCP };
+
+    const FileDescriptorCloser socketFd { socket(AF_NETLINK, SOCK_DGRAM | SOCK_CLOEXEC, NETLINK_SOCK_DIAG) };
+
+    if (socketFd.m_fd < 0)
+    {
+        return false;
+    }
+
+    const timeval timeout { SOCK_DIAG_RECEIVE_TIMEOUT_S, 0 };
+    setsockopt(socketFd.m_fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+
+    SockDiagRequest message {};
+    message.header.nlmsg_len = sizeof(message);
+    message.header.nlmsg_type = SOCK_DIAG_BY_FAMILY;
+    message.header.nlmsg_flags = NLM_F_REQUEST | NLM_F_DUMP;
+    message.request.sdiag_family = ipv6 ? AF_INET6 : AF_INET;
+    message.request.sdiag_protocol = tcp ? IPPROTO_TCP : IPPROTO_UDP;
+    // The kernel skips the sockets in any other state, which is most of them on a busy host.
+    message.request.idiag_states = tcp && m_listeningOnly ? (1U << TCP_LISTEN) : SOCK_DIAG_ALL_STATES;
+
+    sockaddr_nl kernel {};
+    kernel.nl_family = AF_NETLINK;
+
+    if (sendto(socketFd.m_fd, &message, sizeof(message), 0, reinterpret_cast<sockaddr*>(&kernel), sizeof(kernel)) < 0)
+    {
+        return false;
+    }
+
+    std::vector<char> buffer(SOCK_DIAG_RECEIVE_BUFFER_SIZE);
+    // Sockets are only handed over once the whole dump succeeded, so a failure can fall back to procfs cleanly.
+    auto dumped = nlohmann::json::array();
+    auto status { NETLINK_DUMP_MORE };
+
+    while (status == NETLINK_DUMP_MORE)
+    {
+        const auto received { recv(socketFd.m_fd, buffer.data(), buffer.size(), 0) };
+
+        if (received < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+
+            return false;
+        }
+
+        if (received == 0)
+        {
+            return false;
+        }
+
+        status = handleMessages(type, buffer.data(), static_cast<size_t>(received), dumped);
+    }
+
+    if (status == NETLINK_DUMP_ERROR)
+    {
+        return false;
+    }
+
+    for (auto& port : dumped)
+    {
+        ports.push_back(std::move(port));
+    }
+
+    return true;
+}
+
+NetlinkDumpStatus SockDiagPortReader::handleMessages(PortType type,
+                                                     const char* buffer,
+                                                     size_t size,
+                                                     nlohmann::json& ports)
+{
+    const auto ipv6 { IPVERSION_TYPE.at(type) == IPV6 };
+    const auto tcp { PROTOCOL_TYPE.at(type) == TCP };
+    const auto family { ipv6 ? AF_INET6 : AF_INET };
+    auto remaining { static_cast<int>(size) };
+
+    for (auto header { reinterpret_cast<const nlmsghdr*>(buffer) }; NLMSG_OK(header, remaining);
+            header = NLMSG_NEXT(header, remaining))
+    {
+        if (header->nlmsg_type == NLMSG_DONE)
+        {
+            return NETLINK_DUMP_DONE;
+        }
+
+        if (header->nlmsg_type == NLMSG_ERROR)
+        {
+            return NETLINK_DUMP_ERROR;
+        }
+
+        if (header->nlmsg_type != SOCK_DIAG_BY_FAMILY || header->nlmsg_len < NLMSG_LENGTH(sizeof(inet_diag_msg)))
+        {
+            continue;
+        }
+
+        const auto socketInfo { reinterpret_cast<const inet_diag_msg*>(NLMSG_DATA(header)) };
+
+        if (socketInfo->idiag_family != family)
+        {
+            continue;
+        }
+
+        nlohmann::json port;
+        port["protocol"] = PORTS_TYPE.at(type);
+        port["local_ip"] = Utils::NetworkHelper::IAddressToBinary(family, socketInfo->id.idiag_src);
+        port["local_port"] = ntohs(socketInfo->id.idiag_sport);
+        port["remote_ip"] = Utils::NetworkHelper::IAddressToBinary(family, socketInfo->id.idiag_dst);
+        port["remote_port"] = ntohs(socketInfo->id.idiag_dport);
+        // For listening sockets sock_diag reports the backlog limit as the write queue, procfs reports 0.
+        port["tx_queue"] = tcp && socketInfo->idiag_state == TCP_LISTEN ? 0 : socketInfo->idiag_wqueue;
+        port["rx_queue"] = socketInfo->idiag_rqueue;
+        port["inode"] = static_cast<int64_t>(socketInfo->idiag_inode);
+        port["state"] = UNKNOWN_VALUE;
+
+        if (tcp)
+        {
+            const auto itState { STATE_TYPE.find(socketInfo->idiag_state) };
+
+            if (STATE_TYPE.end() != itState)
+            {
+                port["state"] = itState->second;
+            }
+        }
+
+        port["pid"] = UNKNOWN_VALUE;
+        port["process"] = UNKNOWN_VALUE;
+        ports.push_back(std::move(port));
+    }
+
+    return NETLINK_DUMP_MORE;
+}
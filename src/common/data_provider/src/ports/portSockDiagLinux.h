@@ -0,0 +1,56 @@
+/*
+ * Wazuh SYSINFO
+ * Copyright (C) 2015, Wazuh Inc.
+ * October 18, 2026.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation.
+ */
+
+#ifndef _PORT_SOCK_DIAG_LINUX_H
+#define _PORT_SOCK_DIAG_LINUX_H
+
+#include <cstddef>
+#include <nlohmann/json.hpp>
+#include "sharedDefs.h"
+
+/**
+ * @brief Reads the sockets of one port type through NETLINK_SOCK_DIAG.
+ *
+ * The kernel answers with binary inet_diag_msg records, so there is no text to parse, and TCP sockets can be
+ * filtered by state before they are copied to user space. The reported fields match the /proc/net parser.
+ */
+class SockDiagPortReader final
+{
+    public:
+        /**
+         * @brief Constructor
+         * @param listeningOnly Only report TCP sockets in the listening state. UDP sockets are always reported.
+         */
+        explicit SockDiagPortReader(bool listeningOnly = false);
+
+        /**
+         * @brief Appends every socket of the given type to ports.
+         * @param type  Port type to dump
+         * @param ports JSON array the sockets are appended to
+         * @return false if the kernel doesn't support sock_diag for this type, nothing is appended in that case
+         */
+        bool read(PortType type, nlohmann::json& ports) const;
+
+        /**
+         * @brief Appends the sockets held by a datagram of a sock_diag dump to ports.
+         * @param type   Port type of the dump
+         * @param buffer Netlink messages as received
+         * @param size   Amount of bytes received
+         * @param ports  JSON array the sockets are appended to
+         * @return Whether the dump continues, finished or was refused by the kernel
+         */
+        static NetlinkDumpStatus handleMessages(PortType type, const char* buffer, size_t size, nlohmann::json& ports);
+
+    private:
+        bool m_listeningOnly;
+};
+
+#endif // _PORT_SOCK_DIAG_LINUX_H
@@ -0,0 +1,199 @@
+/*
+ * Wazuh SYSINFO
+ * Copyright (C) 2015, Wazuh Inc.
+ * October 18, 2026.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation.
+ */
+
+#include "processEventsLinux.h"
+#include <linux/cn_proc.h>
+#include <linux/connector.h>
+#include <linux/netlink.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <array>
+#include <cerrno>
+#include <cstring>
+#include <string>
+#include <utility>
+#include <vector>
+
+constexpr auto PROCESS_EVENTS_POLL_TIMEOUT_MS
+{
+    500
+};
+
+// Bursts of forks are common, a bigger buffer avoids dropping them. The kernel caps it to net.core.rmem_max.
+constexpr auto PROCESS_EVENTS_SOCKET_BUFFER_SIZE
+{
+    1024 * 1024
+};
+
+constexpr auto PROCESS_EVENTS_RECEIVE_BUFFER_SIZE
+{
+    8192
+};
+
+static bool setMulticastOperation(int socketFd, proc_cn_mcast_op operation)
+{
+    alignas(nlmsghdr) std::array<char, NLMSG_SPACE(sizeof(cn_msg) + sizeof(proc_cn_mcast_op))> request {};
+
+    auto header { reinterpret_cast<nlmsghdr*>(request.data()) };
+    header->nlmsg_len = NLMSG_LENGTH(sizeof(cn_msg) + sizeof(proc_cn_mcast_op));
+    header->nlmsg_type = NLMSG_DONE;
+    header->nlmsg_pid = static_cast<__u32>(getpid());
+
+    auto message { reinterpret_cast<cn_msg*>(NLMSG_DATA(header)) };
+    message->id.idx = CN_IDX_PROC;
+    message->id.val = CN_VAL_PROC;
+    message->len = sizeof(proc_cn_mcast_op);
+    std::memcpy(message->data, &operation, sizeof(operation));
+
+    return send(socketFd, header, header->nlmsg_len, 0) >= 0;
+}
+
+ProcessEventsListener::ProcessEventsListener(std::string procPath, uint32_t fields)
+    : m_walker { std::move(procPath), fields }
+{
+}
+
+bool ProcessEventsListener::listen(const std::function<void(ProcessEventType, nlohmann::json&)>& callback,
+                                   const std::function<bool()>& stopRequested)
+{
+    const FileDescriptorCloser socketFd { socket(PF_NETLINK, SOCK_DGRAM | SOCK_CLOEXEC, NETLINK_CONNECTOR) };
+
+    if (socketFd.m_fd < 0)
+    {
+        return false;
+    }
+
+    sockaddr_nl address {};
+    address.nl_family = AF_NETLINK;
+    address.nl_groups = CN_IDX_PROC;
+
+    if (bind(socketFd.m_fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0 ||
+            !setMulticastOperation(socketFd.m_fd, PROC_CN_MCAST_LISTEN))
+    {
+        return false;
+    }
+
+    const int socketBufferSize { PROCESS_EVENTS_SOCKET_BUFFER_SIZE };
+    setsockopt(socketFd.m_fd, SOL_SOCKET, SO_RCVBUF, &socketBufferSize, sizeof(socketBufferSize));
+
+    std::vector<char> buffer(PROCESS_EVENTS_RECEIVE_BUFFER_SIZE);
+    pollfd pollFd { socketFd.m_fd, POLLIN, 0 };
+
+    while (!stopRequested())
+    {
+        const auto ready { poll(&pollFd, 1, PROCESS_EVENTS_POLL_TIMEOUT_MS) };
+
+        if (ready <= 0)
+        {
+            if (ready < 0 && errno != EINTR)
+            {
+                break;
+            }
+
+            continue;
+        }
+
+        sockaddr_nl sender {};
+        socklen_t senderSize { sizeof(sender) };
+        const auto received
+        {
+            recvfrom(socketFd.m_fd, buffer.data(), buffer.size(), 0, reinterpret_cast<sockaddr*>(&sender), &senderSize)
+        };
+
+        if (received < 0)
+        {
+            // ENOBUFS means events were dropped, the next full scan reconciles them.
+            if (errno == EINTR || errno == ENOBUFS || errno == EAGAIN)
+            {
+                continue;
+            }
+
+            break;
+        }
+
+        // Only trust messages sent by the kernel.
+        if (sender.nl_pid == 0)
+        {
+            handleMessages(buffer.data(), static_cast<size_t>(received), callback);
+        }
+    }
+
+    setMulticastOperation(socketFd.m_fd, PROC_CN_MCAST_IGNORE);
+    return true;
+}
+
+void ProcessEventsListener::handleMessages(char* buffer,
+                                           size_t size,
+                                           const std::function<void(ProcessEventType, nlohmann::json&)>& callback)
+{
+    auto remaining { static_cast<int>(size) };
+
+    for (auto header { reinterpret_cast<nlmsghdr*>(buffer) }; NLMSG_OK(header, remaining);
+            header = NLMSG_NEXT(header, remaining))
+    {
+        if (header->nlmsg_type == NLMSG_NOOP || header->nlmsg_type == NLMSG_ERROR ||
+                header->nlmsg_len < NLMSG_LENGTH(sizeof(cn_msg) + sizeof(proc_event)))
+        {
+            continue;
+        }
+
+        const auto message { reinterpret_cast<const cn_msg*>(NLMSG_DATA(header)) };
+
+        if (message->id.idx != CN_IDX_PROC || message->id.val != CN_VAL_PROC)
+        {
+            continue;
+        }
+
+        const auto event { reinterpret_cast<const proc_event*>(message->data) };
+        nlohmann::json processInfo;
+        __kernel_pid_t startedPid { 0 };
+
+        switch (event->what)
+        {
+            case proc_event::PROC_EVENT_FORK:
+
+                if (event->event_data.fork.child_pid == event->event_data.fork.child_tgid)
+                {
+                    startedPid = event->event_data.fork.child_tgid;
+                }
+
+                break;
+
+            case proc_event::PROC_EVENT_EXEC:
+
+                if (event->event_data.exec.process_pid == event->event_data.exec.process_tgid)
+                {
+                    startedPid = event->event_data.exec.process_tgid;
+                }
+
+                break;
+
+            case proc_event::PROC_EVENT_EXIT:
+
+                if (event->event_data.exit.process_pid == event->event_data.exit.process_tgid)
+                {
+                    processInfo["pid"] = std::to_string(event->event_data.exit.process_tgid);
+                    callback(PROCESS_FINISHED, processInfo);
+                }
+
+                break;
+
+            default:
+                break;
+        }
+
+        // A process that already finished is reported by its own exit event.
+        if (startedPid > 0 && m_walker.readProcess(std::to_string(startedPid), processInfo))
+        {
+            callback(PROCESS_STARTED, processInfo);
+        }
+    }
+}
@@ -0,0 +1,63 @@
+/*
+ * Wazuh SYSINFO
+ * Copyright (C) 2015, Wazuh Inc.
+ * October 18, 2026.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation.
+ */
+
+#ifndef _PROCESS_EVENTS_LINUX_H
+#define _PROCESS_EVENTS_LINUX_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <nlohmann/json.hpp>
+#include "procfsWalkerLinux.h"
+#include "sysInfoInterface.hpp"
+
+/**
+ * @brief Listens to the kernel process connector (NETLINK_CONNECTOR, CN_IDX_PROC).
+ *
+ * Fork and exec notifications of whole processes are reported as started, with the process information read from
+ * procfs. Exit notifications are reported as finished. Thread creation and exit are ignored.
+ */
+class ProcessEventsListener final
+{
+    public:
+        /**
+         * @brief Constructor
+         * @param procPath Path where procfs is mounted
+         * @param fields   Mask of ProcessFields to fill for every started process
+         */
+        explicit ProcessEventsListener(std::string procPath = WM_SYS_PROC_DIR,
+                                       uint32_t fields = PROCESS_FIELDS_ALL);
+
+        /**
+         * @brief Subscribes to the process connector and reports its events until stopRequested returns true.
+         * @param callback      Callback to be called for every process event
+         * @param stopRequested Predicate checked at least every poll timeout
+         * @return false if the subscription failed, usually because of missing privileges or kernel support
+         */
+        bool listen(const std::function<void(ProcessEventType, nlohmann::json&)>& callback,
+                    const std::function<bool()>& stopRequested);
+
+        /**
+         * @brief Reports the process events held by a datagram received from the process connector
+         * @param buffer   Netlink messages as received
+         * @param size     Amount of bytes received
+         * @param callback Callback to be called for every process event
+         */
+        void handleMessages(char* buffer,
+                            size_t size,
+                            const std::function<void(ProcessEventType, nlohmann::json&)>& callback);
+
+    private:
+        ProcfsWalker m_walker;
+};
+
+#endif // _PROCESS_EVENTS_LINUX_H
@@ -0,0 +1,428 @@
+/*
+ * Wazuh SYSINFO
+ * Copyright (C) 2015, Wazuh Inc.
+ * October 18, 2026.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation.
+ */
+
+#include "procfsWalkerLinux.h"
+#include <dirent.h>
+#include <fcntl.h>
+#include <grp.h>
+#include <pwd.h>
+#include <array>
+#include <charconv>
+#include <memory>
+#include <vector>
+#include "linuxInfoHelper.h"
+
+constexpr size_t PROC_READ_CHUNK { 4096 };
+
+// Fields of /proc/<pid>/stat after the process name, numbered as in proc(5)
+enum StatField
+{
+    STAT_STATE = 3,
+    STAT_PPID = 4,
+    STAT_PGRP = 5,
+    STAT_SESSION = 6,
+    STAT_TTY = 7,
+    STAT_UTIME = 14,
+    STAT_STIME = 15,
+    STAT_PRIORITY = 18,
+    STAT_NICE = 19,
+    STAT_NUM_THREADS = 20,
+    STAT_START_TIME = 22,
+    STAT_PROCESSOR = 39,
+    STAT_FIELDS_SIZE
+};
+
+struct DirCloser
+{
+    void operator()(DIR* dir)
+    {
+        closedir(dir);
+    }
+};
+
+template<typename T>
+static T toNumber(std::string_view value)
+{
+    T number {};
+    std::from_chars(value.data(), value.data() + value.size(), number);
+    return number;
+}
+
+static bool isPid(const char* name)
+{
+    if (!*name)
+    {
+        return false;
+    }
+
+    for (; *name; ++name)
+    {
+        if (*name < '0' || *name > '9')
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+// Splits the values of a "Key:\tv1\tv2..." line of /proc/<pid>/status
+static std::vector<std::string_view> statusValues(std::string_view line)
+{
+    std::vector<std::string_view> values;
+    size_t pos { line.find(':') + 1 };
+
+    while (pos < line.size())
+    {
+        const auto start { line.find_first_not_of(" \t", pos) };
+
+        if (start == std::string_view::npos)
+        {
+            break;
+        }
+
+        const auto end { std::min(line.find_first_of(" \t", start), line.size()) };
+        values.push_back(line.substr(start, end - start));
+        pos = end;
+    }
+
+    return values;
+}
+
+ProcfsWalker::ProcfsWalker(std::string procPath, uint32_t fields)
+    : m_procPath { std::move(procPath) }
+    , m_fields { fields }
+    , m_buffer(PROC_READ_CHUNK)
+    , m_size { 0 }
+{
+}
+
+void ProcfsWalker::walk(const std::function<void(nlohmann::json&)>& callback)
+{
+    const std::unique_ptr<DIR, DirCloser> procDir { opendir(m_procPath.c_str()) };
+
+    if (!procDir)
+    {
+        return;
+    }
+
+    const int procFd { dirfd(procDir.get()) };
+
+    while (const auto entry { readdir(procDir.get()) })
+    {
+        nlohmann::json processInfo;
+
+        // The process can finish at any point, in that case it is skipped
+        if (isPid(entry->d_name) && readProcess(procFd, entry->d_name, processInfo))
+        {
+            callback(processInfo);
+        }
+    }
+}
+
+bool ProcfsWalker::readProcess(const std::string& pid, nlohmann::json& info)
+{
+    const FileDescriptorCloser procDir { open(m_procPath.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC) };
+
+    return procDir.m_fd >= 0 && isPid(pid.c_str()) && readProcess(procDir.m_fd, pid.c_str(), info);
+}
+
+bool ProcfsWalker::readProcess(int procFd, const char* pid, nlohmann::json& info)
+{
+    const FileDescriptorCloser pidDir { openat(procFd, pid, O_RDONLY | O_DIRECTORY | O_CLOEXEC) };
+
+    if (pidDir.m_fd < 0 || !readFile(pidDir.m_fd, "stat"))
+    {
+        return false;
+    }
+
+    info["pid"] = pid;
+    info["tgid"] = toNumber<int>(pid);
+
+    if (!fillStat(info))
+    {
+        return false;
+    }
+
+    if ((m_fields & (PROCESS_FIELDS_USERS | PROCESS_FIELDS_GROUPS | PROCESS_FIELDS_MEMORY)) &&
+            readFile(pidDir.m_fd, "status"))
+    {
+        fillStatus(info);
+    }
+
+    if ((m_fields & PROCESS_FIELDS_MEMORY) && readFile(pidDir.m_fd, "statm"))
+    {
+        fillStatm(info);
+    }
+
+    if (m_fields & PROCESS_FIELDS_CMDLINE)
+    {
+        if (!readFile(pidDir.m_fd, "cmdline"))
+        {
+            m_size = 0;
+        }
+
+        fillCmdline(info);
+    }
+
+    return true;
+}
+
+bool ProcfsWalker::readFile(int dirFd, const char* fileName)
+{
+    const FileDescriptorCloser file { openat(dirFd, fileName, O_RDONLY | O_CLOEXEC) };
+
+    if (file.m_fd < 0)
+    {
+        return false;
+    }
+
+    m_size = 0;
+
+    while (true)
+    {
+        // The buffer only grows, so after the first processes every read fits without reallocating
+        if (m_buffer.size() - m_size < PROC_READ_CHUNK)
+        {
+            m_buffer.resize(m_buffer.size() * 2);
+        }
+
+        const auto bytes { read(file.m_fd, m_buffer.data() + m_size, m_buffer.size() - m_size) };
+
+        if (bytes < 0)
+        {
+            return false;
+        }
+
+        if (bytes == 0)
+        {
+            break;
+        }
+
+        m_size += static_cast<size_t>(bytes);
+    }
+
+    return true;
+}
+
+std::string_view ProcfsWalker::content() const
+{
+    return std::string_view { m_buffer.data(), m_size };
+}
+
+bool ProcfsWalker::fillStat(nlohmann::json& info)
+{
+    // The name is enclosed in parentheses and can contain spaces and parentheses itself
+    const auto stat { content() };
+    const auto nameStart { stat.find('(') };
+    const auto nameEnd { stat.rfind(')') };
+
+    if (nameStart == std::string_view::npos || nameEnd == std::string_view::npos || nameEnd < nameStart)
+    {
+        return false;
+    }
+
+    std::array<std::string_view, STAT_FIELDS_SIZE> fields {};
+    size_t pos { nameEnd + 1 };
+
+    for (size_t field = STAT_STATE; field < STAT_FIELDS_SIZE; ++field)
+    {
+        const auto start { stat.find_first_not_of(' ', pos) };
+
+        if (start == std::string_view::npos)
+        {
+            break;
+        }
+
+        const auto end { std::min(stat.find_first_of(" \n", start), stat.size()) };
+        fields[field] = stat.substr(start, end - start);
+        pos = end;
+    }
+
+    if (m_fields & PROCESS_FIELDS_STAT)
+    {
+        info["name"]       = std::string(stat.substr(nameStart + 1, nameEnd - nameStart - 1));
+        info["state"]      = std::string(fields[STAT_STATE]);
+        info["ppid"]       = toNumber<int>(fields[STAT_PPID]);
+        info["pgrp"]       = toNumber<int>(fields[STAT_PGRP]);
+        info["session"]    = toNumber<int>(fields[STAT_SESSION]);
+        info["tty"]        = toNumber<int>(fields[STAT_TTY]);
+        info["utime"]      = toNumber<unsigned long long>(fields[STAT_UTIME]);
+        info["stime"]      = toNumber<unsigned long long>(fields[STAT_STIME]);
+        info["priority"]   = toNumber<long>(fields[STAT_PRIORITY]);
+        info["nice"]       = toNumber<long>(fields[STAT_NICE]);
+        info["nlwp"]       = toNumber<int>(fields[STAT_NUM_THREADS]);
+        info["start_time"] = Utils::timeTick2unixTime(toNumber<uint64_t>(fields[STAT_START_TIME]));
+        info["processor"]  = toNumber<int>(fields[STAT_PROCESSOR]);
+    }
+
+    return true;
+}
+
+void ProcfsWalker::fillStatus(nlohmann::json& info)
+{
+    // Real, effective, saved and filesystem ids
+    constexpr size_t REAL { 0 };
+    constexpr size_t EFFECTIVE { 1 };
+    constexpr size_t SAVED { 2 };
+    constexpr size_t FILESYSTEM { 3 };
+
+    auto status { content() };
+
+    while (!status.empty())
+    {
+        const auto lineEnd { std::min(status.find('\n'), status.size()) };
+        const auto line { status.substr(0, lineEnd) };
+        status.remove_prefix(std::min(lineEnd + 1, status.size()));
+
+        if ((m_fields & PROCESS_FIELDS_USERS) && line.rfind("Uid:", 0) == 0)
+        {
+            const auto ids { statusValues(line) };
+
+            if (ids.size() > SAVED)
+            {
+                info["ruser"] = userName(toNumber<uid_t>(ids[REAL]));
+                info["euser"] = userName(toNumber<uid_t>(ids[EFFECTIVE]));
+                info["suser"] = userName(toNumber<uid_t>(ids[SAVED]));
+            }
+        }
+        else if ((m_fields & PROCESS_FIELDS_GROUPS) && line.rfind("Gid:", 0) == 0)
+        {
+            const auto ids { statusValues(line) };
+
+            if (ids.size() > FILESYSTEM)
+            {
+                info["rgroup"] = groupName(toNumber<gid_t>(ids[REAL]));
+                info["egroup"] = groupName(toNumber<gid_t>(ids[EFFECTIVE]));
+                info["sgroup"] = groupName(toNumber<gid_t>(ids[SAVED]));
+                info["fgroup"] = groupName(toNumber<gid_t>(ids[FILESYSTEM]));
+            }
+        }
+        else if ((m_fields & PROCESS_FIELDS_MEMORY) && line.rfind("VmSize:", 0) == 0)
+        {
+            const auto values { statusValues(line) };
+            info["vm_size"] = values.empty() ? 0L : toNumber<long>(values.front());
+        }
+        else if ((m_fields & PROCESS_FIELDS_MEMORY) && line.rfind("VmRSS:", 0) == 0)
+        {
+            const auto values { statusValues(line) };
+            info["resident"] = values.empty() ? 0L : toNumber<long>(values.front());
+        }
+    }
+
+    // Kernel threads have no memory map
+    if (m_fields & PROCESS_FIELDS_MEMORY)
+    {
+        if (!info.contains("vm_size"))
+        {
+            info["vm_size"] = 0L;
+        }
+
+        if (!info.contains("resident"))
+        {
+            info["resident"] = 0L;
+        }
+    }
+}
+
+void ProcfsWalker::fillStatm(nlohmann::json& info)
+{
+    // size resident shared text lib data dt, all in pages
+    const auto statm { content() };
+    const auto sizeEnd { std::min(statm.find(' '), statm.size()) };
+    const auto residentEnd { std::min(statm.find(' ', sizeEnd + 1), statm.size()) };
+    const auto shareEnd { std::min(statm.find(' ', residentEnd + 1), statm.size()) };
+
+    info["size"] = toNumber<long>(statm.substr(0, sizeEnd));
+    info["share"] = residentEnd < statm.size() ? toNumber<long>(statm.substr(residentEnd + 1,
+                                                                              shareEnd - residentEnd - 1)) : 0L;
+}
+
+void ProcfsWalker::fillCmdline(nlohmann::json& info)
+{
+    // Arguments are separated and terminated by NUL characters
+    auto cmdline { content() };
+
+    if (!cmdline.empty() && cmdline.back() == '\0')
+    {
+        cmdline.remove_suffix(1);
+    }
+
+    std::string commandLine;
+    std::string commandLineArgs;
+
+    if (m_size != 0)
+    {
+        auto argEnd { std::min(cmdline.find('\0'), cmdline.size()) };
+        commandLine = cmdline.substr(0, argEnd);
+
+        while (argEnd < cmdline.size())
+        {
+            const auto argStart { argEnd + 1 };
+            argEnd = std::min(cmdline.find('\0', argStart), cmdline.size());
+
+            if (argEnd > argStart)
+            {
+                commandLineArgs += cmdline.substr(argStart, argEnd - argStart);
+
+                if (argEnd < cmdline.size())
+                {
+                    commandLineArgs += " ";
+                }
+            }
+        }
+    }
+
+    info["cmd"]   = commandLine;
+    info["argvs"] = commandLineArgs;
+}
+
+const std::string& ProcfsWalker::userName(uid_t uid)
+{
+    auto it { m_userNames.find(uid) };
+
+    if (it == m_userNames.end())
+    {
+        struct passwd pwd {};
+        struct passwd* result { nullptr };
+        std::vector<char> buffer(PROC_READ_CHUNK * 4);
+
+        const auto name
+        {
+            getpwuid_r(uid, &pwd, buffer.data(), buffer.size(), &result) == 0 && result ? std::string(pwd.pw_name) :
+            std::to_string(uid)
+        };
+        it = m_userNames.emplace(uid, name).first;
+    }
+
+    return it->second;
+}
+
+const std::string& ProcfsWalker::groupName(gid_t gid)
+{
+    auto it { m_groupNames.find(gid) };
+
+    if (it == m_groupNames.end())
+    {
+        struct group grp {};
+        struct group* result { nullptr };
+        std::vector<char> buffer(PROC_READ_CHUNK * 4);
+
+        const auto name
+        {
+            getgrgid_r(gid, &grp, buffer.data(), buffer.size(), &result) == 0 && result ? std::string(grp.gr_name) :
+            std::to_string(gid)
+        };
+        it = m_groupNames.emplace(gid, name).first;
+    }
+
+    return it->second;
+}
@@ -0,0 +1,100 @@
+/*
+ * Wazuh SYSINFO
+ * Copyright (C) 2015, Wazuh Inc.
+ * October 18, 2026.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation.
+ */
+
+#ifndef _PROCFS_WALKER_LINUX_H
+#define _PROCFS_WALKER_LINUX_H
+
+#include <sys/types.h>
+#include <unistd.h>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include <nlohmann/json.hpp>
+#include "sharedDefs.h"
+#include "sysInfo.hpp"
+
+/**
+ * @brief Closes the owned file descriptor when going out of scope.
+ */
+struct FileDescriptorCloser
+{
+    explicit FileDescriptorCloser(int fd)
+        : m_fd { fd }
+    {
+    }
+
+    ~FileDescriptorCloser()
+    {
+        if (m_fd >= 0)
+        {
+            close(m_fd);
+        }
+    }
+
+    FileDescriptorCloser(const FileDescriptorCloser&) = delete;
+    FileDescriptorCloser& operator=(const FileDescriptorCloser&) = delete;
+
+    int m_fd;
+};
+
+/**
+ * @brief Reads the running processes straight from procfs.
+ *
+ * Only the files that hold the requested fields are read. Every file of every process goes through the same
+ * buffer, and user and group names are resolved once per id.
+ */
+class ProcfsWalker final
+{
+    public:
+        /**
+         * @brief Constructor
+         * @param procPath Path where procfs is mounted
+         * @param fields   Mask of ProcessFields to fill for every process
+         */
+        explicit ProcfsWalker(std::string procPath = WM_SYS_PROC_DIR, uint32_t fields = PROCESS_FIELDS_ALL);
+
+        /**
+         * @brief Calls the callback with the information of every running process
+         * @param callback Callback to be called for every single process being found
+         */
+        void walk(const std::function<void(nlohmann::json&)>& callback);
+
+        /**
+         * @brief Reads the information of a single process
+         * @param pid  Process id
+         * @param info JSON filled with the process information
+         * @return false if the process doesn't exist anymore
+         */
+        bool readProcess(const std::string& pid, nlohmann::json& info);
+
+    private:
+        bool readProcess(int procFd, const char* pid, nlohmann::json& info);
+        bool readFile(int dirFd, const char* fileName);
+        std::string_view content() const;
+        bool fillStat(nlohmann::json& info);
+        void fillStatus(nlohmann::json& info);
+        void fillStatm(nlohmann::json& info);
+        void fillCmdline(nlohmann::json& info);
+        const std::string& userName(uid_t uid);
+        const std::string& groupName(gid_t gid);
+
+        const std::string m_procPath;
+        const uint32_t m_fields;
+        std::vector<char> m_buffer;
+        size_t m_size;
+        std::unordered_map<uid_t, std::string> m_userNames;
+        std::unordered_map<gid_t, std::string> m_groupNames;
+};
+
+#endif // _PROCFS_WALKER_LINUX_H
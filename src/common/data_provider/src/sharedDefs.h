@@ -78,6 +78,13 @@ enum IPVersion
     IPVERSION_SIZE
 };
 
+enum NetlinkDumpStatus
+{
+    NETLINK_DUMP_MORE,
+    NETLINK_DUMP_DONE,
+    NETLINK_DUMP_ERROR
+};
+
 enum MacOsPackageTypes
 {
     PKG,
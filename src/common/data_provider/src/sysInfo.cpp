@@ -57,6 +57,22 @@ nlohmann::json SysInfo::hotfixes()
     return getHotfixes();
 }
 
+nlohmann::json SysInfo::packagesFingerprint()
+{
+    return getPackagesFingerprint();
+}
+
+bool SysInfo::processEvents(std::function<void(ProcessEventType, nlohmann::json&)> callback,
+                            std::function<bool()> stopRequested)
+{
+    return getProcessEvents(callback, stopRequested);
+}
+
+bool SysInfo::networkEvents(std::function<void()> callback, std::function<bool()> stopRequested)
+{
+    return getNetworkEvents(callback, stopRequested);
+}
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -11,7 +11,9 @@
 #include <fstream>
 #include <iostream>
 #include <regex>
+#include <sys/stat.h>
 #include <sys/utsname.h>
+#include <unordered_set>
 #include "packages/modernPackageDataRetriever.hpp"
 #include "sharedDefs.h"
 #include "stringHelper.h"
@@ -19,34 +21,22 @@
 #include "cmdHelper.h"
 #include "osinfo/sysOsParsers.h"
 #include "sysInfo.hpp"
-#include <proc/readproc.h>
 #include "networkUnixHelper.h"
 #include "networkHelper.h"
 #include "network/networkLinuxWrapper.h"
 #include "network/networkFamilyDataAFactory.h"
+#include "network/networkNetlinkLinux.h"
 #include "ports/portLinuxWrapper.h"
 #include "ports/portImpl.h"
+#include "ports/portSockDiagLinux.h"
 #include "packages/berkeleyRpmDbHelper.h"
 #include "packages/packageLinuxDataRetriever.h"
+#include "processes/procfsWalkerLinux.h"
+#include "processes/processEventsLinux.h"
 #include "linuxInfoHelper.h"
 
 using ProcessInfo = std::unordered_map<int64_t, std::pair<int32_t, std::string>>;
 
-struct ProcTableDeleter
-{
-    void operator()(PROCTAB* proc)
-    {
-        closeproc(proc);
-    }
-    void operator()(proc_t* proc)
-    {
-        freeproc(proc);
-    }
-};
-
-using SysInfoProcessesTable = std::unique_ptr<PROCTAB, ProcTableDeleter>;
-using SysInfoProcess        = std::unique_ptr<proc_t, ProcTableDeleter>;
-
 static void parseLineAndFillMap(const std::string& line, const std::string& separator, std::map<std::string, std::string>& systemInfo)
 {
     const auto pos{line.find(separator)};
@@ -79,62 +69,15 @@ static bool getSystemInfo(const std::string& fileName, const std::string& separa
     return ret;
 }
 
-static nlohmann::json getProcessInfo(const SysInfoProcess& process)
+static void addPackageSourceFingerprint(const std::string& path, nlohmann::json& fingerprint)
 {
-    nlohmann::json jsProcessInfo{};
-    // Current process information
-    jsProcessInfo["pid"]        = std::to_string(process->tid);
-    jsProcessInfo["name"]       = process->cmd;
-    jsProcessInfo["state"]      = &process->state;
-    jsProcessInfo["ppid"]       = process->ppid;
-    jsProcessInfo["utime"]      = process->utime;
-    jsProcessInfo["stime"]      = process->stime;
-    std::string commandLine;
-    std::string commandLineArgs;
-
-    if (process->cmdline && process->cmdline[0])
-    {
-        commandLine = process->cmdline[0];
-
-        for (int idx = 1; process->cmdline[idx]; ++idx)
-        {
-            const auto cmdlineArgSize { sizeof(process->cmdline[idx]) };
-
-            if (strnlen(process->cmdline[idx], cmdlineArgSize) != 0)
-            {
-                commandLineArgs += process->cmdline[idx];
+    struct stat st {};
 
-                if (process->cmdline[idx + 1])
-                {
-                    commandLineArgs += " ";
-                }
-            }
-        }
+    if (stat(path.c_str(), &st) == 0)
+    {
+        fingerprint[path] = std::to_string(st.st_ino) + ":" + std::to_string(st.st_size) + ":" +
+                            std::to_string(st.st_mtim.tv_sec) + "." + std::to_string(st.st_mtim.tv_nsec);
     }
-
-    jsProcessInfo["cmd"]        = commandLine;
-    jsProcessInfo["argvs"]      = commandLineArgs;
-    jsProcessInfo["euser"]      = process->euser;
-    jsProcessInfo["ruser"]      = process->ruser;
-    jsProcessInfo["suser"]      = process->suser;
-    jsProcessInfo["egroup"]     = process->egroup;
-    jsProcessInfo["rgroup"]     = process->rgroup;
-    jsProcessInfo["sgroup"]     = process->sgroup;
-    jsProcessInfo["fgroup"]     = process->fgroup;
-    jsProcessInfo["priority"]   = process->priority;
-    jsProcessInfo["nice"]       = process->nice;
-    jsProcessInfo["size"]       = process->size;
-    jsProcessInfo["vm_size"]    = process->vm_size;
-    jsProcessInfo["resident"]   = process->vm_rss;
-    jsProcessInfo["share"]      = process->share;
-    jsProcessInfo["start_time"] = Utils::timeTick2unixTime(process->start_time);
-    jsProcessInfo["pgrp"]       = process->pgrp;
-    jsProcessInfo["session"]    = process->session;
-    jsProcessInfo["tgid"]       = process->tgid;
-    jsProcessInfo["tty"]        = process->tty;
-    jsProcessInfo["processor"]  = process->processor;
-    jsProcessInfo["nlwp"]       = process->nlwp;
-    return jsProcessInfo;
 }
 
 static void getSerialNumber(nlohmann::json& info)
@@ -389,13 +332,19 @@ nlohmann::json SysInfo::getNetworks() const
     std::map<std::string, std::vector<ifaddrs*>> networkInterfaces;
     Utils::NetworkUnixHelper::getNetworks(interfacesAddress, networkInterfaces);
 
+    // Link attributes come from a single rtnetlink dump, sysfs is only read if it fails.
+    std::map<std::string, NetlinkLinkData> links;
+    NetlinkNetworkReader::links(links);
+
     for (const auto& interface : networkInterfaces)
     {
         nlohmann::json ifaddr {};
+        const auto itLink { links.find(interface.first) };
+        const auto link { links.end() != itLink ? &itLink->second : nullptr };
 
         for (auto addr : interface.second)
         {
-            const auto networkInterfacePtr { FactoryNetworkFamilyCreator<OSPlatformType::LINUX>::create(std::make_shared<NetworkLinuxInterface>(addr)) };
+            const auto networkInterfacePtr { FactoryNetworkFamilyCreator<OSPlatformType::LINUX>::create(std::make_shared<NetworkLinuxInterface>(addr, link)) };
 
             if (networkInterfacePtr)
             {
@@ -410,7 +359,7 @@ nlohmann::json SysInfo::getNetworks() const
 }
 
 
-ProcessInfo portProcessInfo(const std::string& procPath, const std::deque<int64_t>& inodes)
+ProcessInfo portProcessInfo(const std::string& procPath, const std::unordered_set<int64_t>& inodes)
 {
     ProcessInfo ret;
 
@@ -486,10 +435,7 @@ ProcessInfo portProcessInfo(const std::string& procPath, const std::deque<int64_
                             {
                                 int64_t inode {findInode(fdFilePath)};
 
-                                if (std::any_of(inodes.cbegin(), inodes.cend(), [&](const auto it)
-                            {
-                                return it == inode;
-                            }))
+                                if (inodes.find(inode) != inodes.end())
                                 {
                                     std::string statPath {procFilePath + "/" + "stat"};
                                     std::string processName = getProcessName(statPath);
@@ -512,43 +458,65 @@ ProcessInfo portProcessInfo(const std::string& procPath, const std::deque<int64_
     return ret;
 }
 
-nlohmann::json SysInfo::getPorts() const
+static void getProcPorts(const std::pair<const PortType, std::string>& portType, bool listeningOnly, nlohmann::json& ports)
 {
-    nlohmann::json ports;
-    std::deque<int64_t> inodes;
-
-    for (const auto& portType : PORTS_TYPE)
+    constexpr auto PORT_LISTENING_STATE {"listening"};
+    const auto fileIoWrapper = std::make_unique<file_io::FileIO>();
+    const auto fileContent { fileIoWrapper->getFileContent(WM_SYS_NET_DIR + portType.second) };
+    auto rows { Utils::split(fileContent, '\n') };
+    auto fileBody { false };
+    const auto tcp { PROTOCOL_TYPE.at(portType.first) == TCP };
+
+    for (auto& row : rows)
     {
-        const auto fileIoWrapper = std::make_unique<file_io::FileIO>();
-        const auto fileContent { fileIoWrapper->getFileContent(WM_SYS_NET_DIR + portType.second) };
-        auto rows { Utils::split(fileContent, '\n') };
-        auto fileBody { false };
+        nlohmann::json port {};
 
-        for (auto& row : rows)
+        try
         {
-            nlohmann::json port {};
-
-            try
+            if (fileBody)
             {
-                if (fileBody)
+                row = Utils::trim(row);
+                Utils::replaceAll(row, "\t", " ");
+                Utils::replaceAll(row, "  ", " ");
+                std::make_unique<PortImpl>(std::make_shared<LinuxPortWrapper>(portType.first, row))->buildPortData(port);
+
+                if (!listeningOnly || !tcp || port.at("state") == PORT_LISTENING_STATE)
                 {
-                    row = Utils::trim(row);
-                    Utils::replaceAll(row, "\t", " ");
-                    Utils::replaceAll(row, "  ", " ");
-                    std::make_unique<PortImpl>(std::make_shared<LinuxPortWrapper>(portType.first, row))->buildPortData(port);
-                    inodes.push_back(port.at("inode"));
                     ports.push_back(std::move(port));
                 }
-
-                fileBody = true;
-            }
-            catch (const std::exception& e)
-            {
-                std::cerr << "Error while parsing port: " << e.what() << std::endl;
             }
+
+            fileBody = true;
+        }
+        catch (const std::exception& e)
+        {
+            std::cerr << "Error while parsing port: " << e.what() << std::endl;
+        }
+    }
+}
+
+nlohmann::json SysInfo::getPorts() const
+{
+    nlohmann::json ports;
+    const auto listeningOnly { m_portsScope == PORTS_SCOPE_LISTENING };
+    const SockDiagPortReader sockDiag { listeningOnly };
+
+    for (const auto& portType : PORTS_TYPE)
+    {
+        // Kernels without the tcp_diag or udp_diag modules refuse the dump, procfs has the same sockets.
+        if (!sockDiag.read(portType.first, ports))
+        {
+            getProcPorts(portType, listeningOnly, ports);
         }
     }
 
+    std::unordered_set<int64_t> inodes;
+
+    for (const auto& port : ports)
+    {
+        inodes.insert(port.at("inode").get<int64_t>());
+    }
+
 
     if (!inodes.empty())
     {
@@ -579,21 +547,18 @@ nlohmann::json SysInfo::getPorts() const
 
 void SysInfo::getProcessesInfo(std::function<void(nlohmann::json&)> callback) const
 {
+    ProcfsWalker { WM_SYS_PROC_DIR, m_processFields }.walk(callback);
+}
 
-    const SysInfoProcessesTable spProcTable
-    {
-        openproc(PROC_FILLMEM | PROC_FILLSTAT | PROC_FILLSTATUS | PROC_FILLARG | PROC_FILLGRP | PROC_FILLUSR | PROC_FILLCOM | PROC_FILLENV)
-    };
-
-    SysInfoProcess spProcInfo { readproc(spProcTable.get(), nullptr) };
+bool SysInfo::getProcessEvents(std::function<void(ProcessEventType, nlohmann::json&)> callback,
+                               std::function<bool()> stopRequested) const
+{
+    return ProcessEventsListener { WM_SYS_PROC_DIR, m_processFields }.listen(callback, stopRequested);
+}
 
-    while (nullptr != spProcInfo)
-    {
-        // Get process information object and push it to the caller
-        auto processInfo = getProcessInfo(spProcInfo);
-        callback(processInfo);
-        spProcInfo.reset(readproc(spProcTable.get(), nullptr));
-    }
+bool SysInfo::getNetworkEvents(std::function<void()> callback, std::function<bool()> stopRequested) const
+{
+    return NetworkEventsListener {}.listen(callback, stopRequested);
 }
 
 void SysInfo::getPackages(std::function<void(nlohmann::json&)> callback) const
@@ -607,6 +572,80 @@ void SysInfo::getPackages(std::function<void(nlohmann::json&)> callback) const
     ModernFactoryPackagesCreator<HAS_STDFILESYSTEM>::getPackages(searchPaths, callback);
 }
 
+nlohmann::json SysInfo::getPackagesFingerprint() const
+{
+    nlohmann::json fingerprint = nlohmann::json::object();
+    const auto fsWrapper = std::make_unique<filesystem_wrapper::FileSystemWrapper>();
+
+    addPackageSourceFingerprint(DPKG_STATUS_PATH, fingerprint);
+    addPackageSourceFingerprint(std::string(SNAP_PATH) + "/snaps", fingerprint);
+
+    try
+    {
+        for (const auto& entry : fsWrapper->list_directory(RPM_PATH))
+        {
+            // Berkeley DB environment files change on every read of the database
+            if (!Utils::startsWith(entry.filename().string(), "__db"))
+            {
+                addPackageSourceFingerprint(entry.string(), fingerprint);
+            }
+        }
+    }
+    catch (const std::exception&)
+    {
+        // No rpm database
+    }
+
+    // Installing, upgrading or removing a Python package renames an entry of its site-packages directory
+    for (const auto& baseDir : UNIX_PYPI_DEFAULT_BASE_DIRS)
+    {
+        try
+        {
+            std::deque<std::string> expandedPaths;
+            fsWrapper->expand_absolute_path(baseDir, expandedPaths);
+
+            for (const auto& path : expandedPaths)
+            {
+                addPackageSourceFingerprint(path, fingerprint);
+            }
+        }
+        catch (const std::exception&)
+        {
+            // Ignore exception, continue with next folder
+        }
+    }
+
+    for (const auto& baseDir : UNIX_NPM_DEFAULT_BASE_DIRS)
+    {
+        try
+        {
+            std::deque<std::string> expandedPaths;
+            fsWrapper->expand_absolute_path(baseDir, expandedPaths);
+
+            for (const auto& path : expandedPaths)
+            {
+                const auto nodeModulesFolder {std::filesystem::path(path) / "node_modules"};
+
+                if (fsWrapper->exists(nodeModulesFolder))
+                {
+                    addPackageSourceFingerprint(nodeModulesFolder.string(), fingerprint);
+
+                    for (const auto& packageFolder : fsWrapper->list_directory(nodeModulesFolder))
+                    {
+                        addPackageSourceFingerprint((packageFolder / "package.json").string(), fingerprint);
+                    }
+                }
+            }
+        }
+        catch (const std::exception&)
+        {
+            // Ignore exception, continue with next folder
+        }
+    }
+
+    return fingerprint;
+}
+
 nlohmann::json SysInfo::getHotfixes() const
 {
     // Currently not supported for this OS.
@@ -470,6 +470,25 @@ void SysInfo::getPackages(std::function<void(nlohmann::json&)> callback) const
     ModernFactoryPackagesCreator<HAS_STDFILESYSTEM>::getPackages(searchPaths, callback);
 }
 
+nlohmann::json SysInfo::getPackagesFingerprint() const
+{
+    // Currently not supported for this OS.
+    return nlohmann::json();
+}
+
+bool SysInfo::getProcessEvents(std::function<void(ProcessEventType, nlohmann::json&)> /*callback*/,
+                               std::function<bool()> /*stopRequested*/) const
+{
+    // Currently not supported for this OS.
+    return false;
+}
+
+bool SysInfo::getNetworkEvents(std::function<void()> /*callback*/, std::function<bool()> /*stopRequested*/) const
+{
+    // Currently not supported for this OS.
+    return false;
+}
+
 nlohmann::json SysInfo::getHotfixes() const
 {
     // Currently not supported for this OS.
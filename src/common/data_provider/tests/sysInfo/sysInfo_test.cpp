@@ -104,6 +104,10 @@ class SysInfoWrapper: public SysInfo
         MOCK_METHOD(nlohmann::json, getHotfixes, (), (const override));
         MOCK_METHOD(void, getPackages, (std::function<void(nlohmann::json&)>), (const override));
         MOCK_METHOD(void, getProcessesInfo, (std::function<void(nlohmann::json&)>), (const override));
+        MOCK_METHOD(nlohmann::json, getPackagesFingerprint, (), (const override));
+        MOCK_METHOD(bool, getProcessEvents, (std::function<void(ProcessEventType, nlohmann::json&)>,
+                                             std::function<bool()>), (const override));
+        MOCK_METHOD(bool, getNetworkEvents, (std::function<void()>, std::function<bool()>), (const override));
 
 };
 
@@ -223,6 +227,55 @@ TEST_F(SysInfoTest, hotfixes)
     EXPECT_FALSE(result.empty());
 }
 
+TEST_F(SysInfoTest, packagesFingerprint)
+{
+    SysInfoWrapper info;
+    EXPECT_CALL(info, getPackagesFingerprint()).WillOnce(Return(R"({"/var/lib/dpkg/status":"1:2:3.4"})"_json));
+    const auto result = info.packagesFingerprint();
+    EXPECT_FALSE(result.empty());
+}
+
+TEST_F(SysInfoTest, processEvents)
+{
+    SysInfoWrapper info;
+    EXPECT_CALL(info, getProcessEvents(_, _)).WillOnce([](auto callback, auto stopRequested)
+    {
+        nlohmann::json process {{"pid", "1234"}};
+        callback(PROCESS_FINISHED, process);
+        return !stopRequested();
+    });
+    std::vector<std::string> finished;
+    EXPECT_TRUE(info.processEvents([&finished](ProcessEventType type, nlohmann::json & data)
+    {
+        EXPECT_EQ(PROCESS_FINISHED, type);
+        finished.push_back(data.at("pid"));
+    }, []()
+    {
+        return false;
+    }));
+    EXPECT_EQ(std::vector<std::string> {"1234"}, finished);
+}
+
+TEST_F(SysInfoTest, networkEvents)
+{
+    SysInfoWrapper info;
+    EXPECT_CALL(info, getNetworkEvents(_, _)).WillOnce([](auto callback, auto stopRequested)
+    {
+        callback();
+        callback();
+        return !stopRequested();
+    });
+    auto changes { 0 };
+    EXPECT_TRUE(info.networkEvents([&changes]()
+    {
+        ++changes;
+    }, []()
+    {
+        return false;
+    }));
+    EXPECT_EQ(2, changes);
+}
+
 TEST_F(SysInfoTest, hardware_c_interface)
 {
     cJSON* object = NULL;
@@ -9,9 +9,16 @@
  * Foundation.
  */
 #include <ifaddrs.h>
+#include <cstring>
+#include <linux/if.h>
+#include <linux/if_link.h>
+#include <linux/netlink.h>
+#include <linux/rtnetlink.h>
+#include <net/if_arp.h>
 #include "sysInfoNetworkLinux_test.h"
 #include "network/networkInterfaceLinux.h"
 #include "network/networkFamilyDataAFactory.h"
+#include "network/networkNetlinkLinux.h"
 
 void SysInfoNetworkLinuxTest::SetUp() {};
 
@@ -22,6 +29,39 @@ void SysInfoNetworkLinuxTest::TearDown()
 using ::testing::_;
 using ::testing::Return;
 
+static void appendAttribute(std::vector<char>& buffer, unsigned short type, const void* data, size_t size)
+{
+    const auto offset { buffer.size() };
+    buffer.resize(offset + RTA_SPACE(size));
+
+    auto attribute { reinterpret_cast<rtattr*>(buffer.data() + offset) };
+    attribute->rta_type = type;
+    attribute->rta_len = static_cast<unsigned short>(RTA_LENGTH(size));
+    std::memcpy(RTA_DATA(attribute), data, size);
+}
+
+static void appendNetlinkMessage(std::vector<char>& buffer, unsigned short type, const std::vector<char>& payload)
+{
+    const auto offset { buffer.size() };
+    buffer.resize(offset + NLMSG_SPACE(payload.size()));
+
+    auto header { reinterpret_cast<nlmsghdr*>(buffer.data() + offset) };
+    header->nlmsg_len = static_cast<__u32>(NLMSG_LENGTH(payload.size()));
+    header->nlmsg_type = type;
+    std::memcpy(NLMSG_DATA(header), payload.data(), payload.size());
+}
+
+static std::vector<char> linkPayload(const std::string& name, int type)
+{
+    std::vector<char> payload(NLMSG_ALIGN(sizeof(ifinfomsg)));
+    auto info { reinterpret_cast<ifinfomsg*>(payload.data()) };
+    info->ifi_family = AF_UNSPEC;
+    info->ifi_type = static_cast<unsigned short>(type);
+
+    appendAttribute(payload, IFLA_IFNAME, name.c_str(), name.size() + 1);
+    return payload;
+}
+
 class SysInfoNetworkLinuxWrapperMock: public INetworkInterfaceWrapper
 {
     public:
@@ -184,3 +224,75 @@ TEST_F(SysInfoNetworkLinuxTest, Test_Gateway_7546)
     EXPECT_EQ(1500, ifaddr.at("mtu").get<int32_t>());
     EXPECT_EQ("A12BA8C0", ifaddr.at("gateway").get_ref<const std::string&>());
 }
+
+TEST_F(SysInfoNetworkLinuxTest, Test_Netlink_Links)
+{
+    auto payload { linkPayload("eth0", ARPHRD_ETHER) };
+    const unsigned char mac[] { 0x00, 0xa0, 0xc9, 0x14, 0xc8, 0x29 };
+    appendAttribute(payload, IFLA_ADDRESS, mac, sizeof(mac));
+    const uint32_t mtu { 1500 };
+    appendAttribute(payload, IFLA_MTU, &mtu, sizeof(mtu));
+    const uint8_t operState { IF_OPER_UP };
+    appendAttribute(payload, IFLA_OPERSTATE, &operState, sizeof(operState));
+    rtnl_link_stats64 stats {};
+    stats.rx_packets = 10;
+    stats.tx_packets = 11;
+    stats.rx_bytes = 5000000000;
+    stats.tx_bytes = 13;
+    stats.rx_errors = 14;
+    stats.tx_errors = 15;
+    stats.rx_dropped = 16;
+    stats.rx_missed_errors = 1;
+    stats.tx_dropped = 17;
+    appendAttribute(payload, IFLA_STATS64, &stats, sizeof(stats));
+
+    std::vector<char> buffer;
+    appendNetlinkMessage(buffer, RTM_NEWLINK, payload);
+    appendNetlinkMessage(buffer, RTM_NEWLINK, linkPayload("tun0", ARPHRD_NONE));
+
+    std::map<std::string, NetlinkLinkData> links;
+    EXPECT_EQ(NETLINK_DUMP_MORE, NetlinkNetworkReader::handleLinkMessages(buffer.data(), buffer.size(), links));
+    ASSERT_EQ(2u, links.size());
+
+    const auto& eth0 { links.at("eth0") };
+    EXPECT_EQ(ARPHRD_ETHER, eth0.type);
+    EXPECT_EQ("up", eth0.operState);
+    EXPECT_EQ("00:a0:c9:14:c8:29", eth0.mac);
+    EXPECT_EQ(1500, eth0.mtu);
+    EXPECT_EQ(10u, eth0.stats.rxPackets);
+    EXPECT_EQ(11u, eth0.stats.txPackets);
+    EXPECT_EQ(5000000000, eth0.stats.rxBytes);
+    EXPECT_EQ(13, eth0.stats.txBytes);
+    EXPECT_EQ(14u, eth0.stats.rxErrors);
+    EXPECT_EQ(15u, eth0.stats.txErrors);
+    EXPECT_EQ(17u, eth0.stats.rxDropped);
+    EXPECT_EQ(17u, eth0.stats.txDropped);
+
+    const auto& tun0 { links.at("tun0") };
+    EXPECT_EQ("unknown", tun0.operState);
+    EXPECT_EQ("", tun0.mac);
+    EXPECT_EQ(0, tun0.mtu);
+}
+
+TEST_F(SysInfoNetworkLinuxTest, Test_Netlink_Links_Done_And_Error)
+{
+    std::map<std::string, NetlinkLinkData> links;
+    std::vector<char> buffer;
+    appendNetlinkMessage(buffer, NLMSG_DONE, std::vector<char>(sizeof(int)));
+    EXPECT_EQ(NETLINK_DUMP_DONE, NetlinkNetworkReader::handleLinkMessages(buffer.data(), buffer.size(), links));
+
+    buffer.clear();
+    appendNetlinkMessage(buffer, NLMSG_ERROR, std::vector<char>(sizeof(nlmsgerr)));
+    EXPECT_EQ(NETLINK_DUMP_ERROR, NetlinkNetworkReader::handleLinkMessages(buffer.data(), buffer.size(), links));
+    EXPECT_TRUE(links.empty());
+}
+
+TEST_F(SysInfoNetworkLinuxTest, Test_Netlink_Events)
+{
+    std::vector<char> buffer;
+    appendNetlinkMessage(buffer, NLMSG_NOOP, {});
+    EXPECT_FALSE(NetworkEventsListener::isChange(buffer.data(), buffer.size()));
+
+    appendNetlinkMessage(buffer, RTM_NEWADDR, std::vector<char>(sizeof(ifaddrmsg)));
+    EXPECT_TRUE(NetworkEventsListener::isChange(buffer.data(), buffer.size()));
+}
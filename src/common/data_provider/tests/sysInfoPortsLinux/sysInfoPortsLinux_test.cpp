@@ -0,0 +1,140 @@
+/*
+ * Wazuh SysInfo
+ * Copyright (C) 2015, Wazuh Inc.
+ * October 18, 2026.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation.
+ */
+
+#include "sysInfoPortsLinux_test.h"
+#include <arpa/inet.h>
+#include <cstring>
+#include <linux/inet_diag.h>
+#include <linux/netlink.h>
+#include <linux/sock_diag.h>
+#include <netinet/tcp.h>
+#include <vector>
+#include "ports/portSockDiagLinux.h"
+
+void SysInfoPortsLinuxTest::SetUp() {};
+
+void SysInfoPortsLinuxTest::TearDown()
+{
+};
+
+static void appendNetlinkMessage(std::vector<char>& buffer, unsigned short type, const void* payload, size_t size)
+{
+    const auto offset { buffer.size() };
+    buffer.resize(offset + NLMSG_SPACE(size));
+
+    auto header { reinterpret_cast<nlmsghdr*>(buffer.data() + offset) };
+    header->nlmsg_len = static_cast<__u32>(NLMSG_LENGTH(size));
+    header->nlmsg_type = type;
+    std::memcpy(NLMSG_DATA(header), payload, size);
+}
+
+static inet_diag_msg socketMessage(int family, uint8_t state, uint16_t localPort, uint32_t inode)
+{
+    inet_diag_msg message {};
+    message.idiag_family = static_cast<__u8>(family);
+    message.idiag_state = state;
+    message.id.idiag_sport = htons(localPort);
+    message.idiag_inode = inode;
+    return message;
+}
+
+TEST_F(SysInfoPortsLinuxTest, TcpListeningSocket)
+{
+    auto message { socketMessage(AF_INET, TCP_LISTEN, 22, 4274126910) };
+    inet_pton(AF_INET, "127.0.0.1", message.id.idiag_src);
+    message.idiag_rqueue = 1;
+    message.idiag_wqueue = 4096;
+
+    std::vector<char> buffer;
+    appendNetlinkMessage(buffer, SOCK_DIAG_BY_FAMILY, &message, sizeof(message));
+
+    auto ports = nlohmann::json::array();
+    EXPECT_EQ(NETLINK_DUMP_MORE, SockDiagPortReader::handleMessages(TCP_IPV4, buffer.data(), buffer.size(), ports));
+    ASSERT_EQ(1u, ports.size());
+
+    const auto& port { ports.at(0) };
+    EXPECT_EQ("tcp", port.at("protocol").get_ref<const std::string&>());
+    EXPECT_EQ("127.0.0.1", port.at("local_ip").get_ref<const std::string&>());
+    EXPECT_EQ(22, port.at("local_port").get<int32_t>());
+    EXPECT_EQ("0.0.0.0", port.at("remote_ip").get_ref<const std::string&>());
+    EXPECT_EQ(0, port.at("remote_port").get<int32_t>());
+    // The backlog limit isn't reported as a queue
+    EXPECT_EQ(0, port.at("tx_queue").get<int32_t>());
+    EXPECT_EQ(1, port.at("rx_queue").get<int32_t>());
+    EXPECT_EQ(4274126910, port.at("inode").get<int64_t>());
+    EXPECT_EQ("listening", port.at("state").get_ref<const std::string&>());
+    EXPECT_TRUE(port.at("pid").is_null());
+    EXPECT_TRUE(port.at("process").is_null());
+}
+
+TEST_F(SysInfoPortsLinuxTest, Udp6Socket)
+{
+    auto message { socketMessage(AF_INET6, TCP_CLOSE, 5353, 1234) };
+    inet_pton(AF_INET6, "fe80::1", message.id.idiag_src);
+    inet_pton(AF_INET6, "2001:db8::2", message.id.idiag_dst);
+    message.id.idiag_dport = htons(53);
+    message.idiag_rqueue = 7;
+    message.idiag_wqueue = 8;
+
+    std::vector<char> buffer;
+    appendNetlinkMessage(buffer, SOCK_DIAG_BY_FAMILY, &message, sizeof(message));
+
+    auto ports = nlohmann::json::array();
+    EXPECT_EQ(NETLINK_DUMP_MORE, SockDiagPortReader::handleMessages(UDP_IPV6, buffer.data(), buffer.size(), ports));
+    ASSERT_EQ(1u, ports.size());
+
+    const auto& port { ports.at(0) };
+    EXPECT_EQ("udp6", port.at("protocol").get_ref<const std::string&>());
+    EXPECT_EQ("fe80::1", port.at("local_ip").get_ref<const std::string&>());
+    EXPECT_EQ(5353, port.at("local_port").get<int32_t>());
+    EXPECT_EQ("2001:db8::2", port.at("remote_ip").get_ref<const std::string&>());
+    EXPECT_EQ(53, port.at("remote_port").get<int32_t>());
+    EXPECT_EQ(8, port.at("tx_queue").get<int32_t>());
+    EXPECT_EQ(7, port.at("rx_queue").get<int32_t>());
+    EXPECT_EQ(1234, port.at("inode").get<int64_t>());
+    EXPECT_TRUE(port.at("state").is_null());
+}
+
+TEST_F(SysInfoPortsLinuxTest, DumpDoneAndError)
+{
+    const auto first { socketMessage(AF_INET, TCP_ESTABLISHED, 40000, 1) };
+    const auto second { socketMessage(AF_INET, TCP_TIME_WAIT, 40001, 2) };
+    const int done { 0 };
+
+    std::vector<char> buffer;
+    appendNetlinkMessage(buffer, SOCK_DIAG_BY_FAMILY, &first, sizeof(first));
+    appendNetlinkMessage(buffer, SOCK_DIAG_BY_FAMILY, &second, sizeof(second));
+    appendNetlinkMessage(buffer, NLMSG_DONE, &done, sizeof(done));
+
+    auto ports = nlohmann::json::array();
+    EXPECT_EQ(NETLINK_DUMP_DONE, SockDiagPortReader::handleMessages(TCP_IPV4, buffer.data(), buffer.size(), ports));
+    ASSERT_EQ(2u, ports.size());
+    EXPECT_EQ("established", ports.at(0).at("state").get_ref<const std::string&>());
+    EXPECT_EQ("time_wait", ports.at(1).at("state").get_ref<const std::string&>());
+
+    const nlmsgerr error { -2, {} };
+    buffer.clear();
+    appendNetlinkMessage(buffer, NLMSG_ERROR, &error, sizeof(error));
+    EXPECT_EQ(NETLINK_DUMP_ERROR, SockDiagPortReader::handleMessages(UDP_IPV4, buffer.data(), buffer.size(), ports));
+    EXPECT_EQ(2u, ports.size());
+}
+
+TEST_F(SysInfoPortsLinuxTest, ReadFromKernel)
+{
+    // Every kernel this agent runs on supports sock_diag for TCP over IPv4.
+    auto ports = nlohmann::json::array();
+    EXPECT_TRUE(SockDiagPortReader { true }.read(TCP_IPV4, ports));
+
+    for (const auto& port : ports)
+    {
+        EXPECT_EQ("listening", port.at("state").get_ref<const std::string&>());
+    }
+}
@@ -0,0 +1,214 @@
+/*
+ * Wazuh SysInfo
+ * Copyright (C) 2015, Wazuh Inc.
+ * October 18, 2026.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation.
+ */
+
+#include "sysInfoProcessesLinux_test.h"
+#include <cstring>
+#include <fstream>
+#include <linux/cn_proc.h>
+#include <linux/connector.h>
+#include <linux/netlink.h>
+#include <unistd.h>
+#include "processes/processEventsLinux.h"
+#include "processes/procfsWalkerLinux.h"
+
+using namespace std::string_literals;
+
+constexpr auto PROCESS_STAT
+{
+    "1234 (my (weird) name) S 1 1234 1234 34817 1234 4194560 1000 0 0 0 25 12 0 0 20 0 3 0 5000 10485760 500 "
+    "18446744073709551615 1 1 0 0 0 0 0 0 0 0 0 0 17 2 0 0 0 0 0\n"
+};
+
+constexpr auto PROCESS_STATUS
+{
+    "Name:\tmy (weird) name\n"
+    "Umask:\t0022\n"
+    "State:\tS (sleeping)\n"
+    "Tgid:\t1234\n"
+    "Uid:\t0\t0\t0\t0\n"
+    "Gid:\t0\t0\t0\t0\n"
+    "VmSize:\t   10240 kB\n"
+    "VmRSS:\t    2000 kB\n"
+};
+
+static void appendProcessEvent(std::vector<char>& buffer, const proc_event& event)
+{
+    const auto offset { buffer.size() };
+    buffer.resize(offset + NLMSG_SPACE(sizeof(cn_msg) + sizeof(proc_event)));
+
+    auto header { reinterpret_cast<nlmsghdr*>(buffer.data() + offset) };
+    header->nlmsg_len = NLMSG_LENGTH(sizeof(cn_msg) + sizeof(proc_event));
+    header->nlmsg_type = NLMSG_DONE;
+
+    auto message { reinterpret_cast<cn_msg*>(NLMSG_DATA(header)) };
+    message->id.idx = CN_IDX_PROC;
+    message->id.val = CN_VAL_PROC;
+    message->len = sizeof(proc_event);
+    std::memcpy(message->data, &event, sizeof(event));
+}
+
+void SysInfoProcessesLinuxTest::SetUp()
+{
+    m_procPath = std::filesystem::temp_directory_path() / ("sysinfo_proc_" + std::to_string(getpid()));
+    std::filesystem::create_directories(m_procPath / "self");
+    addProcessFile("1234", "stat", PROCESS_STAT);
+    addProcessFile("1234", "status", PROCESS_STATUS);
+    addProcessFile("1234", "statm", "2560 500 300 10 0 200 0\n");
+    addProcessFile("1234", "cmdline", "/usr/bin/app\0--verbose\0\0-c\0/etc/app.conf\0"s);
+    // Process that finished while being listed
+    std::filesystem::create_directories(m_procPath / "4321");
+};
+
+void SysInfoProcessesLinuxTest::TearDown()
+{
+    std::filesystem::remove_all(m_procPath);
+};
+
+void SysInfoProcessesLinuxTest::addProcessFile(const std::string& pid,
+                                               const std::string& fileName,
+                                               const std::string& content)
+{
+    std::filesystem::create_directories(m_procPath / pid);
+    std::ofstream file { m_procPath / pid / fileName, std::ios::binary };
+    file << content;
+}
+
+TEST_F(SysInfoProcessesLinuxTest, allFields)
+{
+    std::vector<nlohmann::json> processes;
+    ProcfsWalker { m_procPath.string() }.walk([&processes](nlohmann::json & process)
+    {
+        processes.push_back(process);
+    });
+
+    ASSERT_EQ(processes.size(), 1u);
+    const auto& process { processes.front() };
+
+    EXPECT_EQ(process.at("pid"), "1234");
+    EXPECT_EQ(process.at("tgid"), 1234);
+    EXPECT_EQ(process.at("name"), "my (weird) name");
+    EXPECT_EQ(process.at("state"), "S");
+    EXPECT_EQ(process.at("ppid"), 1);
+    EXPECT_EQ(process.at("pgrp"), 1234);
+    EXPECT_EQ(process.at("session"), 1234);
+    EXPECT_EQ(process.at("tty"), 34817);
+    EXPECT_EQ(process.at("utime"), 25);
+    EXPECT_EQ(process.at("stime"), 12);
+    EXPECT_EQ(process.at("priority"), 20);
+    EXPECT_EQ(process.at("nice"), 0);
+    EXPECT_EQ(process.at("nlwp"), 3);
+    EXPECT_EQ(process.at("processor"), 2);
+    EXPECT_TRUE(process.at("start_time").is_number_unsigned());
+    EXPECT_EQ(process.at("cmd"), "/usr/bin/app");
+    EXPECT_EQ(process.at("argvs"), "--verbose -c /etc/app.conf");
+    EXPECT_EQ(process.at("euser"), "root");
+    EXPECT_EQ(process.at("ruser"), "root");
+    EXPECT_EQ(process.at("suser"), "root");
+    EXPECT_EQ(process.at("egroup"), "root");
+    EXPECT_EQ(process.at("rgroup"), "root");
+    EXPECT_EQ(process.at("sgroup"), "root");
+    EXPECT_EQ(process.at("fgroup"), "root");
+    EXPECT_EQ(process.at("size"), 2560);
+    EXPECT_EQ(process.at("vm_size"), 10240);
+    EXPECT_EQ(process.at("resident"), 2000);
+    EXPECT_EQ(process.at("share"), 300);
+}
+
+TEST_F(SysInfoProcessesLinuxTest, selectedFields)
+{
+    std::vector<nlohmann::json> processes;
+    ProcfsWalker { m_procPath.string(), PROCESS_FIELDS_CMDLINE | PROCESS_FIELDS_USERS }.walk(
+        [&processes](nlohmann::json & process)
+    {
+        processes.push_back(process);
+    });
+
+    ASSERT_EQ(processes.size(), 1u);
+    const auto& process { processes.front() };
+
+    EXPECT_EQ(process.at("pid"), "1234");
+    EXPECT_EQ(process.at("cmd"), "/usr/bin/app");
+    EXPECT_EQ(process.at("euser"), "root");
+    EXPECT_FALSE(process.contains("name"));
+    EXPECT_FALSE(process.contains("egroup"));
+    EXPECT_FALSE(process.contains("size"));
+}
+
+TEST_F(SysInfoProcessesLinuxTest, kernelThread)
+{
+    addProcessFile("2", "stat", "2 (kthreadd) S 0 0 0 0 -1 2129984 0 0 0 0 0 0 0 0 20 0 1 0 2 0 0\n");
+    addProcessFile("2", "status", "Name:\tkthreadd\nUid:\t0\t0\t0\t0\nGid:\t0\t0\t0\t0\n");
+    addProcessFile("2", "statm", "0 0 0 0 0 0 0\n");
+    addProcessFile("2", "cmdline", "");
+
+    nlohmann::json kernelThread;
+    ProcfsWalker { m_procPath.string() }.walk([&kernelThread](nlohmann::json & process)
+    {
+        if (process.at("pid") == "2")
+        {
+            kernelThread = process;
+        }
+    });
+
+    ASSERT_FALSE(kernelThread.empty());
+    EXPECT_EQ(kernelThread.at("name"), "kthreadd");
+    EXPECT_EQ(kernelThread.at("cmd"), "");
+    EXPECT_EQ(kernelThread.at("argvs"), "");
+    EXPECT_EQ(kernelThread.at("vm_size"), 0);
+    EXPECT_EQ(kernelThread.at("resident"), 0);
+}
+
+TEST_F(SysInfoProcessesLinuxTest, processEvents)
+{
+    std::vector<char> buffer;
+    proc_event event {};
+
+    event.what = proc_event::PROC_EVENT_FORK;
+    event.event_data.fork.child_pid = 1234;
+    event.event_data.fork.child_tgid = 1234;
+    appendProcessEvent(buffer, event);
+
+    // New thread of an existing process
+    event.event_data.fork.child_pid = 1235;
+    appendProcessEvent(buffer, event);
+
+    // Process that finished before being read
+    event = {};
+    event.what = proc_event::PROC_EVENT_EXEC;
+    event.event_data.exec.process_pid = 4321;
+    event.event_data.exec.process_tgid = 4321;
+    appendProcessEvent(buffer, event);
+
+    event = {};
+    event.what = proc_event::PROC_EVENT_EXIT;
+    event.event_data.exit.process_pid = 4321;
+    event.event_data.exit.process_tgid = 4321;
+    appendProcessEvent(buffer, event);
+
+    // Thread exit
+    event.event_data.exit.process_pid = 4322;
+    appendProcessEvent(buffer, event);
+
+    std::vector<std::pair<ProcessEventType, nlohmann::json>> events;
+    ProcessEventsListener { m_procPath.string(), PROCESS_FIELDS_STAT }.handleMessages(buffer.data(), buffer.size(),
+                                                                                      [&events](ProcessEventType type, nlohmann::json & data)
+    {
+        events.emplace_back(type, data);
+    });
+
+    ASSERT_EQ(events.size(), 2u);
+    EXPECT_EQ(events[0].first, PROCESS_STARTED);
+    EXPECT_EQ(events[0].second.at("pid"), "1234");
+    EXPECT_EQ(events[0].second.at("name"), "my (weird) name");
+    EXPECT_FALSE(events[0].second.contains("cmd"));
+    EXPECT_EQ(events[1].first, PROCESS_FINISHED);
+    EXPECT_EQ(events[1].second, R"({"pid":"4321"})"_json);
+}
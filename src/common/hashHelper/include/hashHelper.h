@@ -45,6 +45,24 @@ namespace Utils
             {
                 initializeContext(hashType, m_spCtx);
             }
+            // Copies the state of the other context, so the data it has hashed so far isn't hashed again.
+            HashData(const HashData& other)
+                : m_spCtx{createContext()}
+            {
+                // LCOV_EXCL_START
+                if (!EVP_MD_CTX_copy_ex(m_spCtx.get(), other.m_spCtx.get()))
+                {
+                    throw std::runtime_error
+                    {
+                        "Error copying EVP_MD_CTX."
+                    };
+                }
+
+                // LCOV_EXCL_STOP
+            }
+            HashData& operator=(const HashData&) = delete;
+            HashData(HashData&&) = default;
+            HashData& operator=(HashData&&) = default;
             // LCOV_EXCL_START
             ~HashData() = default;
             // LCOV_EXCL_STOP
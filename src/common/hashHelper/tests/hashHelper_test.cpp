@@ -57,6 +57,24 @@ TEST_F(HashHelperTest, HashHelperHashIterativeSha1)
     EXPECT_TRUE(!memcmp(expected, result.data(), result.size()));
 }
 
+TEST_F(HashHelperTest, HashHelperCopyKeepsHashedData)
+{
+    const unsigned char expected[] {0x2d, 0x53, 0x3b, 0x9d, 0x9f, 0x0f, 0x06, 0xef, 0x4e, 0x3c, 0x23, 0xfd, 0x49, 0x6c, 0xfe, 0xb2, 0x78, 0x0e, 0xda, 0x7f};
+    const std::string prefix{"HA"};
+    const std::string suffix{"SH"};
+    HashData prefixHash;
+    prefixHash.update(prefix.c_str(), prefix.size());
+
+    for (auto i = 0; i < 2; ++i)
+    {
+        HashData hash{prefixHash};
+        hash.update(suffix.c_str(), suffix.size());
+        const auto result{ hash.hash() };
+        EXPECT_EQ(sizeof(expected), result.size());
+        EXPECT_TRUE(!memcmp(expected, result.data(), result.size()));
+    }
+}
+
 TEST_F(HashHelperTest, HashHelperHashBufferSha256)
 {
     const unsigned char expected[] {0xc1, 0xfb, 0x44, 0xc7, 0x26, 0x28, 0xea, 0xe4, 0x91, 0x32, 0x06, 0x2f, 0xe5, 0x10, 0x9f, 0x65,
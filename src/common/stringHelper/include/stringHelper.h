@@ -208,35 +208,16 @@ namespace Utils
 
     static std::string asciiToHex(const std::vector<unsigned char>& asciiData)
     {
-        std::string ret;
-        std::stringstream ss;
+        constexpr auto HEX_DIGITS {"0123456789abcdef"};
+        std::string ret(asciiData.size() * 2, '\0');
+        auto output {ret.begin()};
 
-        for (const auto& val : asciiData)
+        for (const auto& value : asciiData)
         {
-            ss << std::hex << std::setfill('0') << std::setw(2) << static_cast<unsigned int>(val);
+            *output++ = HEX_DIGITS[value >> 4];
+            *output++ = HEX_DIGITS[value & 0x0f];
         }
 
-        if (ss.good())
-        {
-            ret = ss.str();
-        }
-        // LCOV_EXCL_START
-        else
-        {
-            const auto size {asciiData.size() * 2};
-            const auto buffer {std::make_unique<char[]>(size + 1)};
-            char* output {buffer.get()};
-
-            for (const auto& value : asciiData)
-            {
-                snprintf(output, 3, "%02x", value);
-                output += 2;
-            }
-
-            ret = std::string {buffer.get(), size};
-        }
-
-        // LCOV_EXCL_STOP
         return ret;
     }
 
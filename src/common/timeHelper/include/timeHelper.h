@@ -13,6 +13,8 @@
 #define _TIME_HELPER_H
 
 #include "stringHelper.h"
+#include <algorithm>
+#include <array>
 #include <chrono>
 #include <ctime>
 #include <iomanip>
@@ -98,31 +100,53 @@ namespace Utils
         return ss.str();
     }
 
-    static std::string getCurrentISO8601()
+    /**
+     * @brief Get the ISO 8601 representation of a point in time, in UTC with milliseconds.
+     *
+     * The formatted date and time are cached per thread and only rewritten when the
+     * second changes, so consecutive calls just fill in the milliseconds.
+     *
+     * @param timePoint Point in time to convert.
+     * @return std::string ISO 8601 timestamp. Format: "YYYY-MM-DDThh:mm:ss.sssZ".
+     */
+    static std::string timePointToISO8601(const std::chrono::system_clock::time_point& timePoint)
     {
-        // Get local time in UTC
-        auto now = std::chrono::system_clock::now();
-        auto itt = std::chrono::system_clock::to_time_t(now);
+        // "YYYY-MM-DDThh:mm:ss" followed by ".sssZ"
+        constexpr size_t SECONDS_LENGTH {19};
+        thread_local std::array<char, 25> cachedTimestamp {"1970-01-01T00:00:00.000Z"};
+        thread_local std::time_t cachedSeconds {0};
 
-        std::ostringstream ss;
-        struct tm buf;
-        tm* localTime = gmtime_r(&itt, &buf);
+        const auto milliseconds =
+            std::chrono::floor<std::chrono::milliseconds>(timePoint.time_since_epoch()).count();
+        const auto seconds = std::chrono::floor<std::chrono::seconds>(timePoint.time_since_epoch()).count();
+        const auto itt = static_cast<std::time_t>(seconds);
 
-        if (localTime == nullptr)
+        if (itt != cachedSeconds)
         {
-            return "1970/01/01 00:00:00";
-        }
+            struct tm buf;
+            std::array<char, SECONDS_LENGTH + 1> formatted {};
 
-        ss << std::put_time(localTime, "%FT%T");
+            if (gmtime_r(&itt, &buf) == nullptr ||
+                std::strftime(formatted.data(), formatted.size(), "%Y-%m-%dT%H:%M:%S", &buf) != SECONDS_LENGTH)
+            {
+                return "1970/01/01 00:00:00";
+            }
 
-        // Get milliseconds from the current time
-        auto milliseconds =
-            std::chrono::duration_cast<std::chrono::milliseconds>(now.time_since_epoch()).count() % 1000;
+            std::copy_n(formatted.begin(), SECONDS_LENGTH, cachedTimestamp.begin());
+            cachedSeconds = itt;
+        }
 
-        // ISO 8601
-        ss << '.' << std::setfill('0') << std::setw(3) << milliseconds << 'Z';
+        const auto millisecondsPart = static_cast<int>(milliseconds - seconds * 1000);
+        cachedTimestamp[SECONDS_LENGTH + 1] = static_cast<char>('0' + millisecondsPart / 100);
+        cachedTimestamp[SECONDS_LENGTH + 2] = static_cast<char>('0' + millisecondsPart / 10 % 10);
+        cachedTimestamp[SECONDS_LENGTH + 3] = static_cast<char>('0' + millisecondsPart % 10);
 
-        return ss.str();
+        return {cachedTimestamp.data(), cachedTimestamp.size() - 1};
+    }
+
+    static std::string getCurrentISO8601()
+    {
+        return timePointToISO8601(std::chrono::system_clock::now());
     }
 
     static std::string timestampToISO8601(const std::string& timestamp)
@@ -89,6 +89,24 @@ TEST_F(TimeUtilsTest, TimestampToISO8601)
     EXPECT_EQ("", Utils::timestampToISO8601("21:00:00"));
 }
 
+TEST_F(TimeUtilsTest, CurrentISO8601ValidFormat)
+{
+    const std::regex iso8601Regex(R"(^\d{4}-\d{2}-\d{2}T\d{2}:\d{2}:\d{2}\.\d{3}Z$)");
+    EXPECT_TRUE(std::regex_match(Utils::getCurrentISO8601(), iso8601Regex));
+}
+
+TEST_F(TimeUtilsTest, TimePointToISO8601)
+{
+    const auto timePoint {std::chrono::system_clock::from_time_t(1605232465)};
+
+    EXPECT_EQ("2020-11-13T01:54:25.000Z", Utils::timePointToISO8601(timePoint));
+    EXPECT_EQ("2020-11-13T01:54:25.007Z", Utils::timePointToISO8601(timePoint + std::chrono::milliseconds(7)));
+    EXPECT_EQ("2020-11-13T01:54:25.999Z", Utils::timePointToISO8601(timePoint + std::chrono::microseconds(999999)));
+    EXPECT_EQ("2020-11-13T01:54:26.050Z", Utils::timePointToISO8601(timePoint + std::chrono::milliseconds(1050)));
+    EXPECT_EQ("2020-11-13T01:54:25.120Z", Utils::timePointToISO8601(timePoint + std::chrono::milliseconds(120)));
+    EXPECT_EQ("1970-01-01T00:00:00.000Z", Utils::timePointToISO8601(std::chrono::system_clock::from_time_t(0)));
+}
+
 TEST_F(TimeUtilsTest, RawTimestampToISO8601)
 {
     EXPECT_EQ("2020-11-13T01:54:25.000Z", Utils::rawTimestampToISO8601("1605232465"));
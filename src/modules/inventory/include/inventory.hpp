@@ -3,14 +3,17 @@
 #include <chrono>
 #include <condition_variable>
 #include <ctime>
+#include <deque>
 #include <memory>
 #include <mutex>
 #include <stack>
 #include <string>
 #include <thread>
+#include <utility>
 
 #include <commonDefs.h>
 #include <dbsync.hpp>
+#include <hashHelper.h>
 #include <inventoryNormalizer.hpp>
 #include <sysInfoInterface.hpp>
 
@@ -20,6 +23,18 @@
 
 #include <boost/asio/awaitable.hpp>
 
+/// @brief Tables reported by the module, resolved from the table name once per change
+enum class InventoryTable
+{
+    Hardware,
+    System,
+    Networks,
+    Packages,
+    Hotfixes,
+    Ports,
+    Processes
+};
+
 class Inventory
 {
 public:
@@ -55,7 +70,12 @@ public:
 
     void SetAgentUUID(const std::string& agentUUID)
     {
+        const auto idPrefix {agentUUID + ":"};
+        Utils::HashData idPrefixHash;
+        idPrefixHash.update(idPrefix.c_str(), idPrefix.size());
+
         m_agentUUID = agentUUID;
+        m_idPrefixHash = std::move(idPrefixHash);
     }
 
 private:
@@ -67,13 +87,6 @@ private:
     void Destroy();
 
     std::string GetCreateStatement() const;
-    nlohmann::json EcsProcessesData(const nlohmann::json& originalData, bool createFields = true);
-    nlohmann::json EcsSystemData(const nlohmann::json& originalData, bool createFields = true);
-    nlohmann::json EcsHotfixesData(const nlohmann::json& originalData, bool createFields = true);
-    nlohmann::json EcsHardwareData(const nlohmann::json& originalData, bool createFields = true);
-    nlohmann::json EcsPackageData(const nlohmann::json& originalData, bool createFields = true);
-    nlohmann::json EcsPortData(const nlohmann::json& originalData, bool createFields = true);
-    nlohmann::json EcsNetworkData(const nlohmann::json& originalData, bool createFields = true);
     nlohmann::json GetNetworkData();
     nlohmann::json GetPortsData();
 
@@ -84,31 +97,42 @@ private:
                       const bool isFirstScan);
     void ProcessEvent(ReturnTypeCallback result,
                       const nlohmann::json& item,
-                      const std::string& table,
+                      const InventoryTable table,
                       const bool isFirstScan);
-    nlohmann::json GenerateMessage(ReturnTypeCallback result, const nlohmann::json& item, const std::string& table);
+    nlohmann::json GenerateMessage(ReturnTypeCallback result,
+                                   const nlohmann::json& data,
+                                   const InventoryTable table,
+                                   const std::string& id);
+    std::string SerializeMessage(ReturnTypeCallback result,
+                                 const nlohmann::json& data,
+                                 const InventoryTable table,
+                                 const std::string& id) const;
     void NotifyEvent(ReturnTypeCallback result,
                      nlohmann::json& msg,
                      const nlohmann::json& item,
-                     const std::string& table,
-                     const bool isFirstScan);
+                     const InventoryTable table);
 
     void TryCatchTask(const std::function<void()>& task) const;
-    void ScanHardware();
-    void ScanSystem();
-    void ScanNetwork();
-    void ScanPackages();
-    void ScanHotfixes();
-    void ScanPorts();
-    void ScanProcesses();
+    void SyncTable(const std::string& table, const nlohmann::json& rows, bool& firstScanDone);
+    std::function<void()> CollectHardware();
+    std::function<void()> CollectSystem();
+    std::function<void()> CollectNetwork();
+    std::function<void()> CollectPackages();
+    std::function<void()> CollectHotfixes();
+    std::function<void()> CollectPorts();
+    std::function<void()> CollectProcesses();
     void Scan();
+    void ListenProcessEvents();
+    void ApplyProcessEvents(const std::deque<std::pair<ProcessEventType, nlohmann::json>>& events);
+    void ListenNetworkEvents();
     void SyncLoop();
     void ShowConfig();
     cJSON* Dump() const;
     static void LogErrorInventory(const std::string& log);
-    nlohmann::json EcsData(const nlohmann::json& data, const std::string& table, bool createFields = true);
-    std::string GetPrimaryKeys(const nlohmann::json& data, const std::string& table);
-    std::string CalculateHashId(const nlohmann::json& data, const std::string& table);
+    static void
+    EcsData(nlohmann::json& target, const nlohmann::json& data, const InventoryTable table, bool createFields = true);
+    static std::string GetPrimaryKeys(const nlohmann::json& data, const InventoryTable table);
+    std::string CalculateHashId(const nlohmann::json& data, const InventoryTable table) const;
     nlohmann::json AddPreviousFields(nlohmann::json& current, const nlohmann::json& previous);
     nlohmann::json
     GenerateStatelessEvent(const std::string& operation, const std::string& type, const nlohmann::json& data);
@@ -118,20 +142,9 @@ private:
     void DeleteMetadata(const std::string& key);
     void CleanMetadata();
 
-    void SetJsonField(nlohmann::json& target,
-                      const nlohmann::json& source,
-                      const std::string& keyPath,
-                      const std::string& jsonKey,
-                      const std::optional<std::string>& defaultValue,
-                      bool createFields);
-    void SetJsonFieldArray(nlohmann::json& target,
-                           const nlohmann::json& source,
-                           const std::string& destPath,
-                           const std::string& sourceKey,
-                           bool createFields);
-
     const std::string m_moduleName {"inventory"};
     std::string m_agentUUID {""}; // Agent UUID
+    Utils::HashData m_idPrefixHash; // SHA1 state after hashing the "<agent UUID>:" prefix of every id
     std::shared_ptr<ISysInfo> m_spInfo;
     std::function<void(const std::string&)> m_reportDiffFunction;
     bool m_enabled;              // Main switch
@@ -146,6 +159,9 @@ private:
     bool m_portsAll;             // Scan only listening ports or all
     bool m_processes;            // Running processes inventory
     bool m_hotfixes;             // Windows hotfixes installed
+    size_t m_threadCount;        // Collectors run concurrently
+    bool m_processEvents;        // Apply kernel process events between scans
+    bool m_networkEvents;        // Rescan networks between scans when the kernel reports a change
     std::atomic<bool> m_stopping;
     bool m_notify;
     std::unique_ptr<DBSync> m_spDBSync;
@@ -161,4 +177,7 @@ private:
     bool m_portsFirstScan;     // Opened ports first scan flag
     bool m_processesFirstScan; // Running processes first scan flag
     bool m_hotfixesFirstScan;  // Windows hotfixes installed first scan flag
+    nlohmann::json m_packagesFingerprint; // Package sources state at the last complete packages scan
+    std::deque<std::pair<ProcessEventType, nlohmann::json>> m_pendingProcessEvents; // Guarded by m_mutex
+    bool m_networksChanged {false}; // Guarded by m_mutex
 };
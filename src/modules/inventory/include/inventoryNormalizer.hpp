@@ -1,7 +1,50 @@
 #pragma once
 #include <map>
 #include <nlohmann/json.hpp>
+#include <optional>
+#include <regex>
 #include <string>
+#include <vector>
+
+/// @brief Normalizer pattern, compiled once when the rules are loaded
+///
+/// Patterns that only look for a fixed text ("Siri", "(Siri)", "Kaspersky.*", ".*(Quick ).*", ...) are matched
+/// with string comparisons, the rest with the regular expression.
+class NormalizerPattern
+{
+public:
+    /// @brief How a value is matched
+    enum class Kind
+    {
+        Regex,
+        Equals,
+        StartsWith,
+        EndsWith,
+        Contains
+    };
+
+    /// @brief Constructor
+    /// @param pattern Regular expression (ECMAScript syntax)
+    /// @throws std::regex_error if the pattern is not a valid regular expression
+    explicit NormalizerPattern(const std::string& pattern);
+
+    /// @brief Checks if the whole value matches the pattern, like std::regex_match
+    bool Matches(const std::string& value) const;
+
+    /// @brief Replaces every match of the pattern in value, like std::regex_replace
+    std::string Replace(const std::string& value, const std::string& format) const;
+
+    /// @brief Gets how values are matched
+    Kind GetKind() const
+    {
+        return m_kind;
+    }
+
+private:
+    Kind m_kind {Kind::Regex};
+    std::string m_literal;
+    std::regex m_regex;
+};
 
 class InvNormalizer
 {
@@ -12,8 +55,27 @@ public:
     void RemoveExcluded(const std::string& type, nlohmann::json& data) const;
 
 private:
+    struct Exclusion
+    {
+        std::string fieldName;
+        NormalizerPattern pattern;
+    };
+
+    struct DictionaryRule
+    {
+        std::optional<std::pair<std::string, NormalizerPattern>> find;
+        std::optional<std::pair<std::string, NormalizerPattern>> replace;
+        std::string replaceValue;
+        std::optional<std::pair<std::string, std::string>> add;
+    };
+
     static std::map<std::string, nlohmann::json>
     GetTypeValues(const std::string& configFile, const std::string& target, const std::string& type);
-    const std::map<std::string, nlohmann::json> m_typeExclusions;
-    const std::map<std::string, nlohmann::json> m_typeDictionary;
+    static std::map<std::string, std::vector<Exclusion>>
+    CompileExclusions(const std::map<std::string, nlohmann::json>& typeExclusions);
+    static std::map<std::string, std::vector<DictionaryRule>>
+    CompileDictionary(const std::map<std::string, nlohmann::json>& typeDictionary);
+    static void NormalizeItem(const std::vector<DictionaryRule>& dictionary, nlohmann::json& item);
+    const std::map<std::string, std::vector<Exclusion>> m_typeExclusions;
+    const std::map<std::string, std::vector<DictionaryRule>> m_typeDictionary;
 };
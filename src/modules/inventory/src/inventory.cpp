@@ -7,6 +7,10 @@
 
 #include <cjson/cJSON.h>
 
+// Process fields stored in the processes table: pid, name, ppid, cmd, argvs, users, groups, start_time, tgid and tty
+constexpr uint32_t INVENTORY_PROCESS_FIELDS {PROCESS_FIELDS_STAT | PROCESS_FIELDS_CMDLINE | PROCESS_FIELDS_USERS |
+                                             PROCESS_FIELDS_GROUPS};
+
 void Inventory::Start()
 {
 
@@ -26,7 +30,7 @@ void Inventory::Start()
     try
     {
         Inventory::Instance().Init(
-            std::make_shared<SysInfo>(),
+            std::make_shared<SysInfo>(INVENTORY_PROCESS_FIELDS, m_portsAll ? PORTS_SCOPE_ALL : PORTS_SCOPE_LISTENING),
             [this](const std::string& diff) { this->SendDeltaEvent(diff); },
             m_dbFilePath,
             INVENTORY_NORM_CONFIG_DISK_PATH,
@@ -66,6 +70,15 @@ void Inventory::Setup(std::shared_ptr<const configuration::ConfigurationParser>
     m_processes =
         configurationParser->GetConfigOrDefault(config::inventory::DEFAULT_PROCESSES, "inventory", "processes");
     m_hotfixes = configurationParser->GetConfigOrDefault(config::inventory::DEFAULT_HOTFIXES, "inventory", "hotfixes");
+    m_threadCount = configurationParser->GetConfigInRangeOrDefault<size_t>(config::inventory::DEFAULT_THREAD_COUNT,
+                                                                           std::optional<size_t>(1),
+                                                                           std::optional<size_t> {},
+                                                                           "inventory",
+                                                                           "thread_count");
+    m_processEvents = configurationParser->GetConfigOrDefault(
+        config::inventory::DEFAULT_PROCESS_EVENTS, "inventory", "process_events");
+    m_networkEvents = configurationParser->GetConfigOrDefault(
+        config::inventory::DEFAULT_NETWORK_EVENTS, "inventory", "network_events");
 }
 
 void Inventory::Stop()
@@ -205,6 +218,15 @@ cJSON* Inventory::Dump() const
     else
         cJSON_AddStringToObject(invJson, "hotfixes", "no");
 #endif
+    cJSON_AddNumberToObject(invJson, "thread_count", static_cast<double>(m_threadCount));
+    if (m_processEvents)
+        cJSON_AddStringToObject(invJson, "process_events", "yes");
+    else
+        cJSON_AddStringToObject(invJson, "process_events", "no");
+    if (m_networkEvents)
+        cJSON_AddStringToObject(invJson, "network_events", "yes");
+    else
+        cJSON_AddStringToObject(invJson, "network_events", "no");
 
     cJSON_AddItemToObject(rootJson, "inventory", invJson);
 
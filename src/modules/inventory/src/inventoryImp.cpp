@@ -1,5 +1,7 @@
 #include "statelessEvent.hpp"
 
+#include <algorithm>
+#include <atomic>
 #include <commonDefs.h>
 #include <config.h>
 #include <defs.h>
@@ -8,15 +10,24 @@
 #include <iostream>
 #include <nlohmann/json.hpp>
 #include <stringHelper.h>
+#include <string_view>
 #include <timeHelper.h>
+#include <unordered_set>
+#include <vector>
 
 constexpr auto EMPTY_VALUE {""};
 
 constexpr std::time_t INVENTORY_DEFAULT_INTERVAL {3600000};
 constexpr size_t MAX_ID_SIZE = 512;
 
+// Enough for most first scan messages, so they are written without growing the buffer
+constexpr size_t SERIALIZED_MESSAGE_RESERVE {1024};
+
 constexpr auto QUEUE_SIZE {4096};
 
+// Process events beyond this are dropped until the sync loop catches up, the next processes scan reconciles them.
+constexpr size_t MAX_PENDING_PROCESS_EVENTS {QUEUE_SIZE};
+
 static const std::map<ReturnTypeCallback, std::string> OPERATION_MAP {
     // LCOV_EXCL_START
     {MODIFIED, "update"},
@@ -100,7 +111,6 @@ constexpr auto PORTS_SQL_STATEMENT {
        pid BIGINT,
        process TEXT,
        PRIMARY KEY (inode,protocol,local_ip,local_port)) WITHOUT ROWID;)"};
-static const std::vector<std::string> PORTS_ITEM_ID_FIELDS {"inode", "protocol", "local_ip", "local_port"};
 
 constexpr auto NETWORKS_SQL_STATEMENT {
     R"(CREATE TABLE networks (
@@ -143,6 +153,14 @@ constexpr auto SYSTEM_TABLE {"system"};
 constexpr auto HARDWARE_TABLE {"hardware"};
 constexpr auto MD_TABLE {"metadata"};
 
+const std::unordered_map<std::string, InventoryTable> TABLE_MAP = {{NETWORKS_TABLE, InventoryTable::Networks},
+                                                                   {PACKAGES_TABLE, InventoryTable::Packages},
+                                                                   {HOTFIXES_TABLE, InventoryTable::Hotfixes},
+                                                                   {PORTS_TABLE, InventoryTable::Ports},
+                                                                   {PROCESSES_TABLE, InventoryTable::Processes},
+                                                                   {SYSTEM_TABLE, InventoryTable::System},
+                                                                   {HARDWARE_TABLE, InventoryTable::Hardware}};
+
 const std::unordered_map<std::string, std::string> TABLE_TO_KEY_MAP = {{NETWORKS_TABLE, "networks-first-scan"},
                                                                        {PACKAGES_TABLE, "packages-first-scan"},
                                                                        {HOTFIXES_TABLE, "hotfixes-first-scan"},
@@ -151,121 +169,368 @@ const std::unordered_map<std::string, std::string> TABLE_TO_KEY_MAP = {{NETWORKS
                                                                        {SYSTEM_TABLE, "system-first-scan"},
                                                                        {HARDWARE_TABLE, "hardware-first-scan"}};
 
-static std::string GetItemId(const nlohmann::json& item, const std::vector<std::string>& idFields)
+// Identity of a socket in the ports table, it points into the scanned JSON so building it doesn't copy anything.
+struct PortKey
 {
-    Utils::HashData hash;
+    int64_t inode;
+    int64_t localPort;
+    std::string_view protocol;
+    std::string_view localIp;
 
-    for (const auto& field : idFields)
+    bool operator==(const PortKey& other) const
     {
-        const auto& value {item.at(field)};
+        return inode == other.inode && localPort == other.localPort && protocol == other.protocol &&
+               localIp == other.localIp;
+    }
+};
 
-        if (!value.is_null())
+struct PortKeyHash
+{
+    size_t operator()(const PortKey& key) const
+    {
+        auto seed {std::hash<int64_t> {}(key.inode)};
+
+        for (const auto hash : {std::hash<int64_t> {}(key.localPort),
+                                std::hash<std::string_view> {}(key.protocol),
+                                std::hash<std::string_view> {}(key.localIp)})
         {
-            if (value.is_string())
-            {
-                const auto& valueString {value.get<std::string>()};
-                hash.update(valueString.c_str(), valueString.size());
-            }
-            else
-            {
-                const auto& valueNumber {value.get<unsigned long>()};
-                const auto valueString {std::to_string(valueNumber)};
-                hash.update(valueString.c_str(), valueString.size());
-            }
+            seed ^= hash + 0x9e3779b9 + (seed << 6) + (seed >> 2);
         }
+
+        return seed;
     }
+};
 
-    return Utils::asciiToHex(hash.hash());
+static int64_t PortKeyNumber(const nlohmann::json& value)
+{
+    return value.is_number() ? value.get<int64_t>() : -1;
 }
 
-static bool IsElementDuplicated(const nlohmann::json& input, const std::pair<std::string, std::string>& keyValue)
+static std::string_view PortKeyString(const nlohmann::json& value)
 {
-    const auto it {std::find_if(input.begin(),
-                                input.end(),
-                                [&keyValue](const auto& elem) { return elem.at(keyValue.first) == keyValue.second; })};
-    return it != input.end();
+    return value.is_string() ? std::string_view {value.get_ref<const std::string&>()} : std::string_view {};
 }
 
-nlohmann::json Inventory::EcsData(const nlohmann::json& data, const std::string& table, bool createFields)
+static const char* TableName(const InventoryTable table)
 {
-    nlohmann::json ret;
-    if (table == HARDWARE_TABLE)
+    switch (table)
     {
-        ret = EcsHardwareData(data, createFields);
+        case InventoryTable::Hardware: return HARDWARE_TABLE;
+        case InventoryTable::System: return SYSTEM_TABLE;
+        case InventoryTable::Networks: return NETWORKS_TABLE;
+        case InventoryTable::Packages: return PACKAGES_TABLE;
+        case InventoryTable::Hotfixes: return HOTFIXES_TABLE;
+        case InventoryTable::Ports: return PORTS_TABLE;
+        case InventoryTable::Processes: return PROCESSES_TABLE;
     }
-    else if (table == SYSTEM_TABLE)
+
+    return EMPTY_VALUE; // LCOV_EXCL_LINE
+}
+
+// ECS field of an event and the column it's taken from. The path is split when the field tables are built, so
+// writing an event only walks its objects.
+struct EcsField
+{
+    EcsField(const std::string& pointer, std::string sourceColumn, bool isArray = false)
+        : path {Utils::split(pointer.substr(1), '/')}
+        , column {std::move(sourceColumn)}
+        , array {isArray}
     {
-        ret = EcsSystemData(data, createFields);
     }
-    else if (table == PACKAGES_TABLE)
+
+    std::vector<std::string> path;
+    std::string column;
+    bool array;
+};
+
+static const std::vector<EcsField>& EcsFields(const InventoryTable table)
+{
+    static const std::vector<EcsField> HARDWARE_FIELDS {
+        {"/observer/serial_number", "board_serial"},
+        {"/host/cpu/name", "cpu_name"},
+        {"/host/cpu/cores", "cpu_cores"},
+        {"/host/cpu/speed", "cpu_mhz"},
+        {"/host/memory/total", "ram_total"},
+        {"/host/memory/free", "ram_free"},
+        {"/host/memory/used/percentage", "ram_usage"},
+    };
+
+    static const std::vector<EcsField> SYSTEM_FIELDS {
+        {"/host/architecture", "architecture"},
+        {"/host/hostname", "hostname"},
+        {"/host/os/kernel", "os_build"},
+        {"/host/os/full", "os_codename"},
+        {"/host/os/name", "os_name"},
+        {"/host/os/platform", "os_platform"},
+        {"/host/os/version", "os_version"},
+        {"/host/os/type", "sysname"},
+    };
+
+    static const std::vector<EcsField> PACKAGES_FIELDS {
+        {"/package/architecture", "architecture"},
+        {"/package/description", "description"},
+        {"/package/installed", "install_time"},
+        {"/package/name", "name"},
+        {"/package/path", "location"},
+        {"/package/size", "size"},
+        {"/package/type", "format"},
+        {"/package/version", "version"},
+    };
+
+    static const std::vector<EcsField> PROCESSES_FIELDS {
+        {"/process/pid", "pid"},
+        {"/process/name", "name"},
+        {"/process/parent/pid", "ppid"},
+        {"/process/command_line", "cmd"},
+        {"/process/args", "argvs"},
+        {"/process/user/id", "euser"},
+        {"/process/real_user/id", "ruser"},
+        {"/process/saved_user/id", "suser"},
+        {"/process/group/id", "egroup"},
+        {"/process/real_group/id", "rgroup"},
+        {"/process/saved_group/id", "sgroup"},
+        {"/process/start", "start_time"},
+        {"/process/thread/id", "tgid"},
+        {"/process/tty/char_device/major", "tty"},
+    };
+
+    static const std::vector<EcsField> HOTFIXES_FIELDS {
+        {"/package/hotfix/name", "hotfix"},
+    };
+
+    static const std::vector<EcsField> PORTS_FIELDS {
+        {"/network/protocol", "protocol"},
+        {"/source/ip", "local_ip", true},
+        {"/source/port", "local_port"},
+        {"/destination/ip", "remote_ip", true},
+        {"/destination/port", "remote_port"},
+        {"/host/network/egress/queue", "tx_queue"},
+        {"/host/network/ingress/queue", "rx_queue"},
+        {"/file/inode", "inode"},
+        {"/interface/state", "state"},
+        {"/process/pid", "pid"},
+        {"/process/name", "process"},
+    };
+
+    static const std::vector<EcsField> NETWORKS_FIELDS {
+        {"/host/ip", "address", true},
+        {"/host/mac", "mac"},
+        {"/host/network/egress/bytes", "tx_bytes"},
+        {"/host/network/egress/packets", "tx_packets"},
+        {"/host/network/ingress/bytes", "rx_bytes"},
+        {"/host/network/ingress/packets", "rx_packets"},
+        {"/host/network/egress/drops", "tx_dropped"},
+        {"/host/network/egress/errors", "tx_errors"},
+        {"/host/network/ingress/drops", "rx_dropped"},
+        {"/host/network/ingress/errors", "rx_errors"},
+        {"/interface/mtu", "mtu"},
+        {"/interface/state", "state"},
+        {"/interface/type", "iface_type"},
+        {"/network/netmask", "netmask", true},
+        {"/network/gateway", "gateway", true},
+        {"/network/broadcast", "broadcast", true},
+        {"/network/dhcp", "dhcp"},
+        {"/network/type", "proto_type"},
+        {"/network/metric", "metric"},
+        {"/observer/ingress/interface/alias", "adapter"},
+        {"/observer/ingress/interface/name", "iface"},
+    };
+
+    switch (table)
     {
-        ret = EcsPackageData(data, createFields);
+        case InventoryTable::Hardware: return HARDWARE_FIELDS;
+        case InventoryTable::System: return SYSTEM_FIELDS;
+        case InventoryTable::Networks: return NETWORKS_FIELDS;
+        case InventoryTable::Packages: return PACKAGES_FIELDS;
+        case InventoryTable::Hotfixes: return HOTFIXES_FIELDS;
+        case InventoryTable::Ports: return PORTS_FIELDS;
+        case InventoryTable::Processes: return PROCESSES_FIELDS;
     }
-    else if (table == PROCESSES_TABLE)
+
+    static const std::vector<EcsField> NO_FIELDS;
+    return NO_FIELDS; // LCOV_EXCL_LINE
+}
+
+// Value of the column mapped to an ECS field, or nullptr when the field is reported as null or as an empty array
+static const nlohmann::json* EcsValue(const EcsField& field, const nlohmann::json& data)
+{
+    const auto value {data.find(field.column)};
+
+    if (value == data.end() || value->is_null() ||
+        (value->is_string() && value->get_ref<const std::string&>().empty()) || (field.array && value->empty()))
     {
-        ret = EcsProcessesData(data, createFields);
+        return nullptr;
     }
-    else if (table == HOTFIXES_TABLE)
+
+    return &*value;
+}
+
+// Objects of the ECS document of a table, with the keys sorted like nlohmann::json dumps them
+struct EcsNode
+{
+    std::map<std::string, EcsNode> children;
+    const EcsField* field {nullptr};
+};
+
+static std::map<InventoryTable, EcsNode> BuildEcsLayouts()
+{
+    std::map<InventoryTable, EcsNode> layouts;
+
+    for (const auto table : {InventoryTable::Hardware,
+                             InventoryTable::System,
+                             InventoryTable::Networks,
+                             InventoryTable::Packages,
+                             InventoryTable::Hotfixes,
+                             InventoryTable::Ports,
+                             InventoryTable::Processes})
     {
-        ret = EcsHotfixesData(data, createFields);
+        auto& root {layouts[table]};
+
+        for (const auto& field : EcsFields(table))
+        {
+            auto* node {&root};
+
+            for (const auto& token : field.path)
+            {
+                node = &node->children[token];
+            }
+
+            node->field = &field;
+        }
     }
-    else if (table == PORTS_TABLE)
+
+    return layouts;
+}
+
+static const EcsNode& EcsLayout(const InventoryTable table)
+{
+    static const auto LAYOUTS {BuildEcsLayouts()};
+    return LAYOUTS.at(table);
+}
+
+// Writes the members of an ECS object, ECS keys are plain identifiers so they are written without escaping
+static void WriteEcsMembers(std::string& output, const EcsNode& node, const nlohmann::json& data)
+{
+    auto first {true};
+
+    for (const auto& [key, child] : node.children)
     {
-        ret = EcsPortData(data, createFields);
+        if (!first)
+        {
+            output += ',';
+        }
+
+        first = false;
+        output += '"';
+        output += key;
+        output += "\":";
+
+        if (child.field == nullptr)
+        {
+            output += '{';
+            WriteEcsMembers(output, child, data);
+            output += '}';
+            continue;
+        }
+
+        const auto* value {EcsValue(*child.field, data)};
+
+        if (child.field->array)
+        {
+            output += '[';
+            output += value ? value->dump() : EMPTY_VALUE;
+            output += ']';
+        }
+        else
+        {
+            output += value ? value->dump() : "null";
+        }
     }
-    else if (table == NETWORKS_TABLE)
+}
+
+void Inventory::EcsData(nlohmann::json& target,
+                        const nlohmann::json& data,
+                        const InventoryTable table,
+                        bool createFields)
+{
+    for (const auto& field : EcsFields(table))
     {
-        ret = EcsNetworkData(data, createFields);
+        if (!createFields && !data.contains(field.column))
+        {
+            continue;
+        }
+
+        auto* node {&target};
+
+        for (auto token {field.path.cbegin()}; token != field.path.cend() - 1; ++token)
+        {
+            node = &(*node)[*token];
+        }
+
+        auto& fieldValue {(*node)[field.path.back()]};
+        const auto* value {EcsValue(field, data)};
+
+        if (field.array)
+        {
+            fieldValue = nlohmann::json::array();
+
+            if (value)
+            {
+                fieldValue.push_back(*value);
+            }
+        }
+        else
+        {
+            fieldValue = value ? *value : nullptr;
+        }
     }
-    return ret;
 }
 
-std::string Inventory::GetPrimaryKeys([[maybe_unused]] const nlohmann::json& data, const std::string& table)
+std::string Inventory::GetPrimaryKeys(const nlohmann::json& data, const InventoryTable table)
 {
     std::string ret;
-    if (table == HARDWARE_TABLE)
-    {
-        ret = data["board_serial"];
-    }
-    else if (table == SYSTEM_TABLE)
+    const auto addColumns {[&data, &ret](std::initializer_list<const char*> columns)
+                           {
+                               auto first {true};
+
+                               for (const auto column : columns)
+                               {
+                                   if (!first)
+                                   {
+                                       ret += ':';
+                                   }
+
+                                   ret += data.at(column).get_ref<const std::string&>();
+                                   first = false;
+                               }
+                           }};
+
+    switch (table)
     {
-        ret = data["os_name"];
-    }
-    else if (table == PACKAGES_TABLE)
-    {
-        ret = data["name"].get<std::string>() + ":" + data["version"].get<std::string>() + ":" +
-              data["architecture"].get<std::string>() + ":" + data["format"].get<std::string>() + ":" +
-              data["location"].get<std::string>();
-    }
-    else if (table == PROCESSES_TABLE)
-    {
-        ret = data["pid"];
-    }
-    else if (table == HOTFIXES_TABLE)
-    {
-        ret = data["hotfix"];
-    }
-    else if (table == PORTS_TABLE)
-    {
-        ret = std::to_string(data["inode"].get<int>()) + ":" + data["protocol"].get<std::string>() + ":" +
-              data["local_ip"].get<std::string>() + ":" + std::to_string(data["local_port"].get<int>());
-    }
-    else if (table == NETWORKS_TABLE)
-    {
-        ret = data["iface"].get<std::string>() + ":" + data["adapter"].get<std::string>() + ":" +
-              data["iface_type"].get<std::string>() + ":" + data["proto_type"].get<std::string>() + ":" +
-              data["address"].get<std::string>();
+        case InventoryTable::Hardware: addColumns({"board_serial"}); break;
+        case InventoryTable::System: addColumns({"os_name"}); break;
+        case InventoryTable::Packages: addColumns({"name", "version", "architecture", "format", "location"}); break;
+        case InventoryTable::Processes: addColumns({"pid"}); break;
+        case InventoryTable::Hotfixes: addColumns({"hotfix"}); break;
+        case InventoryTable::Ports:
+            ret = std::to_string(data.at("inode").get<int>()) + ":";
+            addColumns({"protocol", "local_ip"});
+            ret += ":" + std::to_string(data.at("local_port").get<int>());
+            break;
+        case InventoryTable::Networks:
+            addColumns({"iface", "adapter", "iface_type", "proto_type", "address"});
+            break;
     }
+
     return ret;
 }
 
-std::string Inventory::CalculateHashId(const nlohmann::json& data, const std::string& table)
+std::string Inventory::CalculateHashId(const nlohmann::json& data, const InventoryTable table) const
 {
-    const std::string primaryKey = GetPrimaryKeys(data, table);
-    const std::string baseId = AgentUUID() + ":" + primaryKey;
-
-    Utils::HashData hash(Utils::HashType::Sha1);
-    hash.update(baseId.c_str(), baseId.size());
+    // The "<agent UUID>:" prefix is the same for every id, hashing resumes from the state it leaves.
+    Utils::HashData hash {m_idPrefixHash};
+    const auto primaryKey {GetPrimaryKeys(data, table)};
+    hash.update(primaryKey.c_str(), primaryKey.size());
 
     return Utils::asciiToHex(hash.hash());
 }
@@ -286,71 +551,120 @@ void Inventory::NotifyChange(ReturnTypeCallback result,
         return;
     }
 
+    const auto itTable {TABLE_MAP.find(table)};
+
+    if (itTable == TABLE_MAP.end())
+    {
+        LogErrorInventory("Unknown table: " + table);
+        return;
+    }
+
+    const auto inventoryTable {itTable->second};
+
     if (data.is_array())
     {
         for (const auto& item : data)
         {
-            ProcessEvent(result, item, table, isFirstScan);
+            ProcessEvent(result, item, inventoryTable, isFirstScan);
         }
     }
     else
     {
-        ProcessEvent(result, data, table, isFirstScan);
+        ProcessEvent(result, data, inventoryTable, isFirstScan);
     }
 }
 
 void Inventory::ProcessEvent(ReturnTypeCallback result,
                              const nlohmann::json& item,
-                             const std::string& table,
+                             const InventoryTable table,
                              const bool isFirstScan)
 {
-    nlohmann::json msg = GenerateMessage(result, item, table);
+    const auto& data {result == MODIFIED ? item.at("new") : item};
+    const auto id {CalculateHashId(data, table)};
 
-    if (msg["metadata"]["id"].is_string() && msg["metadata"]["id"].get<std::string>().size() <= MAX_ID_SIZE)
+    if (id.size() > MAX_ID_SIZE)
     {
-        NotifyEvent(result, msg, item, table, isFirstScan);
+        LogWarn("Event discarded for exceeding maximum size allowed in id field.");
+        LogTrace("Event discarded: {}", data.dump());
+        return;
+    }
+
+    if (isFirstScan)
+    {
+        // Without a previous state there is no stateless event, so the message is written without building it
+        m_reportDiffFunction(SerializeMessage(result, data, table, id));
     }
     else
     {
-        LogWarn("Event discarded for exceeding maximum size allowed in id field.");
-        LogTrace("Event discarded: {}", msg.dump());
+        auto msg = GenerateMessage(result, data, table, id);
+        NotifyEvent(result, msg, item, table);
     }
 }
 
-nlohmann::json
-Inventory::GenerateMessage(ReturnTypeCallback result, const nlohmann::json& item, const std::string& table)
+nlohmann::json Inventory::GenerateMessage(ReturnTypeCallback result,
+                                          const nlohmann::json& data,
+                                          const InventoryTable table,
+                                          const std::string& id)
 {
     nlohmann::json msg {
-        {"metadata", {{"collector", table}, {"operation", OPERATION_MAP.at(result)}, {"module", Name()}}}};
+        {"metadata",
+         {{"collector", TableName(table)}, {"operation", OPERATION_MAP.at(result)}, {"module", Name()}, {"id", id}}}};
 
-    msg["metadata"]["id"] = CalculateHashId(result == MODIFIED ? item["new"] : item, table);
-    msg["data"] = EcsData(result == MODIFIED ? item["new"] : item, table);
+    EcsData(msg["data"], data, table);
 
     return msg;
 }
 
+std::string Inventory::SerializeMessage(ReturnTypeCallback result,
+                                        const nlohmann::json& data,
+                                        const InventoryTable table,
+                                        const std::string& id) const
+{
+    // Same document as GenerateMessage plus the scan time, with the keys in the order nlohmann::json dumps them.
+    // Apart from the ECS values every string is generated by the module and doesn't need escaping.
+    std::string output;
+    output.reserve(SERIALIZED_MESSAGE_RESERVE);
+
+    output += R"({"data":{"@timestamp":")";
+    output += m_scanTime;
+    output += R"(",)";
+    WriteEcsMembers(output, EcsLayout(table), data);
+    output += R"(},"metadata":{"collector":")";
+    output += TableName(table);
+    output += R"(","id":")";
+    output += id;
+    output += R"(","module":")";
+    output += Name();
+    output += R"(","operation":")";
+    output += OPERATION_MAP.at(result);
+    output += R"("}})";
+
+    return output;
+}
+
 void Inventory::NotifyEvent(ReturnTypeCallback result,
                             nlohmann::json& msg,
                             const nlohmann::json& item,
-                            const std::string& table,
-                            const bool isFirstScan)
+                            const InventoryTable table)
 {
-    if (!isFirstScan)
+    nlohmann::json oldData;
+
+    if (result == MODIFIED)
     {
-        const nlohmann::json oldData = (result == MODIFIED) ? EcsData(item["old"], table, false) : nlohmann::json {};
+        EcsData(oldData, item.at("old"), table, false);
+    }
 
-        nlohmann::json stateless = GenerateStatelessEvent(OPERATION_MAP.at(result), table, msg["data"]);
-        nlohmann::json eventWithChanges = msg["data"];
+    nlohmann::json stateless = GenerateStatelessEvent(OPERATION_MAP.at(result), TableName(table), msg["data"]);
+    nlohmann::json eventWithChanges = msg["data"];
 
-        if (!oldData.empty())
-        {
-            stateless["event"]["changed_fields"] = AddPreviousFields(eventWithChanges, oldData);
-        }
-
-        stateless.update(eventWithChanges);
-        msg["stateless"] = stateless;
+    if (!oldData.empty())
+    {
+        stateless["event"]["changed_fields"] = AddPreviousFields(eventWithChanges, oldData);
     }
 
+    stateless.update(eventWithChanges);
+    msg["stateless"] = stateless;
+
     msg["data"]["@timestamp"] = m_scanTime;
 
     const auto msgToSend = msg.dump();
@@ -364,7 +678,6 @@ void Inventory::UpdateChanges(const std::string& table, const nlohmann::json& va
                              NotifyChange(result, data, table, isFirstScan);
                          }};
 
-    const std::unique_lock<std::mutex> lock {m_mutex};
     DBSyncTxn txn {m_spDBSync->handle(), nlohmann::json {table}, 0, QUEUE_SIZE, callback};
     nlohmann::json input;
     input["table"] = table;
@@ -409,6 +722,9 @@ Inventory::Inventory()
     , m_portsAll {true}
     , m_processes {true}
     , m_hotfixes {true}
+    , m_threadCount {config::inventory::DEFAULT_THREAD_COUNT}
+    , m_processEvents {config::inventory::DEFAULT_PROCESS_EVENTS}
+    , m_networkEvents {config::inventory::DEFAULT_NETWORK_EVENTS}
     , m_stopping {true}
     , m_notify {true}
     , m_hardwareFirstScan {true}
@@ -419,6 +735,8 @@ Inventory::Inventory()
     , m_processesFirstScan {true}
     , m_hotfixesFirstScan {true}
 {
+    // Ids hashed before the agent UUID is known keep the ":" separator
+    SetAgentUUID(m_agentUUID);
 }
 
 std::string Inventory::GetCreateStatement() const
@@ -460,6 +778,7 @@ void Inventory::Init(const std::shared_ptr<ISysInfo>& spInfo,
     m_portsFirstScan = ReadMetadata(TABLE_TO_KEY_MAP.at(PORTS_TABLE)).empty() ? false : true;
     m_processesFirstScan = ReadMetadata(TABLE_TO_KEY_MAP.at(PROCESSES_TABLE)).empty() ? false : true;
     m_hotfixesFirstScan = ReadMetadata(TABLE_TO_KEY_MAP.at(HOTFIXES_TABLE)).empty() ? false : true;
+    m_packagesFingerprint = nlohmann::json {};
 
     if (m_hardwareFirstScan && !m_hardware)
     {
@@ -512,167 +831,35 @@ void Inventory::Destroy()
     m_cv.notify_all();
 }
 
-nlohmann::json Inventory::EcsHardwareData(const nlohmann::json& originalData, bool createFields)
-{
-    nlohmann::json ret;
-
-    SetJsonField(ret, originalData, "/observer/serial_number", "board_serial", std::nullopt, createFields);
-    SetJsonField(ret, originalData, "/host/cpu/name", "cpu_name", std::nullopt, createFields);
-    SetJsonField(ret, originalData, "/host/cpu/cores", "cpu_cores", std::nullopt, createFields);
-    SetJsonField(ret, originalData, "/host/cpu/speed", "cpu_mhz", std::nullopt, createFields);
-    SetJsonField(ret, originalData, "/host/memory/total", "ram_total", std::nullopt, createFields);
-    SetJsonField(ret, originalData, "/host/memory/free", "ram_free", std::nullopt, createFields);
-    SetJsonField(ret, originalData, "/host/memory/used/percentage", "ram_usage", std::nullopt, createFields);
-
-    return ret;
-}
-
-nlohmann::json Inventory::EcsSystemData(const nlohmann::json& originalData, bool createFields)
-{
-    nlohmann::json ret;
-
-    SetJsonField(ret, originalData, "/host/architecture", "architecture", std::nullopt, createFields);
-    SetJsonField(ret, originalData, "/host/hostname", "hostname", std::nullopt, createFields);
-    SetJsonField(ret, originalData, "/host/os/kernel", "os_build", std::nullopt, createFields);
-    SetJsonField(ret, originalData, "/host/os/full", "os_codename", std::nullopt, createFields);
-    SetJsonField(ret, originalData, "/host/os/name", "os_name", std::nullopt, createFields);
-    SetJsonField(ret, originalData, "/host/os/platform", "os_platform", std::nullopt, createFields);
-    SetJsonField(ret, originalData, "/host/os/version", "os_version", std::nullopt, createFields);
-    SetJsonField(ret, originalData, "/host/os/type", "sysname", std::nullopt, createFields);
-
-    return ret;
-}
-
-nlohmann::json Inventory::EcsPackageData(const nlohmann::json& originalData, bool createFields)
-{
-    nlohmann::json ret;
-
-    SetJsonField(ret, originalData, "/package/architecture", "architecture", std::nullopt, createFields);
-    SetJsonField(ret, originalData, "/package/description", "description", std::nullopt, createFields);
-    SetJsonField(ret, originalData, "/package/installed", "install_time", std::nullopt, createFields);
-    SetJsonField(ret, originalData, "/package/name", "name", std::nullopt, createFields);
-    SetJsonField(ret, originalData, "/package/path", "location", std::nullopt, createFields);
-    SetJsonField(ret, originalData, "/package/size", "size", std::nullopt, createFields);
-    SetJsonField(ret, originalData, "/package/type", "format", std::nullopt, createFields);
-    SetJsonField(ret, originalData, "/package/version", "version", std::nullopt, createFields);
-
-    return ret;
-}
-
-nlohmann::json Inventory::EcsProcessesData(const nlohmann::json& originalData, bool createFields)
-{
-    nlohmann::json ret;
-
-    SetJsonField(ret, originalData, "/process/pid", "pid", std::nullopt, createFields);
-    SetJsonField(ret, originalData, "/process/name", "name", std::nullopt, createFields);
-    SetJsonField(ret, originalData, "/process/parent/pid", "ppid", std::nullopt, createFields);
-    SetJsonField(ret, originalData, "/process/command_line", "cmd", std::nullopt, createFields);
-    SetJsonField(ret, originalData, "/process/args", "argvs", std::nullopt, createFields);
-    SetJsonField(ret, originalData, "/process/user/id", "euser", std::nullopt, createFields);
-    SetJsonField(ret, originalData, "/process/real_user/id", "ruser", std::nullopt, createFields);
-    SetJsonField(ret, originalData, "/process/saved_user/id", "suser", std::nullopt, createFields);
-    SetJsonField(ret, originalData, "/process/group/id", "egroup", std::nullopt, createFields);
-    SetJsonField(ret, originalData, "/process/real_group/id", "rgroup", std::nullopt, createFields);
-    SetJsonField(ret, originalData, "/process/saved_group/id", "sgroup", std::nullopt, createFields);
-    SetJsonField(ret, originalData, "/process/start", "start_time", std::nullopt, createFields);
-    SetJsonField(ret, originalData, "/process/thread/id", "tgid", std::nullopt, createFields);
-    SetJsonField(ret, originalData, "/process/tty/char_device/major", "tty", std::nullopt, createFields);
-
-    return ret;
-}
-
-nlohmann::json Inventory::EcsHotfixesData(const nlohmann::json& originalData, bool createFields)
+void Inventory::SyncTable(const std::string& table, const nlohmann::json& rows, bool& firstScanDone)
 {
+    UpdateChanges(table, rows, !firstScanDone);
 
-    nlohmann::json ret;
-
-    SetJsonField(ret, originalData, "/package/hotfix/name", "hotfix", std::nullopt, createFields);
-
-    return ret;
-}
-
-nlohmann::json Inventory::EcsPortData(const nlohmann::json& originalData, bool createFields)
-{
-    nlohmann::json ret;
-
-    SetJsonField(ret, originalData, "/network/protocol", "protocol", std::nullopt, createFields);
-    SetJsonFieldArray(ret, originalData, "/source/ip", "local_ip", createFields);
-    SetJsonField(ret, originalData, "/source/port", "local_port", std::nullopt, createFields);
-    SetJsonFieldArray(ret, originalData, "/destination/ip", "remote_ip", createFields);
-    SetJsonField(ret, originalData, "/destination/port", "remote_port", std::nullopt, createFields);
-    SetJsonField(ret, originalData, "/host/network/egress/queue", "tx_queue", std::nullopt, createFields);
-    SetJsonField(ret, originalData, "/host/network/ingress/queue", "rx_queue", std::nullopt, createFields);
-    SetJsonField(ret, originalData, "/file/inode", "inode", std::nullopt, createFields);
-    SetJsonField(ret, originalData, "/interface/state", "state", std::nullopt, createFields);
-    SetJsonField(ret, originalData, "/process/pid", "pid", std::nullopt, createFields);
-    SetJsonField(ret, originalData, "/process/name", "process", std::nullopt, createFields);
-
-    return ret;
+    if (!firstScanDone && !m_stopping)
+    {
+        WriteMetadata(TABLE_TO_KEY_MAP.at(table), Utils::getCurrentISO8601());
+        firstScanDone = true;
+    }
 }
 
-nlohmann::json Inventory::EcsNetworkData(const nlohmann::json& originalData, bool createFields)
+std::function<void()> Inventory::CollectHardware()
 {
-    nlohmann::json ret;
-
-    SetJsonFieldArray(ret, originalData, "/host/ip", "address", createFields);
-    SetJsonField(ret, originalData, "/host/mac", "mac", std::nullopt, createFields);
-    SetJsonField(ret, originalData, "/host/network/egress/bytes", "tx_bytes", std::nullopt, createFields);
-    SetJsonField(ret, originalData, "/host/network/egress/packets", "tx_packets", std::nullopt, createFields);
-    SetJsonField(ret, originalData, "/host/network/ingress/bytes", "rx_bytes", std::nullopt, createFields);
-    SetJsonField(ret, originalData, "/host/network/ingress/packets", "rx_packets", std::nullopt, createFields);
-    SetJsonField(ret, originalData, "/host/network/egress/drops", "tx_dropped", std::nullopt, createFields);
-    SetJsonField(ret, originalData, "/host/network/egress/errors", "tx_errors", std::nullopt, createFields);
-    SetJsonField(ret, originalData, "/host/network/ingress/drops", "rx_dropped", std::nullopt, createFields);
-    SetJsonField(ret, originalData, "/host/network/ingress/errors", "rx_errors", std::nullopt, createFields);
-    SetJsonField(ret, originalData, "/interface/mtu", "mtu", std::nullopt, createFields);
-    SetJsonField(ret, originalData, "/interface/state", "state", std::nullopt, createFields);
-    SetJsonField(ret, originalData, "/interface/type", "iface_type", std::nullopt, createFields);
-    SetJsonFieldArray(ret, originalData, "/network/netmask", "netmask", createFields);
-    SetJsonFieldArray(ret, originalData, "/network/gateway", "gateway", createFields);
-    SetJsonFieldArray(ret, originalData, "/network/broadcast", "broadcast", createFields);
-    SetJsonField(ret, originalData, "/network/dhcp", "dhcp", std::nullopt, createFields);
-    SetJsonField(ret, originalData, "/network/type", "proto_type", std::nullopt, createFields);
-    SetJsonField(ret, originalData, "/network/metric", "metric", std::nullopt, createFields);
-    SetJsonField(ret, originalData, "/observer/ingress/interface/alias", "adapter", std::nullopt, createFields);
-    SetJsonField(ret, originalData, "/observer/ingress/interface/name", "iface", std::nullopt, createFields);
+    LogTrace("Starting hardware scan");
+    nlohmann::json hwData;
+    hwData[0] = m_spInfo->hardware();
+    LogTrace("Ending hardware scan");
 
-    return ret;
+    return [this, hwData = std::move(hwData)]() { SyncTable(HARDWARE_TABLE, hwData, m_hardwareFirstScan); };
 }
 
-void Inventory::ScanHardware()
+std::function<void()> Inventory::CollectSystem()
 {
-    if (m_hardware)
-    {
-        LogTrace("Starting hardware scan");
-        nlohmann::json hwData;
-        hwData[0] = m_spInfo->hardware();
-        UpdateChanges(HARDWARE_TABLE, hwData, !m_hardwareFirstScan);
-        LogTrace("Ending hardware scan");
+    LogTrace("Starting os scan");
+    nlohmann::json systemData;
+    systemData[0] = m_spInfo->os();
+    LogTrace("Ending os scan");
 
-        if (!m_hardwareFirstScan && !m_stopping)
-        {
-            WriteMetadata(TABLE_TO_KEY_MAP.at(HARDWARE_TABLE), Utils::getCurrentISO8601());
-            m_hardwareFirstScan = true;
-        }
-    }
-}
-
-void Inventory::ScanSystem()
-{
-    if (m_system)
-    {
-        LogTrace("Starting os scan");
-        nlohmann::json SystemData;
-        SystemData[0] = m_spInfo->os();
-        UpdateChanges(SYSTEM_TABLE, SystemData, !m_systemFirstScan);
-        LogTrace("Ending os scan");
-
-        if (!m_systemFirstScan && !m_stopping)
-        {
-            WriteMetadata(TABLE_TO_KEY_MAP.at(SYSTEM_TABLE), Utils::getCurrentISO8601());
-            m_systemFirstScan = true;
-        }
-    }
+    return [this, systemData = std::move(systemData)]() { SyncTable(SYSTEM_TABLE, systemData, m_systemFirstScan); };
 }
 
 nlohmann::json Inventory::GetNetworkData()
@@ -750,88 +937,65 @@ nlohmann::json Inventory::GetNetworkData()
     return ret;
 }
 
-void Inventory::ScanNetwork()
+std::function<void()> Inventory::CollectNetwork()
 {
-    if (m_networks)
-    {
-        LogTrace("Starting network scan");
-        const auto networkData(GetNetworkData());
-
-        if (!networkData.is_null())
-        {
-            const auto itNet {networkData.find(NETWORKS_TABLE)};
+    LogTrace("Starting network scan");
+    auto networkData = GetNetworkData();
+    LogTrace("Ending network scan");
 
-            if (itNet != networkData.end())
-            {
-                UpdateChanges(NETWORKS_TABLE, itNet.value(), !m_networksFirstScan);
-            }
-        }
-
-        if (!m_networksFirstScan && !m_stopping)
-        {
-            WriteMetadata(TABLE_TO_KEY_MAP.at(NETWORKS_TABLE), Utils::getCurrentISO8601());
-            m_networksFirstScan = true;
-        }
-
-        LogTrace("Ending network scan");
-    }
+    return [this, networkData = std::move(networkData)]()
+    { SyncTable(NETWORKS_TABLE, networkData.at(NETWORKS_TABLE), m_networksFirstScan); };
 }
 
-void Inventory::ScanPackages()
+std::function<void()> Inventory::CollectPackages()
 {
-    if (m_packages)
+    // Package databases that haven't changed since the last complete scan hold the same packages
+    auto fingerprint = m_spInfo->packagesFingerprint();
+    if (m_packagesFirstScan && !fingerprint.empty() && fingerprint == m_packagesFingerprint)
     {
-        LogTrace("Starting packages scan");
-        const auto callback {[this](ReturnTypeCallback result, const nlohmann::json& data)
-                             {
-                                 NotifyChange(result, data, PACKAGES_TABLE, !m_packagesFirstScan);
-                             }};
+        LogTrace("Package sources unchanged, skipping packages scan");
+        return {};
+    }
 
-        const std::unique_lock<std::mutex> lock {m_mutex};
-        DBSyncTxn txn {m_spDBSync->handle(), nlohmann::json {PACKAGES_TABLE}, 0, QUEUE_SIZE, callback};
-        m_spInfo->packages(
-            [this, &txn](nlohmann::json& rawData)
+    LogTrace("Starting packages scan");
+    auto packages = nlohmann::json::array();
+    m_spInfo->packages(
+        [this, &packages](nlohmann::json& rawData)
+        {
+            if (m_stopping)
             {
-                if (m_stopping)
-                {
-                    return;
-                }
+                return;
+            }
 
-                nlohmann::json input;
+            m_spNormalizer->Normalize("packages", rawData);
+            m_spNormalizer->RemoveExcluded("packages", rawData);
 
-                input["table"] = PACKAGES_TABLE;
-                m_spNormalizer->Normalize("packages", rawData);
-                m_spNormalizer->RemoveExcluded("packages", rawData);
+            if (!rawData.empty())
+            {
+                packages.push_back(std::move(rawData));
+            }
+        });
+    LogTrace("Ending packages scan");
 
-                if (!rawData.empty())
-                {
-                    input["data"] = nlohmann::json::array({rawData});
-                    if (m_packagesFirstScan)
-                    {
-                        input["options"]["return_old_data"] = true;
-                    }
-                    txn.syncTxnRow(input);
-                }
-            });
-        txn.getDeletedRows(callback);
+    return [this, packages = std::move(packages), fingerprint = std::move(fingerprint)]()
+    {
+        SyncTable(PACKAGES_TABLE, packages, m_packagesFirstScan);
 
-        if (!m_packagesFirstScan && !m_stopping)
+        if (!m_stopping)
         {
-            WriteMetadata(TABLE_TO_KEY_MAP.at(PACKAGES_TABLE), Utils::getCurrentISO8601());
-            m_packagesFirstScan = true;
+            m_packagesFingerprint = fingerprint;
         }
-
-        LogTrace("Ending packages scan");
-    }
+    };
 }
 
-void Inventory::ScanHotfixes()
+std::function<void()> Inventory::CollectHotfixes()
 {
-    if (m_hotfixes)
-    {
-        LogTrace("Starting hotfixes scan");
-        auto hotfixes = m_spInfo->hotfixes();
+    LogTrace("Starting hotfixes scan");
+    auto hotfixes = m_spInfo->hotfixes();
+    LogTrace("Ending hotfixes scan");
 
+    return [this, hotfixes = std::move(hotfixes)]()
+    {
         if (!hotfixes.is_null())
         {
             UpdateChanges(HOTFIXES_TABLE, hotfixes, !m_hotfixesFirstScan);
@@ -842,9 +1006,7 @@ void Inventory::ScanHotfixes()
             WriteMetadata(TABLE_TO_KEY_MAP.at(HOTFIXES_TABLE), Utils::getCurrentISO8601());
             m_hotfixesFirstScan = true;
         }
-
-        LogTrace("Ending hotfixes scan");
-    }
+    };
 }
 
 nlohmann::json Inventory::GetPortsData()
@@ -857,150 +1019,374 @@ nlohmann::json Inventory::GetPortsData()
 
     if (!data.is_null())
     {
-        for (auto& item : data)
+        // Keys point into data, which isn't modified until every socket has been checked.
+        std::unordered_set<PortKey, PortKeyHash> seen;
+        std::vector<size_t> selected;
+        seen.reserve(data.size());
+        selected.reserve(data.size());
+
+        for (size_t i = 0; i < data.size(); ++i)
         {
-            const auto protocol {item.at("protocol").get_ref<const std::string&>()};
+            const auto& item {data[i]};
+            const auto& protocol {item.at("protocol").get_ref<const std::string&>()};
+            auto keep {false};
 
             if (Utils::startsWith(protocol, TCP_PROTOCOL))
             {
-                // All ports.
-                if (m_portsAll)
-                {
-                    const auto& itemId {GetItemId(item, PORTS_ITEM_ID_FIELDS)};
-
-                    if (!IsElementDuplicated(ret, std::make_pair("item_id", itemId)))
-                    {
-                        item["item_id"] = itemId;
-                        ret.push_back(item);
-                    }
-                }
-                else
-                {
-                    // Only listening ports.
-                    const auto isListeningState {item.at("state") == PORT_LISTENING_STATE};
-
-                    if (isListeningState)
-                    {
-                        const auto& itemId {GetItemId(item, PORTS_ITEM_ID_FIELDS)};
-
-                        if (!IsElementDuplicated(ret, std::make_pair("item_id", itemId)))
-                        {
-                            item["item_id"] = itemId;
-                            ret.push_back(item);
-                        }
-                    }
-                }
+                // All ports, or only listening ports.
+                keep = m_portsAll || item.at("state") == PORT_LISTENING_STATE;
             }
             else if (Utils::startsWith(protocol, UDP_PROTOCOL))
             {
-                const auto& itemId {GetItemId(item, PORTS_ITEM_ID_FIELDS)};
+                keep = true;
+            }
+
+            if (!keep)
+            {
+                continue;
+            }
 
-                if (!IsElementDuplicated(ret, std::make_pair("item_id", itemId)))
-                {
-                    item["item_id"] = itemId;
-                    ret.push_back(item);
-                }
+            const PortKey key {PortKeyNumber(item.at("inode")),
+                               PortKeyNumber(item.at("local_port")),
+                               protocol,
+                               PortKeyString(item.at("local_ip"))};
+
+            // The same socket is reported once per process holding it, only the first one is kept.
+            if (seen.insert(key).second)
+            {
+                selected.push_back(i);
             }
         }
+
+        for (const auto i : selected)
+        {
+            ret.push_back(std::move(data[i]));
+        }
     }
 
     return ret;
 }
 
-void Inventory::ScanPorts()
+std::function<void()> Inventory::CollectPorts()
 {
-    if (m_ports)
-    {
-        LogTrace("Starting ports scan");
-        const auto& portsData {GetPortsData()};
-        UpdateChanges(PORTS_TABLE, portsData, !m_portsFirstScan);
-        LogTrace("Ending ports scan");
+    LogTrace("Starting ports scan");
+    auto portsData = GetPortsData();
+    LogTrace("Ending ports scan");
 
-        if (!m_portsFirstScan && !m_stopping)
+    return [this, portsData = std::move(portsData)]() { SyncTable(PORTS_TABLE, portsData, m_portsFirstScan); };
+}
+
+std::function<void()> Inventory::CollectProcesses()
+{
+    LogTrace("Starting processes scan");
+    auto processes = nlohmann::json::array();
+    m_spInfo->processes(std::function<void(nlohmann::json&)>(
+        [this, &processes](nlohmann::json& rawData)
         {
-            WriteMetadata(TABLE_TO_KEY_MAP.at(PORTS_TABLE), Utils::getCurrentISO8601());
-            m_portsFirstScan = true;
-        }
-    }
+            if (m_stopping)
+            {
+                return;
+            }
+
+            processes.push_back(std::move(rawData));
+        }));
+    LogTrace("Ending processes scan");
+
+    return [this, processes = std::move(processes)]() { SyncTable(PROCESSES_TABLE, processes, m_processesFirstScan); };
 }
 
-void Inventory::ScanProcesses()
+void Inventory::Scan()
 {
+    LogInfo("Starting evaluation.");
+    m_scanTime = Utils::getCurrentISO8601();
+    const auto scanStart = std::chrono::steady_clock::now();
+
+    // Collectors only read the system, so they run concurrently on the workers. DBSync doesn't serialize writes
+    // through the same handle, so the rows they return are synced on this thread, one table at a time, in the
+    // order the collectors finish. The slowest collectors are listed first so they are picked up first.
+    std::vector<std::pair<std::string, std::function<std::function<void()>()>>> collectors;
+    if (m_packages)
+    {
+        collectors.emplace_back("packages", [this]() { return CollectPackages(); });
+    }
     if (m_processes)
     {
-        LogTrace("Starting processes scan");
-        const auto callback {[this](ReturnTypeCallback result, const nlohmann::json& data)
-                             {
-                                 NotifyChange(result, data, PROCESSES_TABLE, !m_processesFirstScan);
-                             }};
-        const std::unique_lock<std::mutex> lock {m_mutex};
-        DBSyncTxn txn {m_spDBSync->handle(), nlohmann::json {PROCESSES_TABLE}, 0, QUEUE_SIZE, callback};
-        m_spInfo->processes(std::function<void(nlohmann::json&)>(
-            [this, &txn](nlohmann::json& rawData)
-            {
-                if (m_stopping)
-                {
-                    return;
-                }
+        collectors.emplace_back("processes", [this]() { return CollectProcesses(); });
+    }
+    if (m_ports)
+    {
+        collectors.emplace_back("ports", [this]() { return CollectPorts(); });
+    }
+    if (m_networks)
+    {
+        collectors.emplace_back("networks", [this]() { return CollectNetwork(); });
+    }
+    if (m_hotfixes)
+    {
+        collectors.emplace_back("hotfixes", [this]() { return CollectHotfixes(); });
+    }
+    if (m_hardware)
+    {
+        collectors.emplace_back("hardware", [this]() { return CollectHardware(); });
+    }
+    if (m_system)
+    {
+        collectors.emplace_back("system", [this]() { return CollectSystem(); });
+    }
 
-                nlohmann::json input;
-                input["table"] = PROCESSES_TABLE;
-                input["data"] = nlohmann::json::array({rawData});
+    std::vector<std::chrono::milliseconds> durations(collectors.size());
+    std::atomic<size_t> nextCollector {0};
+    std::mutex collectedMutex;
+    std::condition_variable collectedCv;
+    std::deque<std::pair<size_t, std::function<void()>>> collected;
 
-                if (m_processesFirstScan)
-                {
-                    input["options"]["return_old_data"] = true;
-                }
+    const auto worker = [&]()
+    {
+        for (auto index = nextCollector++; index < collectors.size(); index = nextCollector++)
+        {
+            const auto start = std::chrono::steady_clock::now();
+            std::function<void()> sync;
+            TryCatchTask([&]() { sync = collectors[index].second(); });
+            durations[index] =
+                std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+            LogDebug("Collector {} read in {} ms.", collectors[index].first, durations[index].count());
 
-                txn.syncTxnRow(input);
-            }));
-        txn.getDeletedRows(callback);
+            {
+                const std::lock_guard<std::mutex> lock {collectedMutex};
+                collected.emplace_back(index, std::move(sync));
+            }
+            collectedCv.notify_one();
+        }
+    };
 
-        if (!m_processesFirstScan && !m_stopping)
+    std::vector<std::thread> workers;
+    const auto threadCount = std::min(std::max<size_t>(m_threadCount, 1), collectors.size());
+    for (size_t i = 0; i < threadCount; ++i)
+    {
+        workers.emplace_back(worker);
+    }
+
+    for (size_t synced = 0; synced < collectors.size(); ++synced)
+    {
+        std::pair<size_t, std::function<void()>> next;
         {
-            WriteMetadata(TABLE_TO_KEY_MAP.at(PROCESSES_TABLE), Utils::getCurrentISO8601());
-            m_processesFirstScan = true;
+            std::unique_lock<std::mutex> lock {collectedMutex};
+            collectedCv.wait(lock, [&collected]() { return !collected.empty(); });
+            next = std::move(collected.front());
+            collected.pop_front();
         }
 
-        LogTrace("Ending processes scan");
+        // A collector interrupted by Stop() returns part of its rows, syncing them would report the rest as deleted
+        if (next.second && !m_stopping)
+        {
+            const auto start = std::chrono::steady_clock::now();
+            TryCatchTask(next.second);
+            durations[next.first] +=
+                std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+        }
     }
+
+    for (auto& thread : workers)
+    {
+        thread.join();
+    }
+
+    std::string timings;
+    for (size_t i = 0; i < collectors.size(); ++i)
+    {
+        timings += (timings.empty() ? "" : ", ") + collectors[i].first + ": " + std::to_string(durations[i].count()) +
+                   " ms";
+    }
+
+    m_notify = true;
+    LogInfo("Evaluation finished in {} ms ({}).",
+            std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - scanStart).count(),
+            timings);
 }
 
-void Inventory::Scan()
+void Inventory::ListenProcessEvents()
 {
-    LogInfo("Starting evaluation.");
+    TryCatchTask(
+        [this]()
+        {
+            const auto listening = m_spInfo->processEvents(
+                [this](ProcessEventType type, nlohmann::json& data)
+                {
+                    {
+                        const std::lock_guard<std::mutex> lock {m_mutex};
+                        if (m_pendingProcessEvents.size() >= MAX_PENDING_PROCESS_EVENTS)
+                        {
+                            LogTrace("Process event discarded, too many pending events.");
+                            return;
+                        }
+                        m_pendingProcessEvents.emplace_back(type, std::move(data));
+                    }
+                    m_cv.notify_all();
+                },
+                [this]() { return m_stopping.load(); });
+
+            if (!listening)
+            {
+                LogWarn("Process events are not available, processes will only be updated by the scan.");
+            }
+        });
+}
+
+void Inventory::ApplyProcessEvents(const std::deque<std::pair<ProcessEventType, nlohmann::json>>& events)
+{
+    // Until the first processes scan completes the table is partial, and that scan reports every process anyway.
+    if (!m_processesFirstScan)
+    {
+        return;
+    }
+
+    // A fork is usually followed right away by the exec of the same process, only its latest state is stored.
+    std::vector<bool> superseded(events.size());
+    std::unordered_set<std::string> startedLater;
+    for (auto index = events.size(); index-- > 0;)
+    {
+        if (events[index].first == PROCESS_STARTED)
+        {
+            superseded[index] = !startedLater.insert(events[index].second.at("pid").get<std::string>()).second;
+        }
+    }
+
     m_scanTime = Utils::getCurrentISO8601();
+    const auto callback {[this](ReturnTypeCallback result, const nlohmann::json& data)
+                         {
+                             NotifyChange(result, data, PROCESSES_TABLE, false);
+                         }};
 
-    TryCatchTask([&]() { ScanHardware(); });
-    TryCatchTask([&]() { ScanSystem(); });
-    TryCatchTask([&]() { ScanPackages(); });
-    TryCatchTask([&]() { ScanProcesses(); });
-    TryCatchTask([&]() { ScanHotfixes(); });
-    TryCatchTask([&]() { ScanPorts(); });
-    TryCatchTask([&]() { ScanNetwork(); });
+    for (size_t index = 0; index < events.size() && !m_stopping; ++index)
+    {
+        const auto& [type, data] = events[index];
 
-    m_notify = true;
-    LogInfo("Evaluation finished.");
+        if (type == PROCESS_STARTED && !superseded[index])
+        {
+            nlohmann::json input;
+            input["table"] = PROCESSES_TABLE;
+            input["data"] = nlohmann::json::array({data});
+            input["options"]["return_old_data"] = true;
+            m_spDBSync->syncRow(input, callback);
+        }
+        else if (type == PROCESS_FINISHED)
+        {
+            const auto pid = data.at("pid").get<std::string>();
+            nlohmann::json row;
+            auto selectQuery = SelectQuery::builder()
+                                   .table(PROCESSES_TABLE)
+                                   .columnList({"*"})
+                                   .rowFilter("WHERE pid = '" + pid + "'")
+                                   .build();
+            m_spDBSync->selectRows(selectQuery.query(),
+                                   [&row](ReturnTypeCallback, const nlohmann::json& selected) { row = selected; });
+
+            if (!row.empty())
+            {
+                auto deleteQuery {
+                    DeleteQuery::builder().table(PROCESSES_TABLE).data({{"pid", pid}}).rowFilter("").build()};
+                m_spDBSync->deleteRows(deleteQuery.query());
+                NotifyChange(DELETED, row, PROCESSES_TABLE, false);
+            }
+        }
+    }
+}
+
+void Inventory::ListenNetworkEvents()
+{
+    TryCatchTask(
+        [this]()
+        {
+            const auto listening = m_spInfo->networkEvents(
+                [this]()
+                {
+                    {
+                        const std::lock_guard<std::mutex> lock {m_mutex};
+                        m_networksChanged = true;
+                    }
+                    m_cv.notify_all();
+                },
+                [this]() { return m_stopping.load(); });
+
+            if (!listening)
+            {
+                LogWarn("Network events are not available, networks will only be updated by the scan.");
+            }
+        });
 }
 
 void Inventory::SyncLoop()
 {
     LogInfo("Module started.");
 
+    // Process events are applied on this thread, between scans, so they never race with the processes scan.
+    std::thread processEventsThread;
+    if (m_processes && m_processEvents && !m_stopping)
+    {
+        processEventsThread = std::thread([this]() { ListenProcessEvents(); });
+    }
+
+    std::thread networkEventsThread;
+    if (m_networks && m_networkEvents && !m_stopping)
+    {
+        networkEventsThread = std::thread([this]() { ListenNetworkEvents(); });
+    }
+
     if (m_scanOnStart && !m_stopping)
     {
         Scan();
     }
 
+    auto nextScan = std::chrono::steady_clock::now() + std::chrono::milliseconds {m_intervalValue};
     while (!m_stopping)
     {
+        std::deque<std::pair<ProcessEventType, nlohmann::json>> events;
+        auto networksChanged {false};
         {
             std::unique_lock<std::mutex> lock {m_mutex};
-            m_cv.wait_for(lock, std::chrono::milliseconds {m_intervalValue}, [&]() { return m_stopping.load(); });
+            m_cv.wait_until(lock,
+                            nextScan,
+                            [&]()
+                            { return m_stopping.load() || !m_pendingProcessEvents.empty() || m_networksChanged; });
+            events.swap(m_pendingProcessEvents);
+            std::swap(networksChanged, m_networksChanged);
         }
-        Scan();
+
+        if (!events.empty())
+        {
+            TryCatchTask([this, &events]() { ApplyProcessEvents(events); });
+        }
+
+        const auto scanDue = m_stopping || std::chrono::steady_clock::now() >= nextScan;
+
+        // The periodic scan covers the change, and before the first network scan the table is still empty.
+        if (networksChanged && !scanDue && m_networksFirstScan)
+        {
+            LogDebug("Network change notified, rescanning networks.");
+            m_scanTime = Utils::getCurrentISO8601();
+            TryCatchTask([this]() { CollectNetwork()(); });
+        }
+
+        if (scanDue)
+        {
+            Scan();
+            nextScan = std::chrono::steady_clock::now() + std::chrono::milliseconds {m_intervalValue};
+        }
+    }
+
+    if (processEventsThread.joinable())
+    {
+        processEventsThread.join();
+    }
+
+    if (networkEventsThread.joinable())
+    {
+        networkEventsThread.join();
     }
+
     const std::unique_lock<std::mutex> lock {m_mutex};
+    m_pendingProcessEvents.clear();
+    m_networksChanged = false;
     m_spDBSync.reset(nullptr);
 }
 
@@ -1114,48 +1500,3 @@ Inventory::GenerateStatelessEvent(const std::string& operation, const std::strin
     auto event = CreateStatelessEvent(type, operation, m_scanTime, data);
     return event ? event->generate() : nlohmann::json {};
 }
-
-void Inventory::SetJsonField(nlohmann::json& target,
-                             const nlohmann::json& source,
-                             const std::string& keyPath,
-                             const std::string& jsonKey,
-                             const std::optional<std::string>& defaultValue,
-                             bool createFields)
-{
-    if (createFields || source.contains(jsonKey))
-    {
-        const nlohmann::json::json_pointer pointer(keyPath);
-        if (source.contains(jsonKey) && source[jsonKey] != EMPTY_VALUE)
-        {
-            target[pointer] = source[jsonKey];
-        }
-        else if (defaultValue.has_value())
-        {
-            target[pointer] = *defaultValue;
-        }
-        else
-        {
-            target[pointer] = nullptr;
-        }
-    }
-}
-
-void Inventory::SetJsonFieldArray(nlohmann::json& target,
-                                  const nlohmann::json& source,
-                                  const std::string& destPath,
-                                  const std::string& sourceKey,
-                                  bool createFields)
-{
-    if (createFields || source.contains(sourceKey))
-    {
-        const nlohmann::json::json_pointer destPointer(destPath);
-        target[destPointer.parent_pointer()][destPointer.back()] = nlohmann::json::array();
-        nlohmann::json& destArray = target[destPointer];
-
-        if (source.contains(sourceKey) && !source[sourceKey].empty() && !source[sourceKey].is_null() &&
-            source[sourceKey] != EMPTY_VALUE)
-        {
-            destArray.push_back(source[sourceKey]);
-        }
-    }
-}
@@ -2,10 +2,110 @@
 #include <inventoryNormalizer.hpp>
 #include <iostream>
 #include <regex>
+#include <string_view>
+
+namespace
+{
+    constexpr std::string_view ANY_TEXT {".*"};
+    constexpr std::string_view REGEX_SPECIAL_CHARACTERS {"\\^$.|?*+()[]{}"};
+
+    /// @brief Checks if a value holds a character that "." doesn't match
+    bool HasLineTerminator(const std::string& value)
+    {
+        return value.find_first_of("\r\n") != std::string::npos;
+    }
+} // namespace
+
+NormalizerPattern::NormalizerPattern(const std::string& pattern)
+    : m_regex {pattern, std::regex::ECMAScript | std::regex::optimize}
+{
+    std::string_view text {pattern};
+    const auto anyPrefix {text.starts_with(ANY_TEXT)};
+
+    if (anyPrefix)
+    {
+        text.remove_prefix(ANY_TEXT.size());
+    }
+
+    const auto anySuffix {text.ends_with(ANY_TEXT)};
+
+    if (anySuffix)
+    {
+        text.remove_suffix(ANY_TEXT.size());
+    }
+
+    // A single group around the text doesn't change what matches.
+    if (text.size() >= 2 && text.front() == '(' && text.back() == ')')
+    {
+        text = text.substr(1, text.size() - 2);
+    }
+
+    if (text.empty() || text.find_first_of(REGEX_SPECIAL_CHARACTERS) != std::string_view::npos)
+    {
+        return;
+    }
+
+    m_literal = text;
+
+    if (anyPrefix && anySuffix)
+    {
+        m_kind = Kind::Contains;
+    }
+    else if (anyPrefix)
+    {
+        m_kind = Kind::EndsWith;
+    }
+    else if (anySuffix)
+    {
+        m_kind = Kind::StartsWith;
+    }
+    else
+    {
+        m_kind = Kind::Equals;
+    }
+}
+
+bool NormalizerPattern::Matches(const std::string& value) const
+{
+    // ".*" stops at line terminators, values holding one are left to the regular expression.
+    if (m_kind == Kind::Regex || (m_kind != Kind::Equals && HasLineTerminator(value)))
+    {
+        return std::regex_match(value, m_regex);
+    }
+
+    switch (m_kind)
+    {
+        case Kind::Equals: return value == m_literal;
+        case Kind::StartsWith: return value.starts_with(m_literal);
+        case Kind::EndsWith: return value.ends_with(m_literal);
+        default: return value.find(m_literal) != std::string::npos;
+    }
+}
+
+std::string NormalizerPattern::Replace(const std::string& value, const std::string& format) const
+{
+    // Only a plain text without format specifiers can be replaced without the regular expression.
+    if (m_kind != Kind::Equals || format.find('$') != std::string::npos)
+    {
+        return std::regex_replace(value, m_regex, format);
+    }
+
+    std::string ret;
+    size_t start {0};
+
+    for (auto position {value.find(m_literal)}; position != std::string::npos;
+         position = value.find(m_literal, start))
+    {
+        ret.append(value, start, position - start).append(format);
+        start = position + m_literal.size();
+    }
+
+    return ret.append(value, start);
+}
 
 InvNormalizer::InvNormalizer(const std::string& configFile, const std::string& target)
-    : m_typeExclusions {GetTypeValues(configFile, target, "exclusions")}
-    , m_typeDictionary {GetTypeValues(configFile, target, "dictionary")}
+    : m_typeExclusions {CompileExclusions(GetTypeValues(configFile, target, "exclusions"))}
+    , m_typeDictionary {CompileDictionary(GetTypeValues(configFile, target, "dictionary"))}
 {
 }
 
@@ -15,30 +115,32 @@ void InvNormalizer::RemoveExcluded(const std::string& type, nlohmann::json& data
 
     if (exclusionsIt != m_typeExclusions.cend())
     {
-        for (const auto& exclusionItem : exclusionsIt->second)
+        for (const auto& exclusion : exclusionsIt->second)
         {
             try
             {
-                const std::regex pattern {exclusionItem["pattern"].get_ref<const std::string&>()};
-                const auto& fieldName {exclusionItem["field_name"].get_ref<const std::string&>()};
-
                 if (data.is_array())
                 {
-                    for (auto item {data.begin()}; item != data.end(); ++item)
+                    for (auto item {data.begin()}; item != data.end();)
                     {
-                        const auto fieldIt {item->find(fieldName)};
+                        const auto fieldIt {item->find(exclusion.fieldName)};
 
-                        if (fieldIt != item->end() && std::regex_match(fieldIt->get_ref<const std::string&>(), pattern))
+                        if (fieldIt != item->end() &&
+                            exclusion.pattern.Matches(fieldIt->get_ref<const std::string&>()))
                         {
-                            data.erase(item);
+                            item = data.erase(item);
+                        }
+                        else
+                        {
+                            ++item;
                         }
                     }
                 }
                 else
                 {
-                    const auto fieldIt {data.find(fieldName)};
+                    const auto fieldIt {data.find(exclusion.fieldName)};
 
-                    if (fieldIt != data.end() && std::regex_match(fieldIt->get_ref<const std::string&>(), pattern))
+                    if (fieldIt != data.end() && exclusion.pattern.Matches(fieldIt->get_ref<const std::string&>()))
                     {
                         data.clear();
                     }
@@ -58,52 +160,34 @@ void InvNormalizer::RemoveExcluded(const std::string& type, nlohmann::json& data
     }
 }
 
-static void NormalizeItem(const nlohmann::json& dictionary, nlohmann::json& item)
+void InvNormalizer::NormalizeItem(const std::vector<DictionaryRule>& dictionary, nlohmann::json& item)
 {
-    for (const auto& dictItem : dictionary)
+    for (const auto& rule : dictionary)
     {
-        const auto itFindPattern {dictItem.find("find_pattern")};
-        const auto itFindField {dictItem.find("find_field")};
-
-        if (itFindPattern != dictItem.end() && itFindField != dictItem.end())
+        if (rule.find)
         {
-            const auto fieldIt {item.find(itFindField->get_ref<const std::string&>())};
-            const std::regex pattern {itFindPattern->get_ref<const std::string&>()};
+            const auto fieldIt {item.find(rule.find->first)};
 
-            if (fieldIt == item.end() || !std::regex_match(fieldIt->get_ref<const std::string&>(), pattern))
+            if (fieldIt == item.end() || !rule.find->second.Matches(fieldIt->get_ref<const std::string&>()))
             {
                 // no field in the item or no matching, we continue
                 continue;
             }
         }
-        else if (itFindPattern != dictItem.end() || itFindField != dictItem.end())
-        {
-            // we won't evaluate an incomplete item.
-            continue;
-        }
 
-        const auto itReplacePattern {dictItem.find("replace_pattern")};
-        const auto itReplaceField {dictItem.find("replace_field")};
-        const auto itReplaceValue {dictItem.find("replace_value")};
-
-        if (itReplacePattern != dictItem.end() && itReplaceField != dictItem.end() && itReplaceValue != dictItem.end())
+        if (rule.replace)
         {
-            const std::regex pattern {itReplacePattern->get_ref<const std::string&>()};
-            const auto fieldIt {item.find(itReplaceField->get_ref<const std::string&>())};
+            const auto fieldIt {item.find(rule.replace->first)};
 
             if (fieldIt != item.end())
             {
-                *fieldIt = std::regex_replace(
-                    fieldIt->get_ref<const std::string&>(), pattern, itReplaceValue->get_ref<const std::string&>());
+                *fieldIt = rule.replace->second.Replace(fieldIt->get_ref<const std::string&>(), rule.replaceValue);
             }
         }
 
-        const auto itAddField {dictItem.find("add_field")};
-        const auto itAddValue {dictItem.find("add_value")};
-
-        if (itAddField != dictItem.end() && itAddValue != dictItem.end())
+        if (rule.add)
         {
-            item[itAddField->get_ref<const std::string&>()] = itAddValue->get_ref<const std::string&>();
+            item[rule.add->first] = rule.add->second;
         }
     }
 }
@@ -128,6 +212,92 @@ void InvNormalizer::Normalize(const std::string& type, nlohmann::json& data) con
     }
 }
 
+std::map<std::string, std::vector<InvNormalizer::Exclusion>>
+InvNormalizer::CompileExclusions(const std::map<std::string, nlohmann::json>& typeExclusions)
+{
+    std::map<std::string, std::vector<Exclusion>> ret;
+
+    for (const auto& [type, exclusions] : typeExclusions)
+    {
+        auto& compiled {ret[type]};
+
+        for (const auto& exclusionItem : exclusions)
+        {
+            try
+            {
+                compiled.push_back({exclusionItem.at("field_name").get<std::string>(),
+                                    NormalizerPattern {exclusionItem.at("pattern").get_ref<const std::string&>()}});
+            }
+            catch (const std::exception& ex)
+            {
+                std::cout << "Exception caught in CompileExclusions: " << ex.what() << '\n';
+            }
+        }
+    }
+
+    return ret;
+}
+
+std::map<std::string, std::vector<InvNormalizer::DictionaryRule>>
+InvNormalizer::CompileDictionary(const std::map<std::string, nlohmann::json>& typeDictionary)
+{
+    std::map<std::string, std::vector<DictionaryRule>> ret;
+
+    for (const auto& [type, dictionary] : typeDictionary)
+    {
+        auto& compiled {ret[type]};
+
+        for (const auto& dictItem : dictionary)
+        {
+            try
+            {
+                const auto itFindPattern {dictItem.find("find_pattern")};
+                const auto itFindField {dictItem.find("find_field")};
+                DictionaryRule rule;
+
+                if (itFindPattern != dictItem.end() && itFindField != dictItem.end())
+                {
+                    rule.find.emplace(itFindField->get<std::string>(),
+                                      NormalizerPattern {itFindPattern->get_ref<const std::string&>()});
+                }
+                else if (itFindPattern != dictItem.end() || itFindField != dictItem.end())
+                {
+                    // we won't evaluate an incomplete item.
+                    continue;
+                }
+
+                const auto itReplacePattern {dictItem.find("replace_pattern")};
+                const auto itReplaceField {dictItem.find("replace_field")};
+                const auto itReplaceValue {dictItem.find("replace_value")};
+
+                if (itReplacePattern != dictItem.end() && itReplaceField != dictItem.end() &&
+                    itReplaceValue != dictItem.end())
+                {
+                    rule.replace.emplace(itReplaceField->get<std::string>(),
+                                         NormalizerPattern {itReplacePattern->get_ref<const std::string&>()});
+                    rule.replaceValue = itReplaceValue->get<std::string>();
+                }
+
+                const auto itAddField {dictItem.find("add_field")};
+                const auto itAddValue {dictItem.find("add_value")};
+
+                if (itAddField != dictItem.end() && itAddValue != dictItem.end())
+                {
+                    rule.add.emplace(itAddField->get<std::string>(), itAddValue->get<std::string>());
+                }
+
+                compiled.push_back(std::move(rule));
+            }
+            catch (const std::exception& ex)
+            {
+                std::cout << "Exception caught in CompileDictionary: " << ex.what() << '\n';
+            }
+        }
+    }
+
+    return ret;
+}
+
 std::map<std::string, nlohmann::json>
 InvNormalizer::GetTypeValues(const std::string& configFile, const std::string& target, const std::string& type)
 {
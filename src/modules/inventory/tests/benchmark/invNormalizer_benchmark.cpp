@@ -0,0 +1,194 @@
+// Measures the cost per package of normalizing and filtering with the shipped
+// rules, compared with building every regular expression when it is applied.
+
+#include <inventoryNormalizer.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <regex>
+#include <string>
+#include <vector>
+
+namespace
+{
+    constexpr size_t PACKAGE_COUNT = 20000;
+    constexpr unsigned int SEED = 42;
+    constexpr auto TARGET = "macos";
+    constexpr auto TYPE = "packages";
+
+    /// @brief Generates packages named like the applications of a macOS host
+    std::vector<nlohmann::json> GeneratePackages()
+    {
+        const std::vector<std::string> names = {
+            "Siri",
+            "iCloud",
+            "Safari",
+            "Microsoft Word",
+            "VMware Fusion",
+            "Kaspersky Internet Security For Mac",
+            "McAfee Endpoint Security For Mac",
+            "TotalDefense AntivirusforMac",
+            "AVG Antivirus",
+            "zoom.us",
+            "Quick Heal Total Security",
+            "Google Chrome",
+            "Xcode",
+            "Visual Studio Code",
+        };
+
+        std::mt19937 random(SEED);
+        std::uniform_int_distribution<size_t> pick(0, names.size() - 1);
+        std::vector<nlohmann::json> packages;
+        packages.reserve(PACKAGE_COUNT);
+
+        for (size_t i = 0; i < PACKAGE_COUNT; ++i)
+        {
+            packages.push_back({{"name", names[pick(random)]}, {"version", "1.0"}, {"vendor", ""}});
+        }
+
+        return packages;
+    }
+
+    /// @brief Reads the rules of a section of the configuration for the benchmarked target and type
+    nlohmann::json ReadRules(const nlohmann::json& config, const std::string& section)
+    {
+        auto rules = nlohmann::json::array();
+
+        for (const auto& rule : config.at(section))
+        {
+            if (rule.at("target") == TARGET && rule.at("data_type") == TYPE)
+            {
+                rules.push_back(rule);
+            }
+        }
+
+        return rules;
+    }
+
+    /// @brief Applies the rules to a package building each regular expression when it is used
+    void ApplyRegexOnly(const nlohmann::json& dictionary, const nlohmann::json& exclusions, nlohmann::json& item)
+    {
+        for (const auto& rule : dictionary)
+        {
+            const auto findPattern = rule.find("find_pattern");
+            const auto findField = rule.find("find_field");
+
+            if (findPattern != rule.end() && findField != rule.end())
+            {
+                const auto field = item.find(findField->get_ref<const std::string&>());
+
+                if (field == item.end() ||
+                    !std::regex_match(field->get_ref<const std::string&>(),
+                                      std::regex {findPattern->get_ref<const std::string&>()}))
+                {
+                    continue;
+                }
+            }
+            else if (findPattern != rule.end() || findField != rule.end())
+            {
+                continue;
+            }
+
+            if (rule.contains("replace_pattern") && rule.contains("replace_field") && rule.contains("replace_value"))
+            {
+                const auto field = item.find(rule.at("replace_field").get_ref<const std::string&>());
+
+                if (field != item.end())
+                {
+                    *field = std::regex_replace(field->get_ref<const std::string&>(),
+                                                std::regex {rule.at("replace_pattern").get_ref<const std::string&>()},
+                                                rule.at("replace_value").get_ref<const std::string&>());
+                }
+            }
+
+            if (rule.contains("add_field") && rule.contains("add_value"))
+            {
+                item[rule.at("add_field").get_ref<const std::string&>()] = rule.at("add_value");
+            }
+        }
+
+        for (const auto& rule : exclusions)
+        {
+            const auto field = item.find(rule.at("field_name").get_ref<const std::string&>());
+
+            if (field != item.end() && std::regex_match(field->get_ref<const std::string&>(),
+                                                        std::regex {rule.at("pattern").get_ref<const std::string&>()}))
+            {
+                item.clear();
+            }
+        }
+    }
+
+    /// @brief Runs a normalization over copies of all packages and returns the nanoseconds per package
+    template<typename Apply>
+    double NanosecondsPerPackage(const std::vector<nlohmann::json>& packages,
+                                 Apply apply,
+                                 std::vector<nlohmann::json>& results)
+    {
+        results = packages;
+        const auto start = std::chrono::steady_clock::now();
+
+        for (auto& item : results)
+        {
+            apply(item);
+        }
+
+        const auto elapsed = std::chrono::steady_clock::now() - start;
+        return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()) /
+               static_cast<double>(packages.size());
+    }
+} // namespace
+
+int main(int argc, char** argv)
+{
+    const std::string configFile = argc > 1 ? argv[1] : NORM_CONFIG_FILE;
+    std::ifstream configStream {configFile};
+
+    if (!configStream.is_open())
+    {
+        std::cerr << "Cannot open " << configFile << "\n";
+        return 1;
+    }
+
+    const auto config = nlohmann::json::parse(configStream);
+    const auto dictionary = ReadRules(config, "dictionary");
+    const auto exclusions = ReadRules(config, "exclusions");
+    const auto packages = GeneratePackages();
+
+    const auto loadStart = std::chrono::steady_clock::now();
+    const InvNormalizer normalizer {configFile, TARGET};
+    const auto loadTime = std::chrono::steady_clock::now() - loadStart;
+
+    std::vector<nlohmann::json> compiledResults;
+    std::vector<nlohmann::json> regexResults;
+
+    const auto compiledTime = NanosecondsPerPackage(
+        packages,
+        [&normalizer](nlohmann::json& item)
+        {
+            normalizer.Normalize(TYPE, item);
+            normalizer.RemoveExcluded(TYPE, item);
+        },
+        compiledResults);
+
+    const auto regexTime = NanosecondsPerPackage(
+        packages,
+        [&dictionary, &exclusions](nlohmann::json& item) { ApplyRegexOnly(dictionary, exclusions, item); },
+        regexResults);
+
+    if (compiledResults != regexResults)
+    {
+        std::cerr << "Mismatch between the normalizer and the regular expressions\n";
+        return 1;
+    }
+
+    std::cout << "rules: " << dictionary.size() << " dictionary, " << exclusions.size() << " exclusions\n";
+    std::cout << "load us: " << std::chrono::duration_cast<std::chrono::microseconds>(loadTime).count() << "\n";
+    std::cout << "normalizer ns/package  regex-only ns/package\n";
+    std::cout << compiledTime << "\t\t       " << regexTime << "\n";
+
+    return 0;
+}
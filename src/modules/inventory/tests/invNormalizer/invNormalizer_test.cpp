@@ -235,6 +235,80 @@ TEST_F(InvNormalizerTest, normalizeItemMatch)
     EXPECT_NE(inputJson, origJson);
 }
 
+TEST_F(InvNormalizerTest, patternKinds)
+{
+    EXPECT_EQ(NormalizerPattern {"(Siri)"}.GetKind(), NormalizerPattern::Kind::Equals);
+    EXPECT_EQ(NormalizerPattern {"Kaspersky.*"}.GetKind(), NormalizerPattern::Kind::StartsWith);
+    EXPECT_EQ(NormalizerPattern {".*Mac"}.GetKind(), NormalizerPattern::Kind::EndsWith);
+    EXPECT_EQ(NormalizerPattern {".*(Quick ).*"}.GetKind(), NormalizerPattern::Kind::Contains);
+    EXPECT_EQ(NormalizerPattern {"(zoom.us)"}.GetKind(), NormalizerPattern::Kind::Regex);
+    EXPECT_EQ(NormalizerPattern {".*"}.GetKind(), NormalizerPattern::Kind::Regex);
+    EXPECT_EQ(NormalizerPattern {"(a)|(b)"}.GetKind(), NormalizerPattern::Kind::Regex);
+    EXPECT_THROW(NormalizerPattern {"(Siri"}, std::regex_error);
+}
+
+TEST_F(InvNormalizerTest, patternMatchesLikeRegex)
+{
+    const std::vector<std::string> patterns {
+        "(Siri)", "Kaspersky.*", ".*Mac", ".*(Quick ).*", "(zoom.us)", "( For Mac)", "(a)|(b)"};
+    const std::vector<std::string> values {"Siri",
+                                           "Siri 2",
+                                           "Kaspersky Internet Security",
+                                           "The Kaspersky",
+                                           "Antivirus For Mac",
+                                           "Quick Heal Total Security",
+                                           "QuickHeal",
+                                           "zoom.us",
+                                           "zoomXus",
+                                           " For Mac",
+                                           "Kaspersky\nFor Mac",
+                                           "\nQuick Heal",
+                                           "b",
+                                           ""};
+
+    for (const auto& pattern : patterns)
+    {
+        const NormalizerPattern compiled {pattern};
+        const std::regex regex {pattern};
+
+        for (const auto& value : values)
+        {
+            EXPECT_EQ(compiled.Matches(value), std::regex_match(value, regex)) << pattern << " / " << value;
+            EXPECT_EQ(compiled.Replace(value, "-"), std::regex_replace(value, regex, "-")) << pattern << " / " << value;
+            EXPECT_EQ(compiled.Replace(value, "<$&>"), std::regex_replace(value, regex, "<$&>"))
+                << pattern << " / " << value;
+        }
+    }
+}
+
+TEST_F(InvNormalizerTest, excludeConsecutiveItems)
+{
+    auto inputJson(nlohmann::json::parse(R"([{"name": "Siri"}, {"name": "Siri"}, {"name": "iCloud"}, {"name": "Notes"}])"));
+    const InvNormalizer normalizer {TEST_CONFIG_FILE_NAME, "macos"};
+    normalizer.RemoveExcluded("packages", inputJson);
+    EXPECT_EQ(inputJson, nlohmann::json::parse(R"([{"name": "Notes"}])"));
+}
+
+TEST_F(InvNormalizerTest, ctorInvalidPatternSkipped)
+{
+    constexpr auto INVALID_PATTERN_FILE {"invalid_pattern.json"};
+    std::ofstream testConfigFile {INVALID_PATTERN_FILE};
+
+    if (testConfigFile.is_open())
+    {
+        testConfigFile << R"DELIMITER({"exclusions":[
+            {"target": "macos", "data_type": "packages", "field_name": "name", "pattern": "(Siri"},
+            {"target": "macos", "data_type": "packages", "field_name": "name", "pattern": "(iCloud)"}]})DELIMITER";
+        testConfigFile.close();
+    }
+
+    const InvNormalizer normalizer {INVALID_PATTERN_FILE, "macos"};
+    auto inputJson(nlohmann::json::parse(R"([{"name": "Siri"}, {"name": "iCloud"}])"));
+    normalizer.RemoveExcluded("packages", inputJson);
+    EXPECT_EQ(inputJson, nlohmann::json::parse(R"([{"name": "Siri"}])"));
+    std::remove(INVALID_PATTERN_FILE);
+}
+
 int main(int argc, char** argv)
 {
     ::testing::InitGoogleTest(&argc, argv);
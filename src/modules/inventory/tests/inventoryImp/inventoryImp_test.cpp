@@ -1,6 +1,11 @@
 #include "inventoryImp_test.hpp"
 #include "inventory.hpp"
+#include <atomic>
+#include <condition_variable>
 #include <cstdio>
+#include <future>
+#include <map>
+#include <mutex>
 #include <gtest/gtest.h>
 
 constexpr auto INVENTORY_DB_PATH {"TEMP.db"};
@@ -37,6 +42,12 @@ public:
     MOCK_METHOD(void, processes, (std::function<void(nlohmann::json&)>), (override));
     MOCK_METHOD(nlohmann::json, ports, (), (override));
     MOCK_METHOD(nlohmann::json, hotfixes, (), (override));
+    MOCK_METHOD(nlohmann::json, packagesFingerprint, (), (override));
+    MOCK_METHOD(bool,
+                processEvents,
+                (std::function<void(ProcessEventType, nlohmann::json&)>, std::function<bool()>),
+                (override));
+    MOCK_METHOD(bool, networkEvents, (std::function<void()>, std::function<bool()>), (override));
 };
 
 class CallbackMock
@@ -1437,6 +1448,390 @@ TEST_F(InventoryImpTest, statelessMessage)
     }
 }
 
+TEST_F(InventoryImpTest, collectorsRunConcurrently)
+{
+    const auto spInfoWrapper {std::make_shared<SysInfoWrapper>()};
+
+    std::promise<void> processesStarted;
+    auto processesStartedFuture = processesStarted.get_future();
+    std::atomic<bool> ranConcurrently {false};
+
+    EXPECT_CALL(*spInfoWrapper, packages(testing::_))
+        .WillOnce(
+            [&processesStartedFuture, &ranConcurrently](const std::function<void(nlohmann::json&)>& callback)
+            {
+                // Only returns in time if the processes collector runs while packages is still scanning
+                ranConcurrently = processesStartedFuture.wait_for(std::chrono::seconds {SLEEP_DURATION_SECONDS}) ==
+                                  std::future_status::ready;
+                auto package =
+                    R"({"architecture":"amd64","scan_time":"2020/12/28 21:49:50", "group":"x11","name":"xserver-xorg","priority":"optional","size":4111222333,"source":"xorg","version":"1:7.7+19ubuntu14","format":"deb","location":" "})"_json;
+                callback(package);
+            });
+    EXPECT_CALL(*spInfoWrapper, processes(testing::_))
+        .WillOnce(
+            [&processesStarted](const std::function<void(nlohmann::json&)>& callback)
+            {
+                processesStarted.set_value();
+                auto process =
+                    R"({"egroup":"root","euser":"root","fgroup":"root","name":"kworker/u256:2-","scan_time":"2020/12/28 21:49:50", "nice":0,"nlwp":1,"pgrp":0,"pid":"431625","ppid":2,"priority":20,"processor":1,"resident":0,"rgroup":"root","ruser":"root","session":0,"sgroup":"root","share":0,"size":0,"start_time":9302261,"state":"I","stime":3,"suser":"root","tgid":431625,"tty":0,"utime":0,"vm_size":0})"_json;
+                callback(process);
+            });
+
+    CallbackMock wrapperDelta;
+    std::function<void(const std::string&)> callbackDataDelta {
+        [&wrapperDelta](const std::string& data)
+        {
+            auto delta = nlohmann::json::parse(data);
+            wrapperDelta.callbackMock(delta["metadata"]["collector"].get<std::string>());
+        }};
+
+    EXPECT_CALL(wrapperDelta, callbackMock("packages")).Times(1);
+    EXPECT_CALL(wrapperDelta, callbackMock("processes")).Times(1);
+
+    const std::string inventoryConfig = R"(
+        inventory:
+            enabled: true
+            interval: 3600
+            scan_on_start: true
+            hardware: false
+            system: false
+            networks: false
+            packages: true
+            ports: false
+            ports_all: false
+            processes: true
+            hotfixes: false
+            thread_count: 2
+    )";
+    auto configParser = std::make_shared<configuration::ConfigurationParser>(inventoryConfig);
+    Inventory::Instance().Setup(configParser);
+
+    std::thread t {[&spInfoWrapper, &callbackDataDelta]()
+                   { Inventory::Instance().Init(spInfoWrapper, callbackDataDelta, INVENTORY_DB_PATH, "", ""); }};
+
+    std::this_thread::sleep_for(std::chrono::seconds {SLEEP_DURATION_SECONDS});
+    Inventory::Instance().Stop();
+
+    if (t.joinable())
+    {
+        t.join();
+    }
+
+    EXPECT_TRUE(ranConcurrently);
+}
+
+TEST_F(InventoryImpTest, concurrentCollectorsSyncEveryRow)
+{
+    constexpr auto ROWS_PER_COLLECTOR {2000};
+    const auto spInfoWrapper {std::make_shared<SysInfoWrapper>()};
+
+    EXPECT_CALL(*spInfoWrapper, packages(testing::_))
+        .WillOnce(
+            [](const std::function<void(nlohmann::json&)>& callback)
+            {
+                for (auto i = 0; i < ROWS_PER_COLLECTOR; ++i)
+                {
+                    auto package =
+                        R"({"architecture":"amd64","scan_time":"2020/12/28 21:49:50", "group":"x11","priority":"optional","size":4111222333,"source":"xorg","version":"1:7.7+19ubuntu14","format":"deb","location":" "})"_json;
+                    package["name"] = "package-" + std::to_string(i);
+                    callback(package);
+                }
+            });
+    EXPECT_CALL(*spInfoWrapper, processes(testing::_))
+        .WillOnce(
+            [](const std::function<void(nlohmann::json&)>& callback)
+            {
+                for (auto i = 0; i < ROWS_PER_COLLECTOR; ++i)
+                {
+                    auto process =
+                        R"({"egroup":"root","euser":"root","fgroup":"root","name":"kworker/u256:2-","scan_time":"2020/12/28 21:49:50", "nice":0,"nlwp":1,"pgrp":0,"ppid":2,"priority":20,"processor":1,"resident":0,"rgroup":"root","ruser":"root","session":0,"sgroup":"root","share":0,"size":0,"start_time":9302261,"state":"I","stime":3,"suser":"root","tgid":431625,"tty":0,"utime":0,"vm_size":0})"_json;
+                    process["pid"] = std::to_string(i + 1);
+                    callback(process);
+                }
+            });
+
+    auto ports = nlohmann::json::array();
+    auto hotfixes = nlohmann::json::array();
+    for (auto i = 0; i < ROWS_PER_COLLECTOR; ++i)
+    {
+        auto port =
+            R"({"local_ip":"0.0.0.0","pid":0,"process_name":"","protocol":"tcp","remote_ip":"0.0.0.0","remote_port":0,"rx_queue":0,"state":"listening","tx_queue":0})"_json;
+        port["inode"] = i + 1;
+        port["local_port"] = i + 1;
+        ports.push_back(std::move(port));
+        hotfixes.push_back({{"hotfix", "KB" + std::to_string(i)}});
+    }
+    EXPECT_CALL(*spInfoWrapper, ports()).WillOnce(Return(ports));
+    EXPECT_CALL(*spInfoWrapper, hotfixes()).WillOnce(Return(hotfixes));
+
+    std::mutex countsMutex;
+    std::condition_variable countsCv;
+    std::map<std::string, int> created;
+    auto otherEvents {0};
+    std::function<void(const std::string&)> callbackDataDelta {
+        [&](const std::string& data)
+        {
+            const auto delta = nlohmann::json::parse(data);
+            const std::lock_guard<std::mutex> lock {countsMutex};
+            if (delta["metadata"]["operation"] == "create")
+            {
+                ++created[delta["metadata"]["collector"].get<std::string>()];
+            }
+            else
+            {
+                ++otherEvents;
+            }
+            countsCv.notify_all();
+        }};
+
+    const std::string inventoryConfig = R"(
+        inventory:
+            enabled: true
+            interval: 3600
+            scan_on_start: true
+            hardware: false
+            system: false
+            networks: false
+            packages: true
+            ports: true
+            ports_all: true
+            processes: true
+            hotfixes: true
+            thread_count: 4
+    )";
+    auto configParser = std::make_shared<configuration::ConfigurationParser>(inventoryConfig);
+    Inventory::Instance().Setup(configParser);
+
+    std::thread t {[&spInfoWrapper, &callbackDataDelta]()
+                   { Inventory::Instance().Init(spInfoWrapper, callbackDataDelta, INVENTORY_DB_PATH, "", ""); }};
+
+    {
+        std::unique_lock<std::mutex> lock {countsMutex};
+        countsCv.wait_for(lock,
+                          std::chrono::seconds {SLEEP_DURATION_SECONDS * 10},
+                          [&created]()
+                          {
+                              return created["packages"] == ROWS_PER_COLLECTOR &&
+                                     created["processes"] == ROWS_PER_COLLECTOR &&
+                                     created["ports"] == ROWS_PER_COLLECTOR &&
+                                     created["hotfixes"] == ROWS_PER_COLLECTOR;
+                          });
+    }
+    Inventory::Instance().Stop();
+
+    if (t.joinable())
+    {
+        t.join();
+    }
+
+    EXPECT_EQ(created["packages"], ROWS_PER_COLLECTOR);
+    EXPECT_EQ(created["processes"], ROWS_PER_COLLECTOR);
+    EXPECT_EQ(created["ports"], ROWS_PER_COLLECTOR);
+    EXPECT_EQ(created["hotfixes"], ROWS_PER_COLLECTOR);
+    EXPECT_EQ(otherEvents, 0);
+}
+
+TEST_F(InventoryImpTest, packagesSkippedWhileSourcesUnchanged)
+{
+    const auto spInfoWrapper {std::make_shared<SysInfoWrapper>()};
+
+    std::promise<void> secondPackagesScan;
+    auto secondPackagesScanFuture = secondPackagesScan.get_future();
+
+    // The second scan sees the same sources and skips packages, the third one sees them changed
+    EXPECT_CALL(*spInfoWrapper, packagesFingerprint())
+        .Times(::testing::AtLeast(3))
+        .WillOnce(Return(R"({"/var/lib/dpkg/status":"1:100:1.0"})"_json))
+        .WillOnce(Return(R"({"/var/lib/dpkg/status":"1:100:1.0"})"_json))
+        .WillRepeatedly(Return(R"({"/var/lib/dpkg/status":"1:200:2.0"})"_json));
+    EXPECT_CALL(*spInfoWrapper, packages(testing::_))
+        .WillOnce(::testing::InvokeArgument<0>(
+            R"({"architecture":"amd64","scan_time":"2020/12/28 21:49:50", "group":"x11","name":"xserver-xorg","priority":"optional","size":4111222333,"source":"xorg","version":"1:7.7+19ubuntu14","format":"deb","location":" "})"_json))
+        .WillOnce(
+            [&secondPackagesScan](const std::function<void(nlohmann::json&)>& callback)
+            {
+                auto package =
+                    R"({"architecture":"amd64","scan_time":"2020/12/28 21:49:50", "group":"x11","name":"xserver-xorg","priority":"optional","size":4111222333,"source":"xorg","version":"1:7.7+19ubuntu14","format":"deb","location":" "})"_json;
+                callback(package);
+                secondPackagesScan.set_value();
+            });
+
+    const std::string inventoryConfig = R"(
+        inventory:
+            enabled: true
+            interval: 1
+            scan_on_start: true
+            hardware: false
+            system: false
+            networks: false
+            packages: true
+            ports: false
+            ports_all: false
+            processes: false
+            hotfixes: false
+    )";
+    auto configParser = std::make_shared<configuration::ConfigurationParser>(inventoryConfig);
+    Inventory::Instance().Setup(configParser);
+
+    std::thread t {[&spInfoWrapper]()
+                   { Inventory::Instance().Init(spInfoWrapper, ReportFunction, INVENTORY_DB_PATH, "", ""); }};
+
+    EXPECT_EQ(secondPackagesScanFuture.wait_for(std::chrono::seconds {SLEEP_DURATION_SECONDS * 2}),
+              std::future_status::ready);
+    Inventory::Instance().Stop();
+
+    if (t.joinable())
+    {
+        t.join();
+    }
+}
+
+TEST_F(InventoryImpTest, processEventsAppliedBetweenScans)
+{
+    const auto spInfoWrapper {std::make_shared<SysInfoWrapper>()};
+
+    EXPECT_CALL(*spInfoWrapper, processes(testing::_))
+        .Times(1)
+        .WillOnce(::testing::InvokeArgument<0>(
+            R"({"egroup":"root","euser":"root","name":"kworker/u256:2-","pid":"431625","ppid":2,"rgroup":"root","ruser":"root","sgroup":"root","start_time":9302261,"suser":"root","tgid":431625,"tty":0})"_json));
+    EXPECT_CALL(*spInfoWrapper, processEvents(testing::_, testing::_))
+        .WillOnce(
+            [](auto callback, auto stopRequested)
+            {
+                // Let the first scan fill the table
+                std::this_thread::sleep_for(std::chrono::seconds {1});
+
+                auto forked =
+                    R"({"name":"bash","pid":"100","ppid":1,"start_time":9400000,"tgid":100,"tty":0})"_json;
+                auto executed =
+                    R"({"cmd":"/usr/bin/sleep","name":"sleep","pid":"100","ppid":1,"start_time":9400000,"tgid":100,"tty":0})"_json;
+                auto finished = R"({"pid":"431625"})"_json;
+                auto unknown = R"({"pid":"200"})"_json;
+                callback(PROCESS_STARTED, forked);
+                callback(PROCESS_STARTED, executed);
+                callback(PROCESS_FINISHED, finished);
+                callback(PROCESS_FINISHED, unknown);
+
+                while (!stopRequested())
+                {
+                    std::this_thread::sleep_for(std::chrono::milliseconds {10});
+                }
+                return true;
+            });
+
+    std::mutex deltasMutex;
+    std::vector<std::string> deltas;
+    std::function<void(const std::string&)> callbackDataDelta {
+        [&deltasMutex, &deltas](const std::string& data)
+        {
+            const auto delta = nlohmann::json::parse(data);
+            const std::lock_guard<std::mutex> lock {deltasMutex};
+            deltas.push_back(delta["metadata"]["operation"].get<std::string>() + ":" +
+                             delta["data"]["process"]["pid"].get<std::string>() + ":" +
+                             (delta.contains("stateless") ? "stateless" : "stateful"));
+        }};
+
+    const std::string inventoryConfig = R"(
+        inventory:
+            enabled: true
+            interval: 1h
+            scan_on_start: true
+            hardware: false
+            system: false
+            networks: false
+            packages: false
+            ports: false
+            ports_all: false
+            processes: true
+            hotfixes: false
+            process_events: true
+    )";
+    auto configParser = std::make_shared<configuration::ConfigurationParser>(inventoryConfig);
+    Inventory::Instance().Setup(configParser);
+
+    std::thread t {[&spInfoWrapper, &callbackDataDelta]()
+                   { Inventory::Instance().Init(spInfoWrapper, callbackDataDelta, INVENTORY_DB_PATH, "", ""); }};
+
+    std::this_thread::sleep_for(std::chrono::seconds {SLEEP_DURATION_SECONDS});
+    Inventory::Instance().Stop();
+
+    if (t.joinable())
+    {
+        t.join();
+    }
+
+    const std::vector<std::string> expected {
+        "create:431625:stateful", "create:100:stateless", "delete:431625:stateless"};
+    EXPECT_EQ(deltas, expected);
+}
+
+TEST_F(InventoryImpTest, networkEventsTriggerRescan)
+{
+    const auto spInfoWrapper {std::make_shared<SysInfoWrapper>()};
+
+    EXPECT_CALL(*spInfoWrapper, networks())
+        .WillOnce(Return(nlohmann::json::parse(
+            R"({"iface":[{"IPv4":[{"address":"172.17.0.1","broadcast":"172.17.255.255","dhcp":"unknown","metric":"0","netmask":"255.255.0.0"}],"adapter":"","gateway":"","mac":"02:42:1c:26:13:65","mtu":1500,"name":"docker0","rx_bytes":0,"rx_dropped":0,"rx_errors":0,"rx_packets":0,"state":"down","tx_bytes":0,"tx_dropped":0,"tx_errors":0,"tx_packets":0,"type":"ethernet"}]})")))
+        .WillOnce(Return(nlohmann::json::parse(
+            R"({"iface":[{"IPv4":[{"address":"172.17.0.1","broadcast":"172.17.255.255","dhcp":"unknown","metric":"0","netmask":"255.255.0.0"}],"adapter":"","gateway":"","mac":"02:42:1c:26:13:65","mtu":1500,"name":"docker0","rx_bytes":0,"rx_dropped":0,"rx_errors":0,"rx_packets":0,"state":"up","tx_bytes":0,"tx_dropped":0,"tx_errors":0,"tx_packets":0,"type":"ethernet"}]})")));
+    EXPECT_CALL(*spInfoWrapper, networkEvents(testing::_, testing::_))
+        .WillOnce(
+            [](auto callback, auto stopRequested)
+            {
+                // Let the first scan fill the table
+                std::this_thread::sleep_for(std::chrono::seconds {1});
+                callback();
+
+                while (!stopRequested())
+                {
+                    std::this_thread::sleep_for(std::chrono::milliseconds {10});
+                }
+                return true;
+            });
+
+    std::mutex deltasMutex;
+    std::vector<std::string> deltas;
+    std::function<void(const std::string&)> callbackDataDelta {
+        [&deltasMutex, &deltas](const std::string& data)
+        {
+            const auto delta = nlohmann::json::parse(data);
+            const std::lock_guard<std::mutex> lock {deltasMutex};
+            deltas.push_back(delta["metadata"]["operation"].get<std::string>());
+        }};
+
+    const std::string inventoryConfig = R"(
+        inventory:
+            enabled: true
+            interval: 1h
+            scan_on_start: true
+            hardware: false
+            system: false
+            networks: true
+            packages: false
+            ports: false
+            ports_all: false
+            processes: false
+            hotfixes: false
+            network_events: true
+    )";
+    auto configParser = std::make_shared<configuration::ConfigurationParser>(inventoryConfig);
+    Inventory::Instance().Setup(configParser);
+
+    std::thread t {[&spInfoWrapper, &callbackDataDelta]()
+                   { Inventory::Instance().Init(spInfoWrapper, callbackDataDelta, INVENTORY_DB_PATH, "", ""); }};
+
+    std::this_thread::sleep_for(std::chrono::seconds {SLEEP_DURATION_SECONDS});
+    Inventory::Instance().Stop();
+
+    if (t.joinable())
+    {
+        t.join();
+    }
+
+    const std::vector<std::string> expected {"create", "update"};
+    EXPECT_EQ(deltas, expected);
+}
+
 int main(int argc, char** argv)
 {
     ::testing::InitGoogleTest(&argc, argv);
@@ -4,12 +4,19 @@
 #include <message.hpp>
 #include <moduleWrapper.hpp>
 
+#include <boost/asio/any_io_executor.hpp>
 #include <boost/asio/awaitable.hpp>
 #include <boost/asio/io_context.hpp>
 #include <boost/asio/steady_timer.hpp>
 
+#include <atomic>
+#include <cstdint>
 #include <list>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 namespace logcollector
 {
@@ -17,6 +24,12 @@ namespace logcollector
     /// @brief Interface for log readers
     class IReader;
 
+    /// @brief Store of file reading positions
+    class BookmarkStore;
+
+    /// @brief File change notifier
+    class IFileWatcher;
+
     /// @brief Logcollector module class
     ///
     /// This module is responsible for collecting logs from various sources and processing them.
@@ -24,6 +37,9 @@ namespace logcollector
     {
     public:
         /// @brief Starts the module
+        ///
+        /// Runs the readers on the calling thread plus thread_count - 1 additional
+        /// threads, and returns when all of them finished.
         void Start();
 
         /// @brief Configures the module
@@ -57,7 +73,40 @@ namespace logcollector
         /// @pre The message queue must be set with SetMessageQueue
         virtual void SendMessage(const std::string& location, const std::string& log, const std::string& collectorType);
 
+        /// @brief Sends a batch of messages to the queue in a single push
+        ///
+        /// If the queue is full, the messages are dropped and counted.
+        ///
+        /// @param location Location of the messages
+        /// @param logs Messages to send
+        /// @param collectorType type of logcollector
+        /// @pre The message queue must be set with SetMessageQueue
+        virtual void SendMessages(const std::string& location,
+                                  const std::vector<std::string>& logs,
+                                  const std::string& collectorType);
+
+        /// @brief Tries to send a batch of messages to the queue in a single push
+        /// @param location Location of the messages
+        /// @param logs Messages to send
+        /// @param collectorType type of logcollector
+        /// @return True if the queue accepted the messages, false if it is full
+        /// @pre The message queue must be set with SetMessageQueue
+        bool TrySendMessages(const std::string& location,
+                             const std::vector<std::string>& logs,
+                             const std::string& collectorType);
+
+        /// @brief Gets the number of logs dropped because the queue was full
+        /// @return Number of dropped logs
+        inline uint64_t DroppedLogs() const
+        {
+            return m_droppedLogs.load();
+        }
+
         /// @brief Enqueues an ASIO task (coroutine)
+        ///
+        /// Each task runs on its own strand, so it never runs concurrently with
+        /// itself even when the module uses several threads.
+        ///
         /// @param task Task to enqueue
         virtual void EnqueueTask(boost::asio::awaitable<void> task);
 
@@ -65,6 +114,16 @@ namespace logcollector
         /// @param reader Reader to add
         virtual void AddReader(std::shared_ptr<IReader> reader);
 
+        /// @brief Gets the file watcher shared by the file readers
+        ///
+        /// The watcher is created and started on the first call, so that a single
+        /// inotify instance serves all the readers: the number of instances per
+        /// user is limited. It is stopped when the readers are cleaned.
+        ///
+        /// @param executor Executor where notifications are read
+        /// @return File watcher, or nullptr if notifications are not available
+        std::shared_ptr<IFileWatcher> FileWatcher(boost::asio::any_io_executor executor);
+
         /// @brief Waits for a specified amount of time
         ///
         /// @param ms Time to wait in milliseconds
@@ -93,6 +152,10 @@ namespace logcollector
         /// @param configurationParser Configuration parser
         void SetupFileReader(const std::shared_ptr<const configuration::ConfigurationParser> configurationParser);
 
+        /// @brief Sets up the syslog readers
+        /// @param configurationParser Configuration parser
+        void SetupSyslogReader(const std::shared_ptr<const configuration::ConfigurationParser> configurationParser);
+
         /// @brief Clean all readers
         void CleanAllReaders();
 
@@ -106,9 +169,15 @@ namespace logcollector
         /// @brief Push message function
         std::function<int(Message)> m_pushMessage;
 
+        /// @brief Number of threads running the ASIO context
+        size_t m_threadCount = 1;
+
         /// @brief Boost ASIO context
         boost::asio::io_context m_ioContext;
 
+        /// @brief Mutex to access the readers list
+        std::mutex m_readersMutex;
+
         /// @brief List of readers
         std::list<std::shared_ptr<IReader>> m_readers;
 
@@ -119,7 +188,31 @@ namespace logcollector
         std::mutex m_timersMutex;
 
         /// @brief List of steady timers
-        std::list<boost::asio::steady_timer*> m_timers;
+        std::list<std::shared_ptr<boost::asio::steady_timer>> m_timers;
+
+        /// @brief Mutex to create and stop the file watcher
+        std::mutex m_fileWatcherMutex;
+
+        /// @brief File watcher shared by the file readers, null if not created or not available
+        std::shared_ptr<IFileWatcher> m_fileWatcher;
+
+        /// @brief Whether the creation of the file watcher was already attempted
+        bool m_fileWatcherCreated = false;
+
+        /// @brief File bookmarks store, null if it cannot be opened
+        std::shared_ptr<BookmarkStore> m_bookmarks;
+
+        /// @brief Number of logs dropped because the queue was full
+        std::atomic<uint64_t> m_droppedLogs = 0;
+
+        /// @brief Whether the last push was rejected, to warn once per outage
+        std::atomic<bool> m_queueFull = false;
+
+        /// @brief Mutex to access the serialized message metadata
+        std::mutex m_metadataMutex;
+
+        /// @brief Serialized message metadata of each collector type
+        std::unordered_map<std::string, std::string> m_metadata;
     };
 
 } // namespace logcollector
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <persistence.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+
+namespace logcollector
+{
+    /// @brief Reading position of a local file
+    ///
+    /// The device and inode identify the file that was being read, and the hash
+    /// of its first bytes detects files that were truncated and rewritten in place.
+    struct FileBookmark
+    {
+        /// @brief Device (or volume serial number) of the file
+        uint64_t device {0};
+
+        /// @brief Inode (or file index) of the file
+        uint64_t inode {0};
+
+        /// @brief Offset of the first byte not yet read
+        uint64_t offset {0};
+
+        /// @brief Hex-encoded SHA-1 of the first bytes of the file
+        std::string headHash;
+    };
+
+    /// @brief Bookmark store class
+    ///
+    /// Persists the reading position of each local file, and the journal cursor of
+    /// each journald reader, so that Logcollector can resume from them after a
+    /// restart. Updates are kept in memory and written to the database in a single
+    /// transaction, at most once per flush interval.
+    class BookmarkStore
+    {
+    public:
+        /// @brief Constructor
+        /// @param dbFolderPath The path to the database folder
+        /// @param flushInterval Minimum time between two writes of pending bookmarks
+        /// @param persistence Optional pointer to an existing persistence object
+        /// @throws std::runtime_error if the database cannot be opened
+        BookmarkStore(const std::string& dbFolderPath,
+                      std::chrono::milliseconds flushInterval = std::chrono::milliseconds(1000),
+                      std::unique_ptr<Persistence> persistence = nullptr);
+
+        /// @brief Destructor, writes the pending bookmarks
+        ~BookmarkStore();
+
+        /// @brief Gets the bookmark of a file
+        /// @param path File path
+        /// @return The bookmark, or nullopt if the file has none
+        std::optional<FileBookmark> Get(const std::string& path);
+
+        /// @brief Sets the bookmark of a file
+        /// @param path File path
+        /// @param bookmark Bookmark
+        void Set(const std::string& path, const FileBookmark& bookmark);
+
+        /// @brief Removes the bookmark of a file
+        /// @param path File path
+        void Remove(const std::string& path);
+
+        /// @brief Gets the journal cursor of a reader
+        /// @param reader Reader key
+        /// @return The cursor of the last delivered entry, or nullopt if the reader has none
+        std::optional<std::string> GetCursor(const std::string& reader);
+
+        /// @brief Sets the journal cursor of a reader
+        /// @param reader Reader key
+        /// @param cursor Cursor of the last delivered entry
+        void SetCursor(const std::string& reader, const std::string& cursor);
+
+        /// @brief Writes the pending bookmarks if the flush interval has elapsed
+        void FlushIfDue();
+
+        /// @brief Writes the pending bookmarks
+        /// @return True if successful, false otherwise
+        bool Flush();
+
+    private:
+        /// @brief Unique pointer to the persistence instance
+        std::unique_ptr<Persistence> m_dataBase;
+
+        /// @brief Minimum time between two flushes
+        std::chrono::milliseconds m_flushInterval;
+
+        /// @brief Time of the last flush
+        std::chrono::steady_clock::time_point m_lastFlush;
+
+        /// @brief Bookmarks not yet written, nullopt means removed
+        std::map<std::string, std::optional<FileBookmark>> m_pending;
+
+        /// @brief Journal cursors not yet written
+        std::map<std::string, std::string> m_pendingCursors;
+
+        /// @brief Mutex to access the pending bookmarks and the database
+        std::mutex m_mutex;
+    };
+} // namespace logcollector
@@ -1,11 +1,24 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
 #include <ctime>
 #include <exception>
 #include <fstream>
+#include <limits>
 #include <list>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
+#include <bookmark_store.hpp>
+#include <file_watcher.hpp>
+#include <line_filter.hpp>
 #include <logcollector.hpp>
+#include <multiline_assembler.hpp>
 #include <reader.hpp>
 
 const std::string FILE_READER_TYPE = "file";
@@ -16,7 +29,9 @@ namespace logcollector
     /// @brief Local file class
     ///
     /// This class represents an individual local file that can be read by
-    /// Logcollector.
+    /// Logcollector. The file is read in large blocks into a reusable buffer,
+    /// which is split into lines. Incomplete lines are kept in the buffer until
+    /// the rest of the line is written.
     class Localfile
     {
     public:
@@ -29,22 +44,69 @@ namespace logcollector
         Localfile(std::shared_ptr<std::istream> stream);
 
         /// @brief Gets the next log from the file
-        /// @return A log, or an empty string if the end of the file has been reached
-        std::string NextLog();
+        ///
+        /// Empty lines are skipped and carriage returns before the newline are
+        /// removed. Lines longer than BUFFER_SIZE - 1 bytes are truncated, and the
+        /// rest of the line is discarded.
+        ///
+        /// @return A log, or an empty view if the end of the file has been reached.
+        ///         The view is valid until the next call to a non-const method
+        std::string_view NextLog();
 
         /// @brief Seeks to the end of the file
         void SeekEnd();
 
+        /// @brief Gets the bookmark of the current reading position
+        ///
+        /// The hash covers the first bytes of the file, up to the reading position.
+        /// At most the first kilobyte is hashed, so the hash is cached once the
+        /// reading position goes beyond it.
+        ///
+        /// @return Bookmark
+        inline FileBookmark Bookmark()
+        {
+            return Bookmark(Offset());
+        }
+
+        /// @brief Gets the bookmark of a position that has already been read
+        /// @param offset Position, not beyond the reading position
+        /// @return Bookmark
+        FileBookmark Bookmark(uint64_t offset);
+
+        /// @brief Resumes reading from a bookmark
+        ///
+        /// The position is restored only if the bookmark refers to this same file:
+        /// the device and inode match, the file is not shorter than the offset and
+        /// its first bytes have not changed. Otherwise, the position is left at the
+        /// beginning of the file.
+        ///
+        /// @param bookmark Bookmark saved by a previous run
+        /// @return True if the position was restored, false otherwise
+        bool Resume(const FileBookmark& bookmark);
+
+        /// @brief Gets the reading position
+        /// @return Offset of the first byte not yet read
+        inline uint64_t Offset() const
+        {
+            return m_pos;
+        }
+
         /// @brief Checks if the file has been rotated
         ///
-        /// This method checks if the file has been rotated by comparing the current
-        /// size of the file with the reading position. If the file size is lower
-        /// than the reading position, the file has been rotated.
+        /// The file has been rotated if its path now refers to another file (the
+        /// device or inode changed, e.g. it was renamed and created again), or if
+        /// its size is lower than the reading position (it was truncated).
         ///
         /// @return True if the file has been rotated, false otherwise
+        /// @throws OpenError if the path does not exist
         bool Rotated();
 
         /// @brief Reopens the file
+        ///
+        /// The opened file can still be read until this method is called, so that
+        /// the logs written to it before a rotation are not lost.
+        ///
+        /// @throws OpenError if the file cannot be opened
         void Reopen();
 
         /// @brief Gets the file name
@@ -54,15 +116,76 @@ namespace logcollector
             return m_filename;
         }
 
+        /// @brief Gets the identity of the opened file
+        /// @return Device and inode, or zeros if they are not known
+        inline std::pair<uint64_t, uint64_t> Identity() const
+        {
+            return {m_device, m_inode};
+        }
+
     private:
+        /// @brief Reads the next block of the file into the buffer
+        ///
+        /// Moves the unread bytes to the beginning of the buffer and fills the
+        /// rest of it.
+        ///
+        /// @return True if any bytes were read, false at the end of the file
+        bool FillBuffer();
+
+        /// @brief Moves the reading position and discards the buffer
+        /// @param offset New reading position
+        void ResetBuffer(uint64_t offset);
+
+        /// @brief Stores the device and inode of the file, or zeros if it does not exist
+        void UpdateIdentity();
+
+        /// @brief Reads the device and inode of the file that the path refers to
+        /// @param device Device of the file
+        /// @param inode Inode of the file
+        /// @return True if successful, false if the file does not exist
+        /// @note This method is platform specific
+        bool ReadIdentity(uint64_t& device, uint64_t& inode) const;
+
+        /// @brief Hashes the first bytes of the file
+        /// @param size Number of bytes to hash
+        /// @return Hex-encoded SHA-1, or an empty string if the file is shorter than size
+        std::string HeadHash(uint64_t size) const;
+
         /// @brief File name
         std::string m_filename;
 
         /// @brief Shared pointer to the input stream
         std::shared_ptr<std::istream> m_stream;
 
-        /// @brief Current position in the file
-        std::streampos m_pos;
+        /// @brief Offset of the first byte not yet returned as a log
+        uint64_t m_pos {0};
+
+        /// @brief Offset of the first byte not yet read into the buffer
+        uint64_t m_readPos {0};
+
+        /// @brief Read buffer
+        std::vector<char> m_buffer;
+
+        /// @brief Position of the first unread byte in the buffer
+        size_t m_begin {0};
+
+        /// @brief Position past the last valid byte in the buffer
+        size_t m_end {0};
+
+        /// @brief Whether the rest of a truncated line is being discarded
+        bool m_discarding {false};
+
+        /// @brief Device of the opened file
+        uint64_t m_device {0};
+
+        /// @brief Inode of the opened file
+        uint64_t m_inode {0};
+
+        /// @brief Cached hash of the first bytes of the file
+        std::string m_headHash;
+
+        /// @brief Number of bytes covered by the cached hash
+        uint64_t m_headHashSize {0};
     };
 
     /// @brief File reader class
@@ -79,7 +202,18 @@ namespace logcollector
         /// @param pattern File pattern
         /// @param fileWait File wait time in milliseconds
         /// @param reloadInterval Reload interval in milliseconds
-        FileReader(Logcollector& logcollector, std::string pattern, std::time_t fileWait, std::time_t reloadInterval);
+        /// @param bookmarks Bookmark store, or nullptr to start reading the files found at startup at their end
+        /// @param filter Filter of the lines to send, or nullptr to send all lines
+        /// @param multiline Rule to join lines into events, or nullptr to send each line as an event
+        /// @param watchFiles Whether to wait for file change notifications, or only poll every fileWait
+        FileReader(Logcollector& logcollector,
+                   std::string pattern,
+                   std::time_t fileWait,
+                   std::time_t reloadInterval,
+                   std::shared_ptr<BookmarkStore> bookmarks = nullptr,
+                   std::shared_ptr<const LineFilter> filter = nullptr,
+                   std::shared_ptr<const MultilineRule> multiline = nullptr,
+                   bool watchFiles = true);
 
         /// @brief Runs the file reader
         /// @return Awaitable result
@@ -96,16 +230,98 @@ namespace logcollector
         /// @param callback Callback function
         void Reload(const std::function<void(Localfile&)>& callback);
 
+        /// @brief Adds the new entries of the pattern directory to the file list
+        ///
+        /// Only the entries that match the pattern are added, so that the cost
+        /// depends on the number of new entries instead of the directory size.
+        ///
+        /// @param names Names of the entries created in the directory
+        /// @param callback Callback function
+        void ReloadEntries(const std::vector<std::string>& names, const std::function<void(Localfile&)>& callback);
+
         /// @brief Reads a local file
         /// @param lf Localfile
         /// @return Awaitable result
         Awaitable ReadLocalfile(Localfile* lf);
 
     private:
+        /// @brief Sets the initial reading position of a new local file
+        ///
+        /// Resumes from the bookmark of the file if it has one. Files whose
+        /// bookmark refers to another file (e.g. rotated while the agent was
+        /// stopped) are read from the beginning, after the rest of the rotated
+        /// file. Files without a bookmark are read from the end if they were
+        /// found at startup, and from the beginning if they appeared later.
+        ///
+        /// @param lf Localfile
+        /// @param startup Whether the file was found by the first scan of the pattern
+        /// @return Awaitable result
+        boost::asio::awaitable<void> SetStartPosition(Localfile& lf, bool startup);
+
+        /// @brief Reads the rest of a file that was rotated while the agent was stopped
+        ///
+        /// Looks for the last rotated file (path.1) and, if the bookmark refers to
+        /// it, sends its logs from the bookmark offset on behalf of the path.
+        ///
+        /// @param path File path
+        /// @param bookmark Bookmark of the file saved by a previous run
+        /// @return Awaitable result
+        boost::asio::awaitable<void> ReadRotatedFile(const std::string& path, const FileBookmark& bookmark);
+
+        /// @brief Sends the logs of a local file up to its end
+        ///
+        /// The logs are sent in batches of at most MAX_BATCH_SIZE logs. With an
+        /// assembler, lines are joined into events first, and the pending event
+        /// is only sent once it expires or is flushed. Logs rejected by the filter
+        /// are skipped before they reach the queue. While the queue is full, this
+        /// waits for space instead of dropping logs.
+        ///
+        /// @param lf Localfile
+        /// @param location Location of the logs
+        /// @param logs Reusable buffer of logs
+        /// @param assembler Multiline assembler of the file, or nullptr to send each line as a log
+        /// @param flush Whether to send the pending event even if it has not expired
+        /// @return Awaitable that returns true if all logs were sent, false if the reader was stopped first
+        boost::asio::awaitable<bool> SendLogs(Localfile& lf,
+                                              const std::string& location,
+                                              std::vector<std::string>& logs,
+                                              MultilineAssembler* assembler = nullptr,
+                                              bool flush = false);
+
+        /// @brief Saves the reading position of a local file
+        /// @param lf Localfile
+        /// @param assembler Multiline assembler of the file, whose pending event is read again after a restart
+        void SaveBookmark(Localfile& lf, const MultilineAssembler* assembler = nullptr);
+
+        /// @brief Waits for changes in a file or directory
+        ///
+        /// Uses the file watcher if available and the path is being watched,
+        /// otherwise it waits for the polling interval.
+        ///
+        /// @param wd Watch descriptor, or -1 if not watched
+        /// @param pollInterval Time to wait if the path is not watched
+        /// @param maxWait Maximum time to wait, even if the path is watched
+        /// @return Bitmask of FileEvent, 0 on timeout
+        boost::asio::awaitable<uint32_t> WaitForChanges(int wd,
+                                                        std::time_t pollInterval,
+                                                        std::time_t maxWait = std::numeric_limits<std::time_t>::max());
+
+        /// @brief Checks if a path matches the file pattern
+        /// @param path File path
+        /// @return True if the path matches, false otherwise
+        /// @note This method is platform specific
+        bool MatchesPattern(const std::string& path) const;
+
+        /// @brief Updates the identity index after a local file has been reopened
+        /// @param lf Localfile
+        /// @param previous Identity of the file before it was reopened
+        void ReindexLocalfile(const Localfile& lf, const std::pair<uint64_t, uint64_t>& previous);
+
         /// @brief Adds localfiles to the list
         ///
         /// Merges the new files with the existing files. For each new file, it
-        /// calls the callback function.
+        /// calls the callback function. Paths that refer to a file that is already
+        /// being read (e.g. symbolic links) are skipped.
         ///
         /// @param paths List of file paths
         /// @param callback Callback function
@@ -122,6 +338,24 @@ namespace logcollector
         /// @brief List of local files
         std::list<Localfile> m_localfiles;
 
+        /// @brief Hash of a file identity (device and inode)
+        struct IdentityHash
+        {
+            size_t operator()(const std::pair<uint64_t, uint64_t>& identity) const noexcept
+            {
+                return std::hash<uint64_t> {}(identity.second * 31 + identity.first);
+            }
+        };
+
+        /// @brief Index of the local files by path
+        std::unordered_map<std::string, std::list<Localfile>::iterator> m_localfilesByPath;
+
+        /// @brief Index of the paths of the local files by identity
+        std::unordered_map<std::pair<uint64_t, uint64_t>, std::string, IdentityHash> m_pathsByIdentity;
+
+        /// @brief Mutex to access the list of local files from the reader strands
+        std::mutex m_localfilesMutex;
+
         /// @brief File reading interval in milliseconds
         std::time_t m_fileWait;
 
@@ -130,6 +364,24 @@ namespace logcollector
 
         /// @brief File pattern
         const std::string m_collectorType = FILE_READER_TYPE;
+
+        /// @brief File watcher shared with the other readers, null if notifications are not available
+        std::shared_ptr<IFileWatcher> m_watcher;
+
+        /// @brief Mutex to take the file watcher
+        std::mutex m_watcherMutex;
+
+        /// @brief Bookmark store, null if bookmarks are not available
+        std::shared_ptr<BookmarkStore> m_bookmarks;
+
+        /// @brief Filter of the lines to send, null to send all lines
+        std::shared_ptr<const LineFilter> m_filter;
+
+        /// @brief Rule to join lines into events, null to send each line as an event
+        std::shared_ptr<const MultilineRule> m_multiline;
+
+        /// @brief Whether to wait for file change notifications, or only poll
+        bool m_watchFiles;
     };
 
     /// @brief Open error class
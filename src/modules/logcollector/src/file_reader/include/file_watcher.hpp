@@ -0,0 +1,81 @@
+#pragma once
+
+#include <boost/asio/any_io_executor.hpp>
+#include <boost/asio/awaitable.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace logcollector
+{
+    /// @brief Changes reported by a file watcher
+    enum FileEvent : uint32_t
+    {
+        /// @brief The watched file was written to or its attributes changed
+        FILE_MODIFIED = 1 << 0,
+
+        /// @brief The watched file or directory was moved or deleted, its path may now refer to another one
+        FILE_MOVED = 1 << 1,
+
+        /// @brief An entry was created or moved into the watched directory
+        DIRECTORY_CHANGED = 1 << 2,
+    };
+
+    /// @brief File watcher interface
+    ///
+    /// A file watcher notifies readers about changes in files and directories, so
+    /// that they don't need to poll them. Readers must keep a polling timeout as
+    /// a fallback, since notifications may be lost or unavailable.
+    class IFileWatcher
+    {
+    public:
+        /// @brief Destructor
+        virtual ~IFileWatcher() = default;
+
+        /// @brief Starts watching a file
+        /// @param path File path
+        /// @return Watch descriptor, or -1 if the file cannot be watched
+        virtual int AddFile(const std::string& path) = 0;
+
+        /// @brief Starts watching a directory for new entries
+        /// @param path Directory path
+        /// @return Watch descriptor, or -1 if the directory cannot be watched
+        virtual int AddDirectory(const std::string& path) = 0;
+
+        /// @brief Stops watching a file or directory
+        /// @param wd Watch descriptor
+        virtual void Remove(int wd) = 0;
+
+        /// @brief Reads and dispatches notifications until the watcher is stopped
+        /// @return Awaitable result
+        virtual boost::asio::awaitable<void> Run() = 0;
+
+        /// @brief Waits for changes in a watched file or directory
+        ///
+        /// Returns immediately if changes happened since the last call.
+        ///
+        /// @param wd Watch descriptor. If it is not valid, this behaves like a plain timer
+        /// @param timeout Maximum time to wait
+        /// @return Bitmask of FileEvent, 0 on timeout
+        virtual boost::asio::awaitable<uint32_t> Wait(int wd, std::chrono::milliseconds timeout) = 0;
+
+        /// @brief Takes the names of the entries created or moved into a watched directory
+        /// @param wd Watch descriptor of a directory
+        /// @param names Vector where the names reported since the last call are appended
+        /// @return False if some names may have been lost (e.g. the notification queue
+        ///         overflowed), so the directory must be scanned. True otherwise
+        virtual bool TakeEntries(int wd, std::vector<std::string>& names) = 0;
+
+        /// @brief Stops the watcher and wakes up all waiting coroutines
+        virtual void Stop() = 0;
+    };
+
+    /// @brief Creates the native file watcher of the platform
+    /// @param executor Executor where notifications are read
+    /// @return File watcher, or nullptr if not supported. Readers fall back to polling in that case
+    std::shared_ptr<IFileWatcher> CreateFileWatcher(boost::asio::any_io_executor executor);
+
+} // namespace logcollector
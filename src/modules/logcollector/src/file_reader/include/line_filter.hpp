@@ -0,0 +1,120 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <regex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace logcollector
+{
+    /// @brief Multi-pattern matcher class
+    ///
+    /// Checks whether a line matches any of a set of regular expressions. The
+    /// literal that each pattern requires is extracted, and all literals are
+    /// searched in a single pass with an Aho-Corasick automaton. Only the
+    /// patterns whose literal was found are confirmed with their regular
+    /// expression, and patterns that are plain literals need no confirmation.
+    class MultiPatternMatcher
+    {
+    public:
+        /// @brief Constructor
+        /// @param patterns Regular expressions (ECMAScript syntax)
+        /// @throws std::regex_error if a pattern is not a valid regular expression
+        explicit MultiPatternMatcher(const std::vector<std::string>& patterns);
+
+        /// @brief Checks if a line matches any pattern
+        /// @param line Line to check
+        /// @return True if any pattern matches, false otherwise
+        bool Matches(std::string_view line) const;
+
+        /// @brief Checks if the matcher has no patterns
+        /// @return True if there are no patterns, false otherwise
+        inline bool Empty() const
+        {
+            return m_patterns.empty();
+        }
+
+        /// @brief Gets the literal that any match of a regular expression must contain
+        ///
+        /// The analysis is conservative: it returns the longest run of literal
+        /// characters that is outside of groups, classes and optional repetitions,
+        /// or an empty string if the pattern has alternations.
+        ///
+        /// @param pattern Regular expression
+        /// @return Required literal, or an empty string if none can be extracted
+        static std::string RequiredLiteral(const std::string& pattern);
+
+    private:
+        /// @brief Compiled pattern
+        struct Pattern
+        {
+            /// @brief Regular expression, nullopt if the pattern is a plain literal
+            std::optional<std::regex> regex;
+        };
+
+        /// @brief Adds a literal to the trie of the automaton
+        /// @param literal Literal
+        /// @param id Pattern id
+        void AddLiteral(const std::string& literal, uint32_t id);
+
+        /// @brief Computes the failure transitions and merges the outputs
+        void BuildAutomaton();
+
+        /// @brief Checks if a pattern matches a line
+        /// @param id Pattern id
+        /// @param line Line
+        /// @return True if the pattern matches, false otherwise
+        bool Confirm(uint32_t id, std::string_view line) const;
+
+        /// @brief Compiled patterns
+        std::vector<Pattern> m_patterns;
+
+        /// @brief Ids of the patterns without a literal, which are always confirmed
+        std::vector<uint32_t> m_unfiltered;
+
+        /// @brief Class of each byte, bytes that appear in no literal share class 0
+        std::array<uint16_t, 256> m_byteClass {};
+
+        /// @brief Number of byte classes
+        size_t m_classCount {1};
+
+        /// @brief Transitions of the automaton, m_classCount entries per state
+        std::vector<uint32_t> m_transitions;
+
+        /// @brief Ids of the patterns whose literal ends at each state
+        std::vector<std::vector<uint32_t>> m_outputs;
+
+        /// @brief Whether each state has outputs, kept apart to make the scan loop cheaper
+        std::vector<uint8_t> m_hasOutput;
+    };
+
+    /// @brief Line filter class
+    ///
+    /// Decides which lines of a local file are sent, from a list of include and
+    /// a list of exclude patterns. A line is sent if it matches any include
+    /// pattern (or there are none) and no exclude pattern.
+    class LineFilter
+    {
+    public:
+        /// @brief Constructor
+        /// @param include Patterns of the lines to send, empty to send all lines
+        /// @param exclude Patterns of the lines to discard
+        /// @throws std::regex_error if a pattern is not a valid regular expression
+        LineFilter(const std::vector<std::string>& include, const std::vector<std::string>& exclude);
+
+        /// @brief Checks if a line must be sent
+        /// @param line Line to check
+        /// @return True if the line is accepted, false otherwise
+        bool Accepts(std::string_view line) const;
+
+    private:
+        /// @brief Include patterns
+        MultiPatternMatcher m_include;
+
+        /// @brief Exclude patterns
+        MultiPatternMatcher m_exclude;
+    };
+} // namespace logcollector
@@ -0,0 +1,117 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <line_filter.hpp>
+
+namespace logcollector
+{
+    /// @brief Multiline rule class
+    ///
+    /// Describes how the lines of a local file are joined into events. A line
+    /// begins a new event if it matches a start pattern, or if there are
+    /// continuation patterns and it matches none of them. Any other line is
+    /// appended to the current event.
+    struct MultilineRule
+    {
+        /// @brief Constructor
+        /// @param startPatterns Patterns of the lines that begin an event
+        /// @param continuationPatterns Patterns of the lines that continue an event
+        /// @throws std::regex_error if a pattern is not a valid regular expression
+        MultilineRule(const std::vector<std::string>& startPatterns,
+                      const std::vector<std::string>& continuationPatterns);
+
+        /// @brief Patterns of the lines that begin an event
+        MultiPatternMatcher start;
+
+        /// @brief Patterns of the lines that continue an event
+        MultiPatternMatcher continuation;
+
+        /// @brief Maximum number of lines of an event, the next line begins another event
+        size_t maxLines {500};
+
+        /// @brief Maximum size of an event in bytes, the next line begins another event
+        size_t maxBytes {64 * 1024};
+
+        /// @brief Time to wait for more lines before the last event is sent
+        std::chrono::milliseconds timeout {1000};
+    };
+
+    /// @brief Multiline assembler class
+    ///
+    /// Joins the lines of a local file into events, following a multiline rule.
+    /// Lines are separated by a newline in the event. The event being assembled
+    /// and the last completed event are kept in two buffers that are reused, so
+    /// the memory of each file is bounded by twice the maximum event size.
+    class MultilineAssembler
+    {
+    public:
+        /// @brief Constructor
+        /// @param rule Multiline rule
+        explicit MultilineAssembler(std::shared_ptr<const MultilineRule> rule);
+
+        /// @brief Adds a line to the pending event
+        /// @param line Line
+        /// @param offset Offset of the line in the file
+        /// @return The event completed by this line, or an empty view if the line continues the pending
+        ///         event. The view is valid until the next call to a non-const method
+        std::string_view Add(std::string_view line, uint64_t offset);
+
+        /// @brief Completes the pending event
+        /// @return The pending event, or an empty view if there is none. The view is valid until the
+        ///         next call to a non-const method
+        std::string_view Flush();
+
+        /// @brief Checks if there is an event being assembled
+        /// @return True if there is a pending event, false otherwise
+        inline bool Pending() const
+        {
+            return m_lines > 0;
+        }
+
+        /// @brief Gets the offset of the first line of the pending event
+        ///
+        /// Bookmarks must not go beyond this offset, so that the event is read
+        /// again after a restart.
+        ///
+        /// @return Offset in the file
+        inline uint64_t PendingOffset() const
+        {
+            return m_offset;
+        }
+
+        /// @brief Gets the time left before the pending event must be sent
+        /// @return Time left, zero if it has expired or there is no pending event
+        std::chrono::milliseconds TimeLeft() const;
+
+    private:
+        /// @brief Checks if a line begins a new event
+        /// @param line Line
+        /// @return True if the line begins an event, false if it continues the pending one
+        bool BeginsEvent(std::string_view line) const;
+
+        /// @brief Multiline rule
+        std::shared_ptr<const MultilineRule> m_rule;
+
+        /// @brief Event being assembled
+        std::string m_event;
+
+        /// @brief Last completed event
+        std::string m_completed;
+
+        /// @brief Number of lines of the pending event
+        size_t m_lines {0};
+
+        /// @brief Offset of the first line of the pending event
+        uint64_t m_offset {0};
+
+        /// @brief Time when the last line was added
+        std::chrono::steady_clock::time_point m_lastLine;
+    };
+} // namespace logcollector
@@ -0,0 +1,321 @@
+#include "bookmark_store.hpp"
+
+#include <logger.hpp>
+
+#include <column.hpp>
+#include <persistence_factory.hpp>
+
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+using namespace column;
+
+namespace
+{
+    // database
+    const std::string BOOKMARKS_DB_NAME = "logcollector.db";
+
+    // file_bookmarks table
+    const std::string BOOKMARKS_TABLE_NAME = "file_bookmarks";
+    const std::string BOOKMARKS_PATH_COLUMN_NAME = "path";
+    const std::string BOOKMARKS_DEVICE_COLUMN_NAME = "device";
+    const std::string BOOKMARKS_INODE_COLUMN_NAME = "inode";
+    const std::string BOOKMARKS_OFFSET_COLUMN_NAME = "offset";
+    const std::string BOOKMARKS_HEAD_HASH_COLUMN_NAME = "head_hash";
+
+    // journal_cursors table
+    const std::string CURSORS_TABLE_NAME = "journal_cursors";
+    const std::string CURSORS_READER_COLUMN_NAME = "reader";
+    const std::string CURSORS_CURSOR_COLUMN_NAME = "cursor";
+
+    /// @brief Converts a device or inode number to an SQLite integer
+    ///
+    /// SQLite integers are signed, larger values would be stored as inexact reals.
+    /// They are stored with the same bits instead, and converted back by FromSqliteInteger().
+    std::string ToSqliteInteger(uint64_t value)
+    {
+        return std::to_string(static_cast<int64_t>(value));
+    }
+
+    /// @brief Converts an SQLite integer back to a device or inode number
+    uint64_t FromSqliteInteger(const std::string& value)
+    {
+        return static_cast<uint64_t>(std::stoll(value));
+    }
+
+    /// @brief Builds the row of a bookmark
+    Row BookmarkRow(const std::string& path, const logcollector::FileBookmark& bookmark)
+    {
+        Row fields;
+        fields.emplace_back(BOOKMARKS_PATH_COLUMN_NAME, ColumnType::TEXT, path);
+        fields.emplace_back(BOOKMARKS_DEVICE_COLUMN_NAME, ColumnType::INTEGER, ToSqliteInteger(bookmark.device));
+        fields.emplace_back(BOOKMARKS_INODE_COLUMN_NAME, ColumnType::INTEGER, ToSqliteInteger(bookmark.inode));
+        fields.emplace_back(BOOKMARKS_OFFSET_COLUMN_NAME, ColumnType::INTEGER, std::to_string(bookmark.offset));
+        fields.emplace_back(BOOKMARKS_HEAD_HASH_COLUMN_NAME, ColumnType::TEXT, bookmark.headHash);
+        return fields;
+    }
+} // namespace
+
+namespace logcollector
+{
+    BookmarkStore::BookmarkStore(const std::string& dbFolderPath,
+                                 std::chrono::milliseconds flushInterval,
+                                 std::unique_ptr<Persistence> persistence)
+        : m_flushInterval(flushInterval)
+        , m_lastFlush(std::chrono::steady_clock::now())
+    {
+        const auto dbFilePath = dbFolderPath + "/" + BOOKMARKS_DB_NAME;
+
+        try
+        {
+            if (persistence)
+            {
+                m_dataBase = std::move(persistence);
+            }
+            else
+            {
+                m_dataBase =
+                    PersistenceFactory::CreatePersistence(PersistenceFactory::PersistenceType::SQLITE3, dbFilePath);
+            }
+
+            if (!m_dataBase->TableExists(BOOKMARKS_TABLE_NAME))
+            {
+                Keys columns;
+                columns.emplace_back(BOOKMARKS_PATH_COLUMN_NAME, ColumnType::TEXT, NOT_NULL | PRIMARY_KEY);
+                columns.emplace_back(BOOKMARKS_DEVICE_COLUMN_NAME, ColumnType::INTEGER, NOT_NULL);
+                columns.emplace_back(BOOKMARKS_INODE_COLUMN_NAME, ColumnType::INTEGER, NOT_NULL);
+                columns.emplace_back(BOOKMARKS_OFFSET_COLUMN_NAME, ColumnType::INTEGER, NOT_NULL);
+                columns.emplace_back(BOOKMARKS_HEAD_HASH_COLUMN_NAME, ColumnType::TEXT, NOT_NULL);
+
+                try
+                {
+                    m_dataBase->CreateTable(BOOKMARKS_TABLE_NAME, columns);
+                }
+                catch (std::exception& e)
+                {
+                    LogError("CreateTable operation failed: {}.", e.what());
+                    throw;
+                }
+            }
+
+            if (!m_dataBase->TableExists(CURSORS_TABLE_NAME))
+            {
+                Keys columns;
+                columns.emplace_back(CURSORS_READER_COLUMN_NAME, ColumnType::TEXT, NOT_NULL | PRIMARY_KEY);
+                columns.emplace_back(CURSORS_CURSOR_COLUMN_NAME, ColumnType::TEXT, NOT_NULL);
+
+                try
+                {
+                    m_dataBase->CreateTable(CURSORS_TABLE_NAME, columns);
+                }
+                catch (std::exception& e)
+                {
+                    LogError("CreateTable operation failed: {}.", e.what());
+                    throw;
+                }
+            }
+        }
+        catch (const std::exception&)
+        {
+            throw std::runtime_error(std::string("Cannot open database: " + dbFilePath));
+        }
+    }
+
+    BookmarkStore::~BookmarkStore()
+    {
+        Flush();
+    }
+
+    std::optional<FileBookmark> BookmarkStore::Get(const std::string& path)
+    {
+        const std::lock_guard<std::mutex> lock(m_mutex);
+
+        if (auto it = m_pending.find(path); it != m_pending.end())
+        {
+            return it->second;
+        }
+
+        Criteria filters;
+        filters.emplace_back(BOOKMARKS_PATH_COLUMN_NAME, ColumnType::TEXT, path);
+
+        try
+        {
+            const auto rows = m_dataBase->Select(BOOKMARKS_TABLE_NAME, {}, filters);
+
+            if (rows.empty())
+            {
+                return std::nullopt;
+            }
+
+            FileBookmark bookmark;
+
+            for (const auto& col : rows[0])
+            {
+                if (col.Name == BOOKMARKS_DEVICE_COLUMN_NAME)
+                {
+                    bookmark.device = FromSqliteInteger(col.Value);
+                }
+                else if (col.Name == BOOKMARKS_INODE_COLUMN_NAME)
+                {
+                    bookmark.inode = FromSqliteInteger(col.Value);
+                }
+                else if (col.Name == BOOKMARKS_OFFSET_COLUMN_NAME)
+                {
+                    bookmark.offset = std::stoull(col.Value);
+                }
+                else if (col.Name == BOOKMARKS_HEAD_HASH_COLUMN_NAME)
+                {
+                    bookmark.headHash = col.Value;
+                }
+            }
+
+            return bookmark;
+        }
+        catch (const std::exception& e)
+        {
+            LogError("Select operation failed: {}.", e.what());
+            return std::nullopt;
+        }
+    }
+
+    void BookmarkStore::Set(const std::string& path, const FileBookmark& bookmark)
+    {
+        const std::lock_guard<std::mutex> lock(m_mutex);
+        m_pending[path] = bookmark;
+    }
+
+    void BookmarkStore::Remove(const std::string& path)
+    {
+        const std::lock_guard<std::mutex> lock(m_mutex);
+        m_pending[path] = std::nullopt;
+    }
+
+    std::optional<std::string> BookmarkStore::GetCursor(const std::string& reader)
+    {
+        const std::lock_guard<std::mutex> lock(m_mutex);
+
+        if (auto it = m_pendingCursors.find(reader); it != m_pendingCursors.end())
+        {
+            return it->second;
+        }
+
+        Criteria filters;
+        filters.emplace_back(CURSORS_READER_COLUMN_NAME, ColumnType::TEXT, reader);
+
+        try
+        {
+            const auto rows = m_dataBase->Select(CURSORS_TABLE_NAME, {}, filters);
+
+            for (const auto& row : rows)
+            {
+                for (const auto& col : row)
+                {
+                    if (col.Name == CURSORS_CURSOR_COLUMN_NAME)
+                    {
+                        return col.Value;
+                    }
+                }
+            }
+        }
+        catch (const std::exception& e)
+        {
+            LogError("Select operation failed: {}.", e.what());
+        }
+
+        return std::nullopt;
+    }
+
+    void BookmarkStore::SetCursor(const std::string& reader, const std::string& cursor)
+    {
+        const std::lock_guard<std::mutex> lock(m_mutex);
+        m_pendingCursors[reader] = cursor;
+    }
+
+    void BookmarkStore::FlushIfDue()
+    {
+        {
+            const std::lock_guard<std::mutex> lock(m_mutex);
+
+            if (std::chrono::steady_clock::now() - m_lastFlush < m_flushInterval)
+            {
+                return;
+            }
+        }
+
+        Flush();
+    }
+
+    bool BookmarkStore::Flush()
+    {
+        const std::lock_guard<std::mutex> lock(m_mutex);
+        m_lastFlush = std::chrono::steady_clock::now();
+
+        if (m_pending.empty() && m_pendingCursors.empty())
+        {
+            return true;
+        }
+
+        TransactionId transaction = 0;
+
+        // Handle the exception separately since it would not be necessary to perform RollBack.
+        try
+        {
+            transaction = m_dataBase->BeginTransaction();
+        }
+        catch (const std::exception& e)
+        {
+            LogError("Failed to begin transaction: {}.", e.what());
+            return false;
+        }
+
+        try
+        {
+            for (const auto& [path, bookmark] : m_pending)
+            {
+                Criteria filters;
+                filters.emplace_back(BOOKMARKS_PATH_COLUMN_NAME, ColumnType::TEXT, path);
+                m_dataBase->Remove(BOOKMARKS_TABLE_NAME, filters);
+
+                if (bookmark.has_value())
+                {
+                    m_dataBase->Insert(BOOKMARKS_TABLE_NAME, BookmarkRow(path, *bookmark));
+                }
+            }
+
+            for (const auto& [reader, cursor] : m_pendingCursors)
+            {
+                Criteria filters;
+                filters.emplace_back(CURSORS_READER_COLUMN_NAME, ColumnType::TEXT, reader);
+                m_dataBase->Remove(CURSORS_TABLE_NAME, filters);
+
+                Row fields;
+                fields.emplace_back(CURSORS_READER_COLUMN_NAME, ColumnType::TEXT, reader);
+                fields.emplace_back(CURSORS_CURSOR_COLUMN_NAME, ColumnType::TEXT, cursor);
+                m_dataBase->Insert(CURSORS_TABLE_NAME, fields);
+            }
+
+            m_dataBase->CommitTransaction(transaction);
+        }
+        catch (const std::exception& e)
+        {
+            LogError("Flush operation failed: {}.", e.what());
+
+            try
+            {
+                m_dataBase->RollbackTransaction(transaction);
+            }
+            catch (const std::exception& ee)
+            {
+                LogError("Rollback failed: {}.", ee.what());
+            }
+
+            return false;
+        }
+
+        m_pending.clear();
+        m_pendingCursors.clear();
+        return true;
+    }
+} // namespace logcollector
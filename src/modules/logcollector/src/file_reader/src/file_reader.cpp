@@ -1,105 +1,575 @@
 #include "file_reader.hpp"
 
 #include <config.h>
+#include <hashHelper.h>
 #include <logcollector.hpp>
 #include <logger.hpp>
+#include <stringHelper.h>
+
+#include <boost/asio/this_coro.hpp>
 
 #include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <limits>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <utility>
+#include <vector>
 
 using namespace logcollector;
 
+namespace
+{
+    /// @brief Maximum number of bytes hashed to identify the content of a file
+    constexpr uint64_t HEAD_HASH_SIZE = 1024;
+
+    /// @brief Number of bytes requested to the file on each read
+    constexpr size_t READ_BLOCK_SIZE = 64 * 1024;
+
+    /// @brief Maximum length of a log, longer lines are truncated
+    constexpr size_t MAX_LINE_SIZE = config::logcollector::BUFFER_SIZE - 1;
+
+    /// @brief Maximum number of logs sent to the queue in a single push
+    constexpr size_t MAX_BATCH_SIZE = 512;
+
+    /// @brief Number of read intervals to wait for a rotated file to be created again
+    constexpr int MAX_REOPEN_RETRIES = 10;
+
+    /// @brief First delay in milliseconds to open a rotated file again, it doubles up to the read interval
+    constexpr std::time_t REOPEN_DELAY = 1;
+
+    /// @brief Number of times a file is opened again when its path is rotated while opening it
+    constexpr int MAX_OPEN_ATTEMPTS = 3;
+
+    /// @brief Suffix that logrotate and newsyslog give to the last rotated file
+    const std::string ROTATED_FILE_SUFFIX = ".1";
+
+    /// @brief Number of reload intervals between full scans of a watched directory
+    constexpr std::time_t DIRECTORY_RESCAN_FACTOR = 10;
+
+    /// @brief Identity of a file whose device and inode are not known
+    constexpr std::pair<uint64_t, uint64_t> UNKNOWN_IDENTITY {0, 0};
+
+    /// @brief Gets the directory where new files matching a pattern are created
+    /// @param pattern File pattern
+    /// @return Directory path, or an empty string if the directory itself contains wildcards
+    std::string PatternDirectory(const std::string& pattern)
+    {
+        const auto separator = pattern.find_last_of("/\\");
+
+        if (separator == std::string::npos)
+        {
+            return ".";
+        }
+
+        auto directory = pattern.substr(0, separator == 0 ? 1 : separator);
+        return directory.find_first_of("*?[") == std::string::npos ? directory : std::string();
+    }
+} // namespace
+
 FileReader::FileReader(Logcollector& logcollector,
                        std::string pattern,
                        std::time_t fileWait,
-                       std::time_t reloadInterval)
+                       std::time_t reloadInterval,
+                       std::shared_ptr<BookmarkStore> bookmarks,
+                       std::shared_ptr<const LineFilter> filter,
+                       std::shared_ptr<const MultilineRule> multiline,
+                       bool watchFiles)
     : IReader(logcollector)
     , m_filePattern(std::move(pattern))
     , m_localfiles()
     , m_fileWait(fileWait)
     , m_reloadInterval(reloadInterval)
+    , m_bookmarks(std::move(bookmarks))
+    , m_filter(std::move(filter))
+    , m_multiline(std::move(multiline))
+    , m_watchFiles(watchFiles)
 {
 }
 
 Awaitable FileReader::Run()
 {
+    auto executor = co_await boost::asio::this_coro::executor;
+    const auto directory = PatternDirectory(m_filePattern);
+    int directoryWatch = -1;
+    bool rescan = true;
+    bool startup = true;
+    std::vector<std::string> entries;
+
+    {
+        const std::lock_guard<std::mutex> lock(m_watcherMutex);
+
+        if (m_keepRunning.load() && m_watchFiles)
+        {
+            m_watcher = m_logcollector.FileWatcher(executor);
+        }
+    }
+
+    // New files are started after the list is unlocked, since the rest of a rotated file may need to wait for the queue
+    std::vector<Localfile*> added;
+    const auto callback = [&added](Localfile& lf)
+    {
+        added.push_back(&lf);
+    };
+
     while (m_keepRunning.load())
     {
-        Reload(
-            [&](Localfile& lf)
-            {
-                lf.SeekEnd();
-                m_logcollector.EnqueueTask(ReadLocalfile(&lf));
-            });
+        // The watch is added before scanning, so that no entry created in between is missed
+        if (m_watcher && directoryWatch < 0 && !directory.empty())
+        {
+            directoryWatch = m_watcher->AddDirectory(directory);
+        }
+
+        if (rescan)
+        {
+            Reload(callback);
+        }
+        else
+        {
+            ReloadEntries(entries, callback);
+        }
+
+        entries.clear();
+
+        for (auto* lf : added)
+        {
+            co_await SetStartPosition(*lf, startup);
+            m_logcollector.EnqueueTask(ReadLocalfile(lf));
+        }
 
-        co_await m_logcollector.Wait(std::chrono::milliseconds(m_reloadInterval));
+        added.clear();
+        startup = false;
+
+        if (directoryWatch < 0)
+        {
+            co_await WaitForChanges(directoryWatch, m_reloadInterval);
+            continue;
+        }
+
+        // Notifications report the new entries, the directory is only scanned if some may have been lost
+        const auto events = co_await WaitForChanges(directoryWatch, m_reloadInterval * DIRECTORY_RESCAN_FACTOR);
+
+        if ((events & FILE_MOVED) != 0)
+        {
+            m_watcher->Remove(directoryWatch);
+            directoryWatch = -1;
+            rescan = true;
+        }
+        else
+        {
+            rescan = events == 0 || !m_watcher->TakeEntries(directoryWatch, entries);
+        }
+    }
+
+    if (m_watcher)
+    {
+        m_watcher->Remove(directoryWatch);
     }
 }
 
 void FileReader::Stop()
 {
     m_keepRunning.store(false);
+
+    // Waits until Run() took the watcher, so that the module stops it after its readers
+    const std::lock_guard<std::mutex> lock(m_watcherMutex);
 }
 
 Awaitable FileReader::ReadLocalfile(Localfile* lf)
 {
+    auto wd = m_watcher ? m_watcher->AddFile(lf->Filename()) : -1;
+    auto savedOffset = lf->Offset();
+    uint32_t events = 0;
+    bool reopenPending = false;
+    int reopenRetries = 0;
+    std::time_t reopenWaited = 0;
+    std::vector<std::string> logs;
+    std::unique_ptr<MultilineAssembler> assembler;
+
+    if (m_multiline)
+    {
+        assembler = std::make_unique<MultilineAssembler>(m_multiline);
+    }
+
     while (m_keepRunning.load())
     {
-        auto log = lf->NextLog();
+        // The bookmark is only saved once the logs are in the queue, so undelivered logs are read again
+        if (!co_await SendLogs(*lf, lf->Filename(), logs, assembler.get()))
+        {
+            break;
+        }
+
+        const auto offset = assembler && assembler->Pending() ? assembler->PendingOffset() : lf->Offset();
 
-        while (!log.empty())
+        if (offset != savedOffset)
         {
-            m_logcollector.SendMessage(lf->Filename(), log, m_collectorType);
-            log = lf->NextLog();
+            savedOffset = offset;
+            SaveBookmark(*lf, assembler.get());
         }
 
+        if (m_bookmarks)
+        {
+            m_bookmarks->FlushIfDue();
+        }
+
+        bool inaccessible = false;
+
         try
         {
-            if (lf->Rotated())
+            if (!reopenPending && ((events & FILE_MOVED) != 0 || lf->Rotated()))
             {
                 LogInfo("File '{}' rotated, reloading", lf->Filename());
-                lf->Reopen();
+                reopenPending = true;
             }
         }
         catch (OpenError&)
         {
-            LogInfo("File inaccesible: {}", lf->Filename());
-            co_return;
+            // The path is missing between the rename of a rotation and the creation of the new file
+            reopenPending = true;
         }
 
-        co_await m_logcollector.Wait(std::chrono::milliseconds(m_fileWait));
+        if (reopenPending)
+        {
+            // The old file is still open: read what was written to it between the last read and the rotation
+            if (reopenRetries == 0 && !co_await SendLogs(*lf, lf->Filename(), logs, assembler.get(), true))
+            {
+                break;
+            }
+
+            try
+            {
+                const auto previous = lf->Identity();
+                lf->Reopen();
+                ReindexLocalfile(*lf, previous);
+                reopenPending = false;
+                reopenRetries = 0;
+                reopenWaited = 0;
+                savedOffset = lf->Offset();
+                SaveBookmark(*lf);
+
+                if (m_watcher)
+                {
+                    m_watcher->Remove(wd);
+                    wd = m_watcher->AddFile(lf->Filename());
+                }
+            }
+            catch (OpenError&)
+            {
+                // After a rename, the new file is usually created right away
+                inaccessible = ++reopenRetries > MAX_REOPEN_RETRIES && reopenWaited >= MAX_REOPEN_RETRIES * m_fileWait;
+            }
+
+            if (!reopenPending)
+            {
+                // The new file may have been written before it was watched, so it is read right away
+                events = 0;
+                continue;
+            }
+        }
+
+        if (inaccessible)
+        {
+            if (co_await SendLogs(*lf, lf->Filename(), logs, assembler.get(), true))
+            {
+                LogInfo("File inaccesible: {}", lf->Filename());
+
+                if (m_bookmarks)
+                {
+                    m_bookmarks->Remove(lf->Filename());
+                }
+            }
+
+            break;
+        }
+
+        // A pending event is sent when its timeout expires, even if the file does not change
+        const auto watch = reopenPending ? -1 : wd;
+        auto maxWait = std::numeric_limits<std::time_t>::max();
+
+        if (assembler && assembler->Pending())
+        {
+            maxWait = assembler->TimeLeft().count();
+        }
+
+        // Waiting a whole read interval for the new file could miss the next rotation of a busy file
+        auto pollInterval = m_fileWait;
+
+        if (reopenPending)
+        {
+            pollInterval = std::min(m_fileWait, REOPEN_DELAY << std::min(reopenRetries, MAX_REOPEN_RETRIES));
+            reopenWaited += pollInterval;
+        }
+
+        events = co_await WaitForChanges(watch, pollInterval, maxWait);
+    }
+
+    if (m_watcher)
+    {
+        m_watcher->Remove(wd);
     }
 
     RemoveLocalfile(lf->Filename());
 }
 
+boost::asio::awaitable<bool> FileReader::SendLogs(Localfile& lf,
+                                                  const std::string& location,
+                                                  std::vector<std::string>& logs,
+                                                  MultilineAssembler* assembler,
+                                                  bool flush)
+{
+    logs.clear();
+
+    while (true)
+    {
+        const auto offset = lf.Offset();
+        const auto line = lf.NextLog();
+
+        if (line.empty())
+        {
+            break;
+        }
+
+        // The filter sees whole events, so that a pattern may match any line of a multiline event
+        const auto log = assembler ? assembler->Add(line, offset) : line;
+
+        if (log.empty() || (m_filter && !m_filter->Accepts(log)))
+        {
+            continue;
+        }
+
+        logs.emplace_back(log);
+
+        if (logs.size() == MAX_BATCH_SIZE)
+        {
+            if (!co_await DeliverLogs(location, logs, m_collectorType))
+            {
+                co_return false;
+            }
+
+            logs.clear();
+        }
+    }
+
+    if (assembler && (flush || assembler->TimeLeft().count() == 0))
+    {
+        if (const auto log = assembler->Flush(); !log.empty() && (!m_filter || m_filter->Accepts(log)))
+        {
+            logs.emplace_back(log);
+        }
+    }
+
+    if (!logs.empty())
+    {
+        if (!co_await DeliverLogs(location, logs, m_collectorType))
+        {
+            co_return false;
+        }
+
+        logs.clear();
+    }
+
+    co_return true;
+}
+
+boost::asio::awaitable<void> FileReader::SetStartPosition(Localfile& lf, bool startup)
+{
+    if (m_bookmarks)
+    {
+        if (const auto bookmark = m_bookmarks->Get(lf.Filename()); bookmark.has_value())
+        {
+            if (lf.Resume(*bookmark))
+            {
+                LogDebug("Resuming file '{}' at offset {}.", lf.Filename(), bookmark->offset);
+            }
+            else
+            {
+                co_await ReadRotatedFile(lf.Filename(), *bookmark);
+                LogInfo("File '{}' changed since it was last read, reading it from the beginning.", lf.Filename());
+            }
+
+            co_return;
+        }
+    }
+
+    // A file that shows up later was created while it was being watched, all of it is new
+    if (startup)
+    {
+        lf.SeekEnd();
+    }
+
+    SaveBookmark(lf);
+}
+
+boost::asio::awaitable<void> FileReader::ReadRotatedFile(const std::string& path, const FileBookmark& bookmark)
+{
+    std::unique_ptr<Localfile> rotated;
+
+    try
+    {
+        rotated = std::make_unique<Localfile>(path + ROTATED_FILE_SUFFIX);
+    }
+    catch (OpenError&)
+    {
+        // No rotated file, the rest of the old file is lost
+        co_return;
+    }
+
+    if (rotated->Resume(bookmark))
+    {
+        LogInfo("File '{}' was rotated while it was not being read, reading the rest of '{}'.",
+                path,
+                rotated->Filename());
+
+        std::vector<std::string> logs;
+        std::unique_ptr<MultilineAssembler> assembler;
+
+        if (m_multiline)
+        {
+            assembler = std::make_unique<MultilineAssembler>(m_multiline);
+        }
+
+        co_await SendLogs(*rotated, path, logs, assembler.get(), true);
+    }
+}
+
+void FileReader::SaveBookmark(Localfile& lf, const MultilineAssembler* assembler)
+{
+    if (m_bookmarks)
+    {
+        m_bookmarks->Set(lf.Filename(),
+                         assembler && assembler->Pending() ? lf.Bookmark(assembler->PendingOffset()) : lf.Bookmark());
+    }
+}
+
+boost::asio::awaitable<uint32_t> FileReader::WaitForChanges(int wd, std::time_t pollInterval, std::time_t maxWait)
+{
+    if (m_watcher && wd >= 0)
+    {
+        // Notifications drive the reads, the timeout only guards against lost events
+        co_return co_await m_watcher->Wait(
+            wd, std::chrono::milliseconds(std::min(std::max(pollInterval, m_reloadInterval), maxWait)));
+    }
+
+    co_await m_logcollector.Wait(std::chrono::milliseconds(std::min(pollInterval, maxWait)));
+    co_return 0;
+}
+
+void FileReader::ReloadEntries(const std::vector<std::string>& names, const std::function<void(Localfile&)>& callback)
+{
+    // The directory of the pattern has no wildcards, so it is the same prefix that the full scan gives
+    const auto prefix = m_filePattern.substr(0, m_filePattern.find_last_of("/\\") + 1);
+    std::list<std::string> paths;
+
+    for (const auto& name : names)
+    {
+        auto path = prefix + name;
+
+        if (MatchesPattern(path))
+        {
+            paths.push_back(std::move(path));
+        }
+    }
+
+    if (!paths.empty())
+    {
+        AddLocalfiles(paths, callback);
+    }
+}
+
 void FileReader::AddLocalfiles(const std::list<std::string>& paths, const std::function<void(Localfile&)>& callback)
 {
-    for (auto& path : paths)
+    const std::lock_guard<std::mutex> lock(m_localfilesMutex);
+
+    for (const auto& path : paths)
     {
-        if (none_of(m_localfiles.begin(), m_localfiles.end(), [&path](Localfile& lf) { return lf.Filename() == path; }))
+        if (m_localfilesByPath.contains(path))
+        {
+            continue;
+        }
+
+        std::list<Localfile>::iterator it;
+
+        try
+        {
+            it = m_localfiles.emplace(m_localfiles.end(), path);
+        }
+        catch (OpenError&)
+        {
+            // The file was deleted right after it was found
+            LogDebug("Cannot open new log file: {}", path);
+            continue;
+        }
+
+        const auto identity = it->Identity();
+
+        if (identity != UNKNOWN_IDENTITY)
         {
-            m_localfiles.emplace_back(path);
-            LogInfo("Reading log file: {}", m_localfiles.back().Filename());
-            callback(m_localfiles.back());
+            const auto [alias, inserted] = m_pathsByIdentity.try_emplace(identity, path);
+
+            if (!inserted)
+            {
+                LogDebug("File '{}' is the same as '{}', skipping it.", path, alias->second);
+                m_localfiles.erase(it);
+                continue;
+            }
         }
+
+        m_localfilesByPath.emplace(path, it);
+        LogInfo("Reading log file: {}", it->Filename());
+        callback(*it);
+    }
+}
+
+void FileReader::ReindexLocalfile(const Localfile& lf, const std::pair<uint64_t, uint64_t>& previous)
+{
+    const std::lock_guard<std::mutex> lock(m_localfilesMutex);
+
+    if (auto it = m_pathsByIdentity.find(previous); it != m_pathsByIdentity.end() && it->second == lf.Filename())
+    {
+        m_pathsByIdentity.erase(it);
+    }
+
+    if (lf.Identity() != UNKNOWN_IDENTITY)
+    {
+        m_pathsByIdentity.try_emplace(lf.Identity(), lf.Filename());
     }
 }
 
 void FileReader::RemoveLocalfile(const std::string& filename)
 {
-    m_localfiles.remove_if([&filename](Localfile& lf) { return lf.Filename() == filename; });
+    const std::lock_guard<std::mutex> lock(m_localfilesMutex);
+    auto it = m_localfilesByPath.find(filename);
+
+    if (it == m_localfilesByPath.end())
+    {
+        return;
+    }
+
+    // The name may belong to the local file, so it is erased last
+    const auto localfile = it->second;
+    m_localfilesByPath.erase(it);
+
+    if (auto alias = m_pathsByIdentity.find(localfile->Identity());
+        alias != m_pathsByIdentity.end() && alias->second == localfile->Filename())
+    {
+        m_pathsByIdentity.erase(alias);
+    }
+
+    m_localfiles.erase(localfile);
 }
 
 Localfile::Localfile(std::string filename)
     : m_filename(std::move(filename))
-    , m_stream(make_shared<std::ifstream>(m_filename))
-    , m_pos()
+    , m_stream(make_shared<std::ifstream>(m_filename, std::ios::binary))
 {
     if (m_stream->fail())
     {
         throw OpenError(m_filename);
     }
+
+    UpdateIdentity();
 }
 
 Localfile::Localfile(std::shared_ptr<std::istream> stream)
@@ -108,35 +578,189 @@ Localfile::Localfile(std::shared_ptr<std::istream> stream)
 {
 }
 
-std::string Localfile::NextLog()
+std::string_view Localfile::NextLog()
+{
+    while (true)
+    {
+        const auto* begin = m_buffer.data() + m_begin;
+        const auto* newline =
+            m_end > m_begin ? static_cast<const char*>(std::memchr(begin, '\n', m_end - m_begin)) : nullptr;
+
+        if (newline != nullptr)
+        {
+            auto length = static_cast<size_t>(newline - begin);
+            m_begin += length + 1;
+            m_pos += length + 1;
+
+            if (std::exchange(m_discarding, false))
+            {
+                continue;
+            }
+
+            if (length > 0 && begin[length - 1] == '\r')
+            {
+                --length;
+            }
+
+            if (length > MAX_LINE_SIZE)
+            {
+                LogWarn("Line longer than {} bytes in file '{}', truncating it.", MAX_LINE_SIZE, m_filename);
+                length = MAX_LINE_SIZE;
+            }
+
+            if (length > 0)
+            {
+                return {begin, length};
+            }
+
+            continue;
+        }
+
+        const auto pending = m_end - m_begin;
+
+        if (m_discarding)
+        {
+            m_begin = m_end;
+            m_pos += pending;
+        }
+        else if (pending >= MAX_LINE_SIZE)
+        {
+            LogWarn("Line longer than {} bytes in file '{}', truncating it.", MAX_LINE_SIZE, m_filename);
+            m_begin += MAX_LINE_SIZE;
+            m_pos += MAX_LINE_SIZE;
+            m_discarding = true;
+            return {begin, MAX_LINE_SIZE};
+        }
+
+        if (!FillBuffer())
+        {
+            return {};
+        }
+    }
+}
+
+bool Localfile::FillBuffer()
 {
-    auto buffer = std::vector<char>(config::logcollector::BUFFER_SIZE);
+    if (m_buffer.empty())
+    {
+        m_buffer.resize(READ_BLOCK_SIZE + MAX_LINE_SIZE);
+    }
 
-    if (m_stream->getline(buffer.data(), config::logcollector::BUFFER_SIZE).good())
+    if (m_begin > 0)
     {
-        m_pos = m_stream->tellg();
-        return {buffer.data(), static_cast<size_t>(m_stream->gcount()) - 1};
+        std::memmove(m_buffer.data(), m_buffer.data() + m_begin, m_end - m_begin);
+        m_end -= m_begin;
+        m_begin = 0;
     }
-    else
+
+    // Go through the stream buffer to skip the sentry and the state flags, so that
+    // reaching the end of the file does not need to be cleared
+    const auto count = m_stream->rdbuf()->sgetn(m_buffer.data() + m_end,
+                                                static_cast<std::streamsize>(m_buffer.size() - m_end));
+
+    if (count <= 0)
     {
-        m_stream->seekg(m_pos);
-        m_stream->clear();
-        return {};
+        return false;
     }
+
+    m_end += static_cast<size_t>(count);
+    m_readPos += static_cast<uint64_t>(count);
+    return true;
+}
+
+void Localfile::ResetBuffer(uint64_t offset)
+{
+    m_pos = offset;
+    m_readPos = offset;
+    m_begin = 0;
+    m_end = 0;
+    m_discarding = false;
 }
 
 void Localfile::SeekEnd()
 {
-    m_stream->seekg(0, std::ios::end);
+    const auto end = m_stream->rdbuf()->pubseekoff(0, std::ios::end, std::ios::in);
+    ResetBuffer(end == std::streampos(-1) ? 0 : static_cast<uint64_t>(end));
+}
+
+FileBookmark Localfile::Bookmark(uint64_t offset)
+{
+    const auto headSize = std::min(offset, HEAD_HASH_SIZE);
+
+    if (headSize != m_headHashSize || m_headHash.empty())
+    {
+        m_headHash = HeadHash(headSize);
+        m_headHashSize = headSize;
+    }
+
+    return {m_device, m_inode, offset, m_headHash};
+}
+
+bool Localfile::Resume(const FileBookmark& bookmark)
+{
+    if (bookmark.device != m_device || bookmark.inode != m_inode)
+    {
+        return false;
+    }
+
+    std::error_code ec;
+    const auto fileSize = std::filesystem::file_size(m_filename, ec);
+
+    if (ec || fileSize < bookmark.offset)
+    {
+        return false;
+    }
+
+    const auto headSize = std::min(bookmark.offset, HEAD_HASH_SIZE);
+    auto headHash = HeadHash(headSize);
+
+    if (headHash != bookmark.headHash)
+    {
+        return false;
+    }
+
+    m_stream->rdbuf()->pubseekpos(static_cast<std::streamoff>(bookmark.offset), std::ios::in);
+    ResetBuffer(bookmark.offset);
+    m_headHash = std::move(headHash);
+    m_headHashSize = headSize;
+    return true;
+}
+
+std::string Localfile::HeadHash(uint64_t size) const
+{
+    std::ifstream file(m_filename, std::ios::binary);
+    auto buffer = std::vector<char>(size);
+
+    if (!file.read(buffer.data(), static_cast<std::streamsize>(size)))
+    {
+        return {};
+    }
+
+    Utils::HashData hash(Utils::HashType::Sha1);
+    hash.update(buffer.data(), buffer.size());
+    return Utils::asciiToHex(hash.hash());
 }
 
 bool Localfile::Rotated()
 {
+    uint64_t device = 0;
+    uint64_t inode = 0;
+
+    if (!ReadIdentity(device, inode))
+    {
+        throw OpenError(m_filename);
+    }
+
+    // The path refers to another file, even if it already grew beyond the reading position
+    if (device != m_device || inode != m_inode)
+    {
+        return true;
+    }
+
     try
     {
         auto fileSize = std::filesystem::file_size(m_filename);
-        auto streamSize = static_cast<uintmax_t>(m_stream->tellg());
-        return fileSize < streamSize;
+        return fileSize < m_readPos;
     }
     catch (std::filesystem::filesystem_error&)
     {
@@ -146,11 +770,39 @@ bool Localfile::Rotated()
 
 void Localfile::Reopen()
 {
-    m_stream = std::make_shared<std::ifstream>(m_filename);
+    // The identity is read from the path, so if the file is rotated again while it is being opened, the stream
+    // could belong to another file than the identity and the next rotation would go unnoticed
+    for (int attempt = 1; attempt <= MAX_OPEN_ATTEMPTS; ++attempt)
+    {
+        uint64_t device = 0;
+        uint64_t inode = 0;
+        const auto known = ReadIdentity(device, inode);
 
-    if (m_stream->fail())
+        m_stream = std::make_shared<std::ifstream>(m_filename, std::ios::binary);
+        ResetBuffer(0);
+        m_headHash.clear();
+        m_headHashSize = 0;
+
+        if (m_stream->fail())
+        {
+            throw OpenError(m_filename);
+        }
+
+        UpdateIdentity();
+
+        if (known && device == m_device && inode == m_inode)
+        {
+            break;
+        }
+    }
+}
+
+void Localfile::UpdateIdentity()
+{
+    if (!ReadIdentity(m_device, m_inode))
     {
-        throw OpenError(m_filename);
+        m_device = 0;
+        m_inode = 0;
     }
 }
 
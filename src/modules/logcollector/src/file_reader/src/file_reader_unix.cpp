@@ -1,8 +1,10 @@
 #include "file_reader.hpp"
 
+#include <fnmatch.h>
 #include <glob.h>
 #include <logcollector.hpp>
 #include <logger.hpp>
+#include <sys/stat.h>
 
 #include <span>
 
@@ -40,3 +42,23 @@ void FileReader::Reload(const std::function<void(Localfile&)>& callback)
     AddLocalfiles(localfiles, callback);
     globfree(&globResult);
 }
+
+bool FileReader::MatchesPattern(const std::string& path) const
+{
+    // Same rules as glob(): wildcards do not match slashes nor a leading dot
+    return fnmatch(m_filePattern.c_str(), path.c_str(), FNM_PATHNAME | FNM_PERIOD) == 0;
+}
+
+bool Localfile::ReadIdentity(uint64_t& device, uint64_t& inode) const
+{
+    struct stat fileStat {};
+
+    if (stat(m_filename.c_str(), &fileStat) != 0)
+    {
+        return false;
+    }
+
+    device = static_cast<uint64_t>(fileStat.st_dev);
+    inode = static_cast<uint64_t>(fileStat.st_ino);
+    return true;
+}
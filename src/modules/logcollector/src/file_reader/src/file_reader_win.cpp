@@ -7,6 +7,8 @@
 #include <string>
 #include <windows.h>
 
+#include <shlwapi.h>
+
 using namespace logcollector;
 
 void FileReader::Reload(const std::function<void(Localfile&)>& callback)
@@ -39,3 +41,36 @@ void FileReader::Reload(const std::function<void(Localfile&)>& callback)
     AddLocalfiles(files, callback);
     FindClose(hFind);
 }
+
+bool FileReader::MatchesPattern(const std::string& path) const
+{
+    return PathMatchSpecA(path.c_str(), m_filePattern.c_str()) != FALSE;
+}
+
+bool Localfile::ReadIdentity(uint64_t& device, uint64_t& inode) const
+{
+    HANDLE hFile = CreateFile(m_filename.c_str(),
+                              0,
+                              FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+                              nullptr,
+                              OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL,
+                              nullptr);
+
+    if (hFile == INVALID_HANDLE_VALUE)
+    {
+        return false;
+    }
+
+    BY_HANDLE_FILE_INFORMATION fileInfo;
+    const bool success = GetFileInformationByHandle(hFile, &fileInfo) != 0;
+
+    if (success)
+    {
+        device = fileInfo.dwVolumeSerialNumber;
+        inode = (static_cast<uint64_t>(fileInfo.nFileIndexHigh) << 32) | fileInfo.nFileIndexLow;
+    }
+
+    CloseHandle(hFile);
+    return success;
+}
@@ -0,0 +1,370 @@
+#include "file_watcher.hpp"
+
+#if defined(__linux__)
+
+#include <logger.hpp>
+
+#include <boost/asio/buffer.hpp>
+#include <boost/asio/post.hpp>
+#include <boost/asio/posix/stream_descriptor.hpp>
+#include <boost/asio/redirect_error.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <boost/asio/use_awaitable.hpp>
+
+#include <sys/inotify.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#include <iterator>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace
+{
+    constexpr uint32_t FILE_MASK = IN_MODIFY | IN_ATTRIB | IN_MOVE_SELF | IN_DELETE_SELF;
+    constexpr uint32_t DIRECTORY_MASK = IN_CREATE | IN_MOVED_TO | IN_MOVE_SELF | IN_DELETE_SELF | IN_ONLYDIR;
+    constexpr size_t EVENT_BUFFER_SIZE = 64 * 1024;
+
+    /// @brief Maximum number of entry names kept for a directory, beyond it the directory must be scanned
+    constexpr size_t MAX_PENDING_ENTRIES = 4096;
+
+    /// @brief Translates an inotify mask into FileEvent flags
+    uint32_t ToFileEvents(uint32_t mask)
+    {
+        uint32_t events = 0;
+
+        if (mask & (IN_MODIFY | IN_ATTRIB))
+        {
+            events |= logcollector::FILE_MODIFIED;
+        }
+
+        if (mask & (IN_MOVE_SELF | IN_DELETE_SELF | IN_IGNORED))
+        {
+            events |= logcollector::FILE_MOVED;
+        }
+
+        if (mask & (IN_CREATE | IN_MOVED_TO))
+        {
+            events |= logcollector::DIRECTORY_CHANGED;
+        }
+
+        return events;
+    }
+
+    /// @brief inotify based file watcher
+    ///
+    /// The inotify file descriptor is wrapped in a stream descriptor, so that
+    /// notifications are read asynchronously by the io_context that runs the readers.
+    class InotifyWatcher
+        : public logcollector::IFileWatcher
+        , public std::enable_shared_from_this<InotifyWatcher>
+    {
+    public:
+        InotifyWatcher(boost::asio::any_io_executor executor, int fd)
+            : m_descriptor(std::move(executor), fd)
+        {
+        }
+
+        int AddFile(const std::string& path) override
+        {
+            return AddWatch(path, FILE_MASK);
+        }
+
+        int AddDirectory(const std::string& path) override
+        {
+            return AddWatch(path, DIRECTORY_MASK);
+        }
+
+        void Remove(int wd) override
+        {
+            if (wd < 0)
+            {
+                return;
+            }
+
+            const std::lock_guard<std::mutex> lock(m_mutex);
+            auto it = m_watches.find(wd);
+
+            if (it != m_watches.end() && --it->second.references == 0)
+            {
+                CancelWaiters(it->second);
+                m_watches.erase(it);
+                inotify_rm_watch(m_descriptor.native_handle(), wd);
+            }
+        }
+
+        boost::asio::awaitable<void> Run() override
+        {
+            std::vector<char> buffer(EVENT_BUFFER_SIZE);
+            const auto executor = co_await boost::asio::this_coro::executor;
+
+            {
+                // The descriptor is closed on this executor, so that it never races with the reads
+                const std::lock_guard<std::mutex> lock(m_mutex);
+
+                if (m_stopped)
+                {
+                    co_return;
+                }
+
+                m_runExecutor = executor;
+            }
+
+            while (true)
+            {
+                boost::system::error_code ec;
+                const auto length = co_await m_descriptor.async_read_some(
+                    boost::asio::buffer(buffer), boost::asio::redirect_error(boost::asio::use_awaitable, ec));
+
+                if (ec)
+                {
+                    if (ec != boost::asio::error::operation_aborted && ec != boost::asio::error::bad_descriptor)
+                    {
+                        LogWarn("Cannot read file notifications: {}.", ec.message());
+                    }
+
+                    break;
+                }
+
+                Dispatch(buffer.data(), length);
+            }
+        }
+
+        boost::asio::awaitable<uint32_t> Wait(int wd, std::chrono::milliseconds timeout) override
+        {
+            auto executor = co_await boost::asio::this_coro::executor;
+            auto timer = std::make_shared<boost::asio::steady_timer>(executor, timeout);
+
+            {
+                const std::lock_guard<std::mutex> lock(m_mutex);
+
+                if (m_stopped)
+                {
+                    co_return 0;
+                }
+
+                auto it = m_watches.find(wd);
+
+                if (it != m_watches.end())
+                {
+                    if (it->second.events != 0)
+                    {
+                        co_return std::exchange(it->second.events, 0);
+                    }
+
+                    it->second.waiters.push_back(timer);
+                }
+            }
+
+            boost::system::error_code ec;
+            co_await timer->async_wait(boost::asio::redirect_error(boost::asio::use_awaitable, ec));
+
+            const std::lock_guard<std::mutex> lock(m_mutex);
+            auto it = m_watches.find(wd);
+
+            if (it == m_watches.end())
+            {
+                co_return 0;
+            }
+
+            it->second.waiters.remove(timer);
+            co_return std::exchange(it->second.events, 0);
+        }
+
+        bool TakeEntries(int wd, std::vector<std::string>& names) override
+        {
+            const std::lock_guard<std::mutex> lock(m_mutex);
+            auto it = m_watches.find(wd);
+
+            if (it == m_watches.end())
+            {
+                return false;
+            }
+
+            auto& entries = it->second.entries;
+            names.insert(names.end(), std::make_move_iterator(entries.begin()), std::make_move_iterator(entries.end()));
+            entries.clear();
+            return !std::exchange(it->second.entriesLost, false);
+        }
+
+        void Stop() override
+        {
+            boost::asio::any_io_executor executor;
+
+            {
+                const std::lock_guard<std::mutex> lock(m_mutex);
+                m_stopped = true;
+                executor = m_runExecutor ? m_runExecutor : m_descriptor.get_executor();
+            }
+
+            boost::asio::post(executor,
+                              [self = shared_from_this()]()
+                              {
+                                  boost::system::error_code ec;
+                                  self->m_descriptor.close(ec);
+                                  self->NotifyAll(0);
+                              });
+        }
+
+    private:
+        /// @brief Watch state
+        struct Watch
+        {
+            /// @brief Number of callers that added this watch
+            int references {0};
+
+            /// @brief Events not yet consumed by Wait()
+            uint32_t events {0};
+
+            /// @brief Timers of the coroutines waiting for this watch
+            std::list<std::shared_ptr<boost::asio::steady_timer>> waiters;
+
+            /// @brief Names of the entries created in a directory, not yet consumed by TakeEntries()
+            std::vector<std::string> entries;
+
+            /// @brief Whether some entry names were lost since the last call to TakeEntries()
+            bool entriesLost {false};
+        };
+
+        /// @brief Wakes up the coroutines waiting for a watch
+        ///
+        /// Timers are not thread safe, so they are canceled on the strand of
+        /// their coroutine. The caller must hold the mutex.
+        static void CancelWaiters(const Watch& watch)
+        {
+            for (const auto& waiter : watch.waiters)
+            {
+                boost::asio::post(waiter->get_executor(), [waiter]() { waiter->cancel(); });
+            }
+        }
+
+        int AddWatch(const std::string& path, uint32_t mask)
+        {
+            const int wd = inotify_add_watch(m_descriptor.native_handle(), path.c_str(), mask);
+
+            if (wd < 0)
+            {
+                LogDebug("Cannot watch '{}': {}. Polling it instead.", path, std::strerror(errno));
+                return -1;
+            }
+
+            const std::lock_guard<std::mutex> lock(m_mutex);
+            ++m_watches[wd].references;
+            return wd;
+        }
+
+        /// @brief Dispatches a buffer of inotify events to the watches
+        void Dispatch(const char* data, size_t length)
+        {
+            size_t offset = 0;
+
+            while (offset + sizeof(inotify_event) <= length)
+            {
+                inotify_event event {};
+                std::memcpy(&event, data + offset, sizeof(inotify_event));
+
+                // The name of a directory entry follows the event, padded with null bytes
+                const auto* name = data + offset + sizeof(inotify_event);
+                const auto nameLength = offset + sizeof(inotify_event) + event.len <= length ? event.len : 0;
+                offset += sizeof(inotify_event) + event.len;
+
+                if (event.mask & IN_Q_OVERFLOW)
+                {
+                    LogDebug("File notification queue overflowed, waking up all readers.");
+                    NotifyAll(logcollector::FILE_MODIFIED | logcollector::DIRECTORY_CHANGED);
+                }
+                else
+                {
+                    Notify(event.wd, ToFileEvents(event.mask), std::string_view(name, strnlen(name, nameLength)));
+                }
+            }
+        }
+
+        void Notify(int wd, uint32_t events, std::string_view name)
+        {
+            const std::lock_guard<std::mutex> lock(m_mutex);
+            auto it = m_watches.find(wd);
+
+            if (it == m_watches.end() || events == 0)
+            {
+                return;
+            }
+
+            auto& watch = it->second;
+
+            if ((events & logcollector::DIRECTORY_CHANGED) != 0 && !name.empty() && !watch.entriesLost)
+            {
+                if (watch.entries.size() < MAX_PENDING_ENTRIES)
+                {
+                    watch.entries.emplace_back(name);
+                }
+                else
+                {
+                    watch.entries.clear();
+                    watch.entriesLost = true;
+                }
+            }
+
+            watch.events |= events;
+            CancelWaiters(watch);
+        }
+
+        void NotifyAll(uint32_t events)
+        {
+            const std::lock_guard<std::mutex> lock(m_mutex);
+
+            for (auto& [wd, watch] : m_watches)
+            {
+                if ((events & logcollector::DIRECTORY_CHANGED) != 0)
+                {
+                    watch.entries.clear();
+                    watch.entriesLost = true;
+                }
+
+                watch.events |= events;
+                CancelWaiters(watch);
+            }
+        }
+
+        boost::asio::posix::stream_descriptor m_descriptor;
+        boost::asio::any_io_executor m_runExecutor;
+        std::mutex m_mutex;
+        std::unordered_map<int, Watch> m_watches;
+        bool m_stopped {false};
+    };
+} // namespace
+
+namespace logcollector
+{
+    std::shared_ptr<IFileWatcher> CreateFileWatcher(boost::asio::any_io_executor executor)
+    {
+        const int fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+
+        if (fd < 0)
+        {
+            LogWarn("Cannot initialize inotify: {}. Files will be polled.", std::strerror(errno));
+            return nullptr;
+        }
+
+        return std::make_shared<InotifyWatcher>(std::move(executor), fd);
+    }
+} // namespace logcollector
+
+#else
+
+namespace logcollector
+{
+    std::shared_ptr<IFileWatcher> CreateFileWatcher([[maybe_unused]] boost::asio::any_io_executor executor)
+    {
+        return nullptr;
+    }
+} // namespace logcollector
+
+#endif
@@ -0,0 +1,10 @@
+#include "file_watcher.hpp"
+
+namespace logcollector
+{
+    std::shared_ptr<IFileWatcher> CreateFileWatcher([[maybe_unused]] boost::asio::any_io_executor executor)
+    {
+        // Directory change notifications are not implemented on Windows yet, files are polled
+        return nullptr;
+    }
+} // namespace logcollector
@@ -0,0 +1,385 @@
+#include "line_filter.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <deque>
+#include <limits>
+#include <utility>
+
+using namespace logcollector;
+
+namespace
+{
+    /// @brief Transition not yet defined while the trie is being built
+    constexpr uint32_t NO_STATE = std::numeric_limits<uint32_t>::max();
+
+    /// @brief Characters with a special meaning in a regular expression
+    constexpr std::string_view REGEX_SPECIAL_CHARS = "\\^$.|?*+()[]{}";
+
+    /// @brief Gets the position past the end of a character class
+    /// @param pattern Regular expression
+    /// @param pos Position of the opening bracket
+    /// @return Position past the closing bracket
+    size_t SkipClass(const std::string& pattern, size_t pos)
+    {
+        ++pos;
+
+        // A closing bracket at the beginning of a class is a literal
+        if (pos < pattern.size() && pattern[pos] == '^')
+        {
+            ++pos;
+        }
+        if (pos < pattern.size() && pattern[pos] == ']')
+        {
+            ++pos;
+        }
+
+        for (; pos < pattern.size(); ++pos)
+        {
+            if (pattern[pos] == '\\')
+            {
+                ++pos;
+            }
+            else if (pattern[pos] == ']')
+            {
+                return pos + 1;
+            }
+        }
+
+        return pattern.size();
+    }
+
+    /// @brief Gets the length of an escape sequence that is not a literal character
+    /// @param escape Character after the backslash
+    /// @return Length of the sequence, including the backslash and its operands
+    size_t EscapeLength(char escape)
+    {
+        switch (escape)
+        {
+            case 'x':
+                // \xHH
+                return 4;
+            case 'u':
+                // \uHHHH
+                return 6;
+            case 'c':
+                // \cX
+                return 3;
+            default:
+                return 2;
+        }
+    }
+
+    /// @brief Gets the position past the end of a group
+    /// @param pattern Regular expression
+    /// @param pos Position of the opening parenthesis
+    /// @return Position past the closing parenthesis
+    size_t SkipGroup(const std::string& pattern, size_t pos)
+    {
+        int depth = 0;
+
+        while (pos < pattern.size())
+        {
+            const auto c = pattern[pos];
+
+            if (c == '\\')
+            {
+                pos += 2;
+                continue;
+            }
+
+            if (c == '[')
+            {
+                pos = SkipClass(pattern, pos);
+                continue;
+            }
+
+            if (c == '(')
+            {
+                ++depth;
+            }
+            else if (c == ')' && --depth == 0)
+            {
+                return pos + 1;
+            }
+
+            ++pos;
+        }
+
+        return pattern.size();
+    }
+
+    /// @brief Per-thread marks of the patterns already confirmed on the current line
+    thread_local std::vector<uint32_t> t_confirmed;
+
+    /// @brief Per-thread number of the current line, used as the mark
+    thread_local uint32_t t_generation = 0;
+} // namespace
+
+MultiPatternMatcher::MultiPatternMatcher(const std::vector<std::string>& patterns)
+{
+    std::vector<std::string> literals;
+
+    for (const auto& pattern : patterns)
+    {
+        const auto id = static_cast<uint32_t>(m_patterns.size());
+        auto& compiled = m_patterns.emplace_back();
+
+        if (pattern.empty() || pattern.find_first_of(REGEX_SPECIAL_CHARS) != std::string::npos)
+        {
+            compiled.regex.emplace(pattern, std::regex::ECMAScript | std::regex::optimize);
+            literals.push_back(RequiredLiteral(pattern));
+        }
+        else
+        {
+            literals.push_back(pattern);
+        }
+
+        if (literals.back().empty())
+        {
+            m_unfiltered.push_back(id);
+        }
+    }
+
+    // Bytes that appear in no literal always go back to the root, so they share a class
+    for (const auto& literal : literals)
+    {
+        for (const auto c : literal)
+        {
+            auto& byteClass = m_byteClass[static_cast<unsigned char>(c)];
+
+            if (byteClass == 0)
+            {
+                byteClass = static_cast<uint16_t>(m_classCount++);
+            }
+        }
+    }
+
+    m_transitions.assign(m_classCount, NO_STATE);
+    m_outputs.emplace_back();
+
+    for (uint32_t id = 0; id < literals.size(); ++id)
+    {
+        if (!literals[id].empty())
+        {
+            AddLiteral(literals[id], id);
+        }
+    }
+
+    BuildAutomaton();
+}
+
+void MultiPatternMatcher::AddLiteral(const std::string& literal, uint32_t id)
+{
+    uint32_t state = 0;
+
+    for (const auto c : literal)
+    {
+        const auto index = state * m_classCount + m_byteClass[static_cast<unsigned char>(c)];
+
+        if (m_transitions[index] == NO_STATE)
+        {
+            m_transitions[index] = static_cast<uint32_t>(m_outputs.size());
+            m_transitions.resize(m_transitions.size() + m_classCount, NO_STATE);
+            m_outputs.emplace_back();
+        }
+
+        state = m_transitions[index];
+    }
+
+    m_outputs[state].push_back(id);
+}
+
+void MultiPatternMatcher::BuildAutomaton()
+{
+    std::vector<uint32_t> failure(m_outputs.size(), 0);
+    std::deque<uint32_t> queue;
+    m_hasOutput.assign(m_outputs.size(), 0);
+
+    for (size_t c = 0; c < m_classCount; ++c)
+    {
+        if (m_transitions[c] == NO_STATE)
+        {
+            m_transitions[c] = 0;
+        }
+        else
+        {
+            queue.push_back(m_transitions[c]);
+        }
+    }
+
+    // States are visited by depth, so the failure state of each one is already complete
+    while (!queue.empty())
+    {
+        const auto state = queue.front();
+        queue.pop_front();
+
+        const auto& inherited = m_outputs[failure[state]];
+        m_outputs[state].insert(m_outputs[state].end(), inherited.begin(), inherited.end());
+        m_hasOutput[state] = m_outputs[state].empty() ? 0 : 1;
+
+        for (size_t c = 0; c < m_classCount; ++c)
+        {
+            auto& next = m_transitions[state * m_classCount + c];
+            const auto fallback = m_transitions[failure[state] * m_classCount + c];
+
+            if (next == NO_STATE)
+            {
+                next = fallback;
+            }
+            else
+            {
+                failure[next] = fallback;
+                queue.push_back(next);
+            }
+        }
+    }
+}
+
+bool MultiPatternMatcher::Matches(std::string_view line) const
+{
+    if (m_patterns.empty())
+    {
+        return false;
+    }
+
+    if (t_confirmed.size() < m_patterns.size())
+    {
+        t_confirmed.resize(m_patterns.size(), 0);
+    }
+
+    if (++t_generation == 0)
+    {
+        std::fill(t_confirmed.begin(), t_confirmed.end(), 0);
+        t_generation = 1;
+    }
+
+    if (m_unfiltered.size() < m_patterns.size())
+    {
+        const auto* transitions = m_transitions.data();
+        const auto* byteClass = m_byteClass.data();
+        const auto* hasOutput = m_hasOutput.data();
+        const auto classCount = m_classCount;
+        size_t state = 0;
+
+        for (const auto c : line)
+        {
+            state = transitions[state * classCount + byteClass[static_cast<unsigned char>(c)]];
+
+            if (!hasOutput[state])
+            {
+                continue;
+            }
+
+            for (const auto id : m_outputs[state])
+            {
+                // A literal may be found several times, but its pattern is confirmed once per line
+                if (std::exchange(t_confirmed[id], t_generation) != t_generation && Confirm(id, line))
+                {
+                    return true;
+                }
+            }
+        }
+    }
+
+    return std::ranges::any_of(m_unfiltered, [this, line](uint32_t id) { return Confirm(id, line); });
+}
+
+bool MultiPatternMatcher::Confirm(uint32_t id, std::string_view line) const
+{
+    const auto& regex = m_patterns[id].regex;
+    return !regex || std::regex_search(line.data(), line.data() + line.size(), *regex);
+}
+
+std::string MultiPatternMatcher::RequiredLiteral(const std::string& pattern)
+{
+    std::string best;
+    std::string current;
+
+    const auto endRun = [&best, &current]()
+    {
+        if (current.size() > best.size())
+        {
+            best = current;
+        }
+        current.clear();
+    };
+
+    for (size_t pos = 0; pos < pattern.size();)
+    {
+        const auto c = pattern[pos];
+
+        switch (c)
+        {
+            case '|':
+                // Any alternative may match, so no literal is required
+                return {};
+            case '(':
+                pos = SkipGroup(pattern, pos);
+                endRun();
+                break;
+            case '[':
+                pos = SkipClass(pattern, pos);
+                endRun();
+                break;
+            case '*':
+            case '?':
+            case '{':
+                // The previous character may not be present
+                if (!current.empty())
+                {
+                    current.pop_back();
+                }
+                endRun();
+                pos = c == '{' ? std::min(pattern.find('}', pos), pattern.size() - 1) + 1 : pos + 1;
+                break;
+            case '+':
+            case '.':
+            case '^':
+            case '$':
+                endRun();
+                ++pos;
+                break;
+            case '\\':
+            {
+                const auto escape = pos + 1 < pattern.size() ? pattern[pos + 1] : '\0';
+
+                if (std::ispunct(static_cast<unsigned char>(escape)))
+                {
+                    current.push_back(escape);
+                    pos += 2;
+                }
+                else
+                {
+                    // Character classes (\d, \w...), assertions, back-references and character codes
+                    endRun();
+                    pos += EscapeLength(escape);
+                }
+                break;
+            }
+            default:
+                current.push_back(c);
+                ++pos;
+                break;
+        }
+    }
+
+    endRun();
+    return best;
+}
+
+LineFilter::LineFilter(const std::vector<std::string>& include, const std::vector<std::string>& exclude)
+    : m_include(include)
+    , m_exclude(exclude)
+{
+}
+
+bool LineFilter::Accepts(std::string_view line) const
+{
+    if (!m_include.Empty() && !m_include.Matches(line))
+    {
+        return false;
+    }
+
+    return m_exclude.Empty() || !m_exclude.Matches(line);
+}
@@ -0,0 +1,83 @@
+#include "multiline_assembler.hpp"
+
+#include <algorithm>
+#include <utility>
+
+using namespace logcollector;
+
+MultilineRule::MultilineRule(const std::vector<std::string>& startPatterns,
+                             const std::vector<std::string>& continuationPatterns)
+    : start(startPatterns)
+    , continuation(continuationPatterns)
+{
+}
+
+MultilineAssembler::MultilineAssembler(std::shared_ptr<const MultilineRule> rule)
+    : m_rule(std::move(rule))
+{
+}
+
+std::string_view MultilineAssembler::Add(std::string_view line, uint64_t offset)
+{
+    std::string_view completed;
+
+    if (m_lines > 0 && (BeginsEvent(line) || m_lines >= m_rule->maxLines ||
+                        m_event.size() + 1 + line.size() > m_rule->maxBytes))
+    {
+        completed = Flush();
+    }
+
+    if (m_lines == 0)
+    {
+        m_offset = offset;
+
+        // A single line longer than the limit is truncated
+        m_event.append(line.substr(0, m_rule->maxBytes));
+    }
+    else
+    {
+        m_event.push_back('\n');
+        m_event.append(line);
+    }
+
+    ++m_lines;
+    m_lastLine = std::chrono::steady_clock::now();
+    return completed;
+}
+
+std::string_view MultilineAssembler::Flush()
+{
+    if (m_lines == 0)
+    {
+        return {};
+    }
+
+    // The buffers are swapped, so that the completed event stays valid while the next one is assembled
+    m_completed.swap(m_event);
+    m_event.clear();
+    m_lines = 0;
+    return m_completed;
+}
+
+std::chrono::milliseconds MultilineAssembler::TimeLeft() const
+{
+    if (m_lines == 0)
+    {
+        return std::chrono::milliseconds(0);
+    }
+
+    const auto elapsed =
+        std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - m_lastLine);
+    return std::max(m_rule->timeout - elapsed, std::chrono::milliseconds(0));
+}
+
+bool MultilineAssembler::BeginsEvent(std::string_view line) const
+{
+    if (!m_rule->start.Empty() && m_rule->start.Matches(line))
+    {
+        return true;
+    }
+
+    // With only start patterns, every other line continues the event
+    return !m_rule->continuation.Empty() && !m_rule->continuation.Matches(line);
+}
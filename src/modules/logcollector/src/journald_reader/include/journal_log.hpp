@@ -53,6 +53,41 @@ struct JournalFilter
     }
 };
 
+/// @brief Journal filter with its values split once, used to check entries in user space
+struct CompiledJournalFilter
+{
+    std::string field;               ///< Field name to filter on
+    std::vector<std::string> values; ///< Values or patterns to match, any of them is enough
+    bool exact_match {true};         ///< Whether to perform exact matching or substring matching
+    bool in_journal_matches {false}; ///< Whether the journal already applies this filter as a match
+
+    /// @brief Compiles a filter
+    /// @param filter Filter to compile
+    explicit CompiledJournalFilter(const JournalFilter& filter)
+        : field(filter.field)
+        , exact_match(filter.exact_match)
+    {
+        for (const auto& value : filter.GetValueViews())
+        {
+            values.emplace_back(value);
+        }
+    }
+
+    /// @brief Checks if a field value matches any of the filter values
+    /// @param fieldValue The value to check against filter values
+    /// @return true if matches, false otherwise
+    bool Matches(std::string_view fieldValue) const
+    {
+        return std::any_of(values.begin(),
+                           values.end(),
+                           [fieldValue, this](const auto& val)
+                           {
+                               return exact_match ? fieldValue == val
+                                                  : fieldValue.find(val) != std::string_view::npos;
+                           });
+    }
+};
+
 /// @brief Group of filters combined with AND logic
 using FilterGroup = std::vector<JournalFilter>;
 /// @brief Set of filter groups combined with OR logic
@@ -117,15 +152,28 @@ public:
     virtual uint64_t GetTimestamp() const;
 
     /// @brief Adds a group of filters with AND logic between them
+    ///
+    /// Groups are combined with OR logic. Exact filters are added to the journal
+    /// as matches, so that the journal skips the entries that don't match them
+    /// using its indexes. Substring filters are checked on each entry.
+    ///
     /// @param group Group of filters to add
     /// @param ignoreIfMissing Whether to ignore missing fields
     virtual void AddFilterGroup(const FilterGroup& group, bool ignoreIfMissing);
 
-    /// @brief Gets next message that matches current filters
-    /// @param filters Set of filter groups to apply
+    /// @brief Gets next message that matches the filter groups
     /// @param ignoreIfMissing Whether to ignore missing fields
     /// @return Optional containing filtered message if found
-    virtual std::optional<FilteredMessage> GetNextFilteredMessage(const FilterSet& filters, bool ignoreIfMissing);
+    virtual std::optional<FilteredMessage> GetNextFilteredMessage(bool ignoreIfMissing);
+
+    /// @brief Gets a file descriptor that becomes readable when the journal changes
+    /// @return File descriptor owned by the journal
+    /// @throw JournalLogException if the journal cannot be watched
+    virtual int GetFileDescriptor();
+
+    /// @brief Processes the changes signaled through the file descriptor
+    /// @return true if entries were added or the journal files changed, false otherwise
+    virtual bool ProcessChanges();
 
     /// @brief Clears all active filters
     void FlushFilters();
@@ -151,8 +199,10 @@ public:
 private:
     struct sd_journal* m_journal;    ///< Pointer to journal structure
     uint64_t m_currentTimestamp {0}; ///< Current entry timestamp
-    bool m_hasActiveFilters {false}; ///< Whether filters are currently active
-    FilterSet m_filters;             ///< Currently active filters
+    bool m_journalMatches {true};    ///< Whether exact filters can be added to the journal as matches
+
+    /// @brief Active filter groups, combined with OR logic
+    std::vector<std::vector<CompiledJournalFilter>> m_filterGroups;
 
     /// @brief Gets current epoch time in microseconds
     static uint64_t GetEpochTime();
@@ -162,22 +212,30 @@ private:
     /// @param operation Operation description for error message
     void ThrowIfError(int result, const std::string& operation) const;
 
-    /// @brief Applies filter set with OR logic between groups
-    /// @param filters Set of filter groups to apply
+    /// @brief Gets field data from current journal entry without copying it
+    /// @param field Field name to retrieve
+    /// @return View of the field value, valid until the journal moves, or nullopt if missing
+    std::optional<std::string_view> GetDataView(const std::string& field) const;
+
+    /// @brief Adds the exact filters of a group to the journal as matches
+    /// @param group Group of compiled filters
+    /// @param ignoreIfMissing Whether to ignore errors adding matches
+    void AddJournalMatches(std::vector<CompiledJournalFilter>& group, bool ignoreIfMissing);
+
+    /// @brief Applies the filter groups with OR logic between them
     /// @param ignoreIfMissing Whether to ignore missing fields
     /// @return true if any group matches, false otherwise
-    bool ApplyFilterSet(const FilterSet& filters, bool ignoreIfMissing);
+    bool ApplyFilterGroups(bool ignoreIfMissing) const;
 
     /// @brief Applies filter group with AND logic between filters
-    /// @param group Group of filters to add
+    /// @param group Group of compiled filters
     /// @param ignoreIfMissing Whether to ignore missing fields
     /// @return true if all filters match, false otherwise
-    bool ApplyFilterGroup(const FilterGroup& group, bool ignoreIfMissing) const;
+    bool ApplyFilterGroup(const std::vector<CompiledJournalFilter>& group, bool ignoreIfMissing) const;
 
     /// @brief Processes current journal entry
-    /// @param filters Set of filter groups to apply
     /// @param ignoreIfMissing Whether to ignore missing fields
     /// @param message Filtered message structure to fill
-    /// @return true if entry matches any filter, false otherwise
-    bool ProcessJournalEntry(const FilterSet& filters, bool ignoreIfMissing, FilteredMessage& message) const;
+    /// @return true if the entry has a message, false otherwise
+    bool ProcessJournalEntry(bool ignoreIfMissing, FilteredMessage& message) const;
 };
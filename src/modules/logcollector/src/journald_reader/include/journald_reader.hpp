@@ -1,10 +1,15 @@
 #pragma once
 
+#include <bookmark_store.hpp>
 #include <journal_log.hpp>
 #include <logcollector.hpp>
 #include <reader.hpp>
 
+#include <boost/asio/any_io_executor.hpp>
+#include <boost/asio/posix/stream_descriptor.hpp>
+
 #include <memory>
+#include <optional>
 #include <regex>
 
 namespace logcollector
@@ -22,7 +27,14 @@ namespace logcollector
         /// @param filters Group of filters to apply (AND logic between them)
         /// @param ignoreIfMissing Whether to ignore missing fields
         /// @param fileWait Time to wait between reads in milliseconds
-        JournaldReader(Logcollector& logcollector, FilterGroup filters, bool ignoreIfMissing, std::time_t fileWait);
+        /// @param maxCatchup Maximum age in milliseconds of the entries read when resuming, 0 for no limit
+        /// @param bookmarks Store of the last delivered cursor, if null the journal is read from the end
+        JournaldReader(Logcollector& logcollector,
+                       FilterGroup filters,
+                       bool ignoreIfMissing,
+                       std::time_t fileWait,
+                       std::time_t maxCatchup = 0,
+                       std::shared_ptr<BookmarkStore> bookmarks = nullptr);
 
         /// @brief Runs the journal reader
         /// @return Awaitable for asynchronous operation
@@ -36,10 +48,32 @@ namespace logcollector
         std::string GetFilterDescription() const;
 
     private:
+        /// @brief Moves to the last delivered entry, or to the end of the journal
+        ///
+        /// Entries older than the catch-up window are skipped.
+        void SetStartPosition();
+
+        /// @brief Stores the cursor of the current entry
+        void SaveCursor();
+
+        /// @brief Opens a descriptor that becomes readable when the journal changes
+        /// @param executor Executor where the descriptor is waited on
+        /// @return Descriptor, or nullopt if the journal must be polled
+        std::optional<boost::asio::posix::stream_descriptor>
+        OpenJournalDescriptor(const boost::asio::any_io_executor& executor);
+
+        /// @brief Waits until the journal changes or the wait time expires
+        /// @param descriptor Journal descriptor, the wait time is used as a plain timer if not set
+        /// @return Awaitable for asynchronous operation
+        Awaitable WaitForChanges(std::optional<boost::asio::posix::stream_descriptor>& descriptor);
+
         FilterGroup m_filters;                           ///< Active filters
         bool m_ignoreIfMissing;                          ///< Whether to ignore missing fields
         std::unique_ptr<JournalLog> m_journal;           ///< Journal interface
         std::chrono::milliseconds m_waitTime;            ///< Wait time between reads
+        std::chrono::milliseconds m_maxCatchup;          ///< Maximum age of the entries read when resuming
+        std::shared_ptr<BookmarkStore> m_bookmarks;      ///< Cursor store
+        std::string m_cursorKey;                         ///< Key of the cursor in the store
         static constexpr size_t MAX_LINE_LENGTH = 16384; ///< Maximum message length
     };
 
@@ -71,13 +71,25 @@ bool JournalLog::SeekTimestamp(uint64_t timestamp)
 }
 
 std::string JournalLog::GetData(const std::string& field) const
+{
+    const auto value = GetDataView(field);
+
+    if (!value)
+    {
+        throw JournalLogException("Field not present in current journal entry");
+    }
+
+    return std::string(*value);
+}
+
+std::optional<std::string_view> JournalLog::GetDataView(const std::string& field) const
 {
     const void* data = nullptr;
     size_t length = 0;
     const int ret = sd_journal_get_data(m_journal, field.c_str(), &data, &length);
     if (ret == -ENOENT)
     {
-        throw JournalLogException("Field not present in current journal entry");
+        return std::nullopt;
     }
     ThrowIfError(ret, "get data");
 
@@ -85,7 +97,7 @@ std::string JournalLog::GetData(const std::string& field) const
     const std::string_view full_str(str, length);
     const size_t prefix_len = field.length() + 1;
 
-    return std::string(full_str.substr(prefix_len));
+    return full_str.substr(std::min(prefix_len, full_str.size()));
 }
 
 uint64_t JournalLog::GetTimestamp() const
@@ -239,58 +251,119 @@ void JournalLog::AddFilterGroup(const FilterGroup& group, bool ignoreIfMissing)
         throw JournalLogException("Invalid filter configuration");
     }
 
-    for (const auto& filter : group)
+    std::vector<CompiledJournalFilter> compiled(group.begin(), group.end());
+
+    if (m_journalMatches)
     {
-        for (const auto& value : filter.GetValueViews())
+        // Add OR condition between this group and the previous ones
+        if (!m_filterGroups.empty())
         {
-            std::string match = filter.field + (filter.exact_match ? "=" : "~") + std::string(value);
-            LogDebug("Adding journal match: {}", match);
+            ThrowIfError(sd_journal_add_disjunction(m_journal), "add filter disjunction");
+        }
 
-            const int ret = sd_journal_add_match(m_journal, match.c_str(), 0);
-            if (ret < 0)
+        AddJournalMatches(compiled, ignoreIfMissing);
+
+        // A group without matches accepts any entry, so the journal cannot skip entries for the others
+        const auto withoutMatches = [](const auto& filters)
+        { return std::ranges::none_of(filters, &CompiledJournalFilter::in_journal_matches); };
+
+        if (!m_filterGroups.empty() &&
+            (withoutMatches(compiled) || std::ranges::any_of(m_filterGroups, withoutMatches)))
+        {
+            LogDebug("Filter group without exact conditions, checking all filters on each entry");
+            sd_journal_flush_matches(m_journal);
+            m_journalMatches = false;
+
+            for (auto& previous : m_filterGroups)
             {
-                if (!ignoreIfMissing)
+                for (auto& filter : previous)
                 {
-                    ThrowIfError(ret, "add filter match");
+                    filter.in_journal_matches = false;
                 }
-                LogWarn("Failed to add journal match {}: {}", match, strerror(-ret));
-                continue;
             }
         }
+    }
+
+    m_filterGroups.push_back(std::move(compiled));
+    LogInfo("Filter group added successfully");
+}
+
+void JournalLog::AddJournalMatches(std::vector<CompiledJournalFilter>& group, bool ignoreIfMissing)
+{
+    for (auto& filter : group)
+    {
+        // Matches of the same field are combined with OR logic by the journal, so only one filter per field is added
+        const auto sameField = [&filter](const auto& other)
+        { return other.in_journal_matches && other.field == filter.field; };
+
+        if (!filter.exact_match || std::ranges::any_of(group, sameField))
+        {
+            continue;
+        }
+
+        try
+        {
+            for (const auto& value : filter.values)
+            {
+                const std::string match = filter.field + "=" + value;
+                LogDebug("Adding journal match: {}", match);
+                ThrowIfError(sd_journal_add_match(m_journal, match.c_str(), match.size()), "add filter match");
+            }
 
-        // Add OR condition between values of the same field
-        if (filter.GetValueViews().size() > 1)
+            filter.in_journal_matches = true;
+        }
+        catch (const JournalLogException& e)
         {
-            ThrowIfError(sd_journal_add_disjunction(m_journal), "add filter disjunction for field values");
+            if (!ignoreIfMissing)
+            {
+                throw;
+            }
+            LogWarn("Failed to add journal match for field {}: {}", filter.field, e.what());
         }
     }
-
-    ThrowIfError(sd_journal_add_conjunction(m_journal), "add filter conjunction");
-    m_hasActiveFilters = true;
-    LogInfo("Filter group added successfully");
 }
 
 void JournalLog::FlushFilters()
 {
-    if (m_hasActiveFilters)
+    if (!m_filterGroups.empty())
     {
         sd_journal_flush_matches(m_journal);
-        m_hasActiveFilters = false;
+        m_filterGroups.clear();
+        m_journalMatches = true;
     }
 }
 
-bool JournalLog::ApplyFilterGroup(const FilterGroup& group, bool ignoreIfMissing) const
+int JournalLog::GetFileDescriptor()
+{
+    const int fd = sd_journal_get_fd(m_journal);
+    ThrowIfError(fd, "get file descriptor");
+    return fd;
+}
+
+bool JournalLog::ProcessChanges()
 {
+    const int ret = sd_journal_process(m_journal);
+    ThrowIfError(ret, "process journal changes");
+    return ret != SD_JOURNAL_NOP;
+}
+
+bool JournalLog::ApplyFilterGroup(const std::vector<CompiledJournalFilter>& group, bool ignoreIfMissing) const
+{
+    // With a single group, the journal only returns entries that match its exact filters
+    const bool skipJournalMatches = m_filterGroups.size() == 1;
+
     return std::all_of(group.begin(),
                        group.end(),
-                       [this, ignoreIfMissing](const auto& filter)
+                       [this, ignoreIfMissing, skipJournalMatches](const auto& filter)
                        {
-                           try
+                           if (skipJournalMatches && filter.in_journal_matches)
                            {
-                               const std::string fieldValue = GetData(filter.field);
-                               return filter.Matches(fieldValue);
+                               return true;
                            }
-                           catch (const JournalLogException&)
+
+                           const auto fieldValue = GetDataView(filter.field);
+
+                           if (!fieldValue)
                            {
                                if (!ignoreIfMissing)
                                {
@@ -298,17 +371,19 @@ bool JournalLog::ApplyFilterGroup(const FilterGroup& group, bool ignoreIfMissing
                                }
                                return false;
                            }
+
+                           return filter.Matches(*fieldValue);
                        });
 }
 
-bool JournalLog::ApplyFilterSet(const FilterSet& filters, bool ignoreIfMissing)
+bool JournalLog::ApplyFilterGroups(bool ignoreIfMissing) const
 {
-    return std::any_of(filters.begin(),
-                       filters.end(),
+    return std::any_of(m_filterGroups.begin(),
+                       m_filterGroups.end(),
                        [this, ignoreIfMissing](const auto& group) { return ApplyFilterGroup(group, ignoreIfMissing); });
 }
 
-bool JournalLog::ProcessJournalEntry(const FilterSet&, bool ignoreIfMissing, FilteredMessage& message) const
+bool JournalLog::ProcessJournalEntry(bool ignoreIfMissing, FilteredMessage& message) const
 {
     try
     {
@@ -333,11 +408,10 @@ bool JournalLog::ProcessJournalEntry(const FilterSet&, bool ignoreIfMissing, Fil
     }
 }
 
-std::optional<JournalLog::FilteredMessage> JournalLog::GetNextFilteredMessage(const FilterSet& filters,
-                                                                              bool ignoreIfMissing)
+std::optional<JournalLog::FilteredMessage> JournalLog::GetNextFilteredMessage(bool ignoreIfMissing)
 {
 
-    if (!m_hasActiveFilters)
+    if (m_filterGroups.empty())
     {
         LogWarn("No active filters when trying to get filtered message");
         return std::nullopt;
@@ -346,7 +420,7 @@ std::optional<JournalLog::FilteredMessage> JournalLog::GetNextFilteredMessage(co
     while (Next())
     {
         FilteredMessage message;
-        if (ApplyFilterSet(filters, ignoreIfMissing) && ProcessJournalEntry(filters, ignoreIfMissing, message))
+        if (ApplyFilterGroups(ignoreIfMissing) && ProcessJournalEntry(ignoreIfMissing, message))
         {
             return message;
         }
@@ -1,24 +1,45 @@
 #include "journald_reader.hpp"
 
 #include <logger.hpp>
+
+#include <boost/asio/experimental/awaitable_operators.hpp>
+#include <boost/asio/posix/stream_descriptor.hpp>
+#include <boost/asio/redirect_error.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <boost/asio/this_coro.hpp>
+#include <boost/asio/use_awaitable.hpp>
+
+#include <unistd.h>
+
+#include <optional>
 #include <sstream>
+#include <string>
+#include <vector>
 
 namespace
 {
     const std::string COLLECTOR_TYPE = "journald";
-}
+
+    /// @brief Maximum number of messages delivered before the cursor is saved
+    constexpr size_t MAX_UNSAVED_MESSAGES = 512;
+} // namespace
 
 namespace logcollector
 {
     JournaldReader::JournaldReader(Logcollector& logcollector,
                                    FilterGroup filters,
                                    bool ignoreIfMissing,
-                                   std::time_t fileWait)
+                                   std::time_t fileWait,
+                                   std::time_t maxCatchup,
+                                   std::shared_ptr<BookmarkStore> bookmarks)
         : IReader(logcollector)
         , m_filters(std::move(filters))
         , m_ignoreIfMissing(ignoreIfMissing)
         , m_journal(std::make_unique<JournalLog>())
         , m_waitTime(std::chrono::milliseconds(fileWait))
+        , m_maxCatchup(std::chrono::milliseconds(maxCatchup))
+        , m_bookmarks(std::move(bookmarks))
+        , m_cursorKey(COLLECTOR_TYPE + ":" + GetFilterDescription())
     {
 
         LogInfo("Creating JournaldReader with {} filters", m_filters.size());
@@ -45,7 +66,7 @@ namespace logcollector
 
             try
             {
-                m_journal->SeekTail();
+                SetStartPosition();
             }
             catch (const JournalLogException& e)
             {
@@ -53,18 +74,22 @@ namespace logcollector
                 co_return;
             }
 
+            auto descriptor = OpenJournalDescriptor(co_await boost::asio::this_coro::executor);
+
             LogInfo("Journald reader started successfully");
+            std::vector<std::string> logs;
 
             while (m_keepRunning.load())
             {
                 bool shouldWait = true;
+                size_t unsavedMessages = 0;
                 try
                 {
                     LogTrace("Checking for new journal entries...");
-                    FilterSet filterSet {m_filters};
-                    while (auto filteredMessage = m_journal->GetNextFilteredMessage(filterSet, m_ignoreIfMissing))
+                    while (auto filteredMessage = m_journal->GetNextFilteredMessage(m_ignoreIfMissing))
                     {
                         shouldWait = false;
+                        ++unsavedMessages;
                         auto& message = filteredMessage->message;
                         LogDebug("Found matching message for {}", GetFilterDescription());
 
@@ -73,7 +98,21 @@ namespace logcollector
                             LogDebug("Truncating message of length {}", message.length());
                             message.resize(MAX_LINE_LENGTH);
                         }
-                        m_logcollector.SendMessage(filteredMessage->fieldValue, message, COLLECTOR_TYPE);
+
+                        // The cursor now points to this entry, so it must not be saved until the entry is delivered
+                        logs.assign(1, std::move(message));
+
+                        if (!co_await DeliverLogs(filteredMessage->fieldValue, logs, COLLECTOR_TYPE))
+                        {
+                            unsavedMessages = 0;
+                            break;
+                        }
+
+                        if (unsavedMessages == MAX_UNSAVED_MESSAGES)
+                        {
+                            SaveCursor();
+                            unsavedMessages = 0;
+                        }
                     }
                 }
                 catch (const JournalLogException& e)
@@ -81,11 +120,24 @@ namespace logcollector
                     LogError("Journal reading error: {}", e.what());
                 }
 
+                if (unsavedMessages > 0)
+                {
+                    SaveCursor();
+                }
+
+                if (m_bookmarks)
+                {
+                    m_bookmarks->FlushIfDue();
+                }
+
                 if (shouldWait)
                 {
-                    co_await m_logcollector.Wait(m_waitTime);
+                    co_await WaitForChanges(descriptor);
                 }
             }
+
+            // The journal is not thread safe, so it is only used from the strand of this coroutine
+            m_journal->FlushFilters();
         }
         catch (const JournalLogException& e)
         {
@@ -93,9 +145,113 @@ namespace logcollector
         }
     }
 
+    void JournaldReader::SetStartPosition()
+    {
+        const auto cursor = m_bookmarks ? m_bookmarks->GetCursor(m_cursorKey) : std::nullopt;
+
+        if (!cursor)
+        {
+            m_journal->SeekTail();
+            return;
+        }
+
+        if (!m_journal->SeekCursor(*cursor) || !m_journal->CursorValid(*cursor))
+        {
+            LogWarn("Last delivered journal entry is no longer available, reading the journal from the end");
+            m_journal->SeekTail();
+            return;
+        }
+
+        if (m_maxCatchup.count() > 0)
+        {
+            const auto oldestAllowed = static_cast<uint64_t>(
+                std::chrono::duration_cast<std::chrono::microseconds>(
+                    (std::chrono::system_clock::now() - m_maxCatchup).time_since_epoch())
+                    .count());
+
+            if (m_journal->GetTimestamp() < oldestAllowed)
+            {
+                LogWarn("Last delivered journal entry is older than {} ms, skipping older entries",
+                        m_maxCatchup.count());
+                m_journal->SeekTimestamp(oldestAllowed);
+                return;
+            }
+        }
+
+        LogInfo("Resuming journal from the last delivered entry");
+    }
+
+    void JournaldReader::SaveCursor()
+    {
+        if (!m_bookmarks)
+        {
+            return;
+        }
+
+        try
+        {
+            m_bookmarks->SetCursor(m_cursorKey, m_journal->GetCursor());
+        }
+        catch (const JournalLogException& e)
+        {
+            LogWarn("Cannot get journal cursor: {}", e.what());
+        }
+    }
+
+    std::optional<boost::asio::posix::stream_descriptor>
+    JournaldReader::OpenJournalDescriptor(const boost::asio::any_io_executor& executor)
+    {
+        try
+        {
+            // The descriptor closes its own copy, the journal keeps owning the original one
+            const int fd = dup(m_journal->GetFileDescriptor());
+
+            if (fd >= 0)
+            {
+                return boost::asio::posix::stream_descriptor(executor, fd);
+            }
+        }
+        catch (const std::exception& e)
+        {
+            LogDebug("Cannot watch journal changes: {}", e.what());
+        }
+
+        LogDebug("Polling the journal every {} ms", m_waitTime.count());
+        return std::nullopt;
+    }
+
+    Awaitable JournaldReader::WaitForChanges(std::optional<boost::asio::posix::stream_descriptor>& descriptor)
+    {
+        if (!descriptor)
+        {
+            co_await m_logcollector.Wait(m_waitTime);
+            co_return;
+        }
+
+        using namespace boost::asio::experimental::awaitable_operators;
+
+        // The timer keeps polling as a fallback and bounds the time to notice Stop()
+        boost::asio::steady_timer timer(descriptor->get_executor(), m_waitTime);
+        boost::system::error_code waitError;
+        boost::system::error_code timerError;
+
+        co_await (descriptor->async_wait(boost::asio::posix::descriptor_base::wait_read,
+                                         boost::asio::redirect_error(boost::asio::use_awaitable, waitError)) ||
+                  timer.async_wait(boost::asio::redirect_error(boost::asio::use_awaitable, timerError)));
+
+        try
+        {
+            // Consumes the notifications, otherwise the descriptor stays readable
+            m_journal->ProcessChanges();
+        }
+        catch (const JournalLogException& e)
+        {
+            LogWarn("Cannot process journal changes: {}", e.what());
+        }
+    }
+
     void JournaldReader::Stop()
     {
-        m_journal->FlushFilters();
         m_keepRunning.store(false);
         LogInfo("Journald stopped.");
     }
@@ -2,17 +2,29 @@
 
 #include <boost/asio/co_spawn.hpp>
 #include <boost/asio/detached.hpp>
+#include <boost/asio/post.hpp>
 #include <boost/asio/redirect_error.hpp>
+#include <boost/asio/strand.hpp>
 #include <config.h>
+#include <configuration_parser_utils.hpp>
 #include <logger.hpp>
 #include <timeHelper.h>
 
 #include <chrono>
 #include <iomanip>
+#include <limits>
 #include <map>
+#include <regex>
 #include <sstream>
+#include <stdexcept>
+#include <thread>
 
+#include "bookmark_store.hpp"
 #include "file_reader.hpp"
+#include "file_watcher.hpp"
+#include "line_filter.hpp"
+#include "multiline_assembler.hpp"
+#include "syslog_reader.hpp"
 
 using namespace logcollector;
 
@@ -21,6 +33,64 @@ namespace logcollector
     constexpr int ACTIVE_READERS_WAIT_MS = 10;
 }
 
+namespace
+{
+    /// @brief Gets a list of patterns that may also be written as a single pattern
+    std::vector<std::string> PatternList(const YAML::Node& node)
+    {
+        if (!node)
+        {
+            return {};
+        }
+
+        return node.IsScalar() ? std::vector<std::string> {node.as<std::string>()}
+                               : node.as<std::vector<std::string>>();
+    }
+
+    /// @brief Parses the multiline rule of a localfile
+    /// @param path Path of the localfile
+    /// @param node Multiline settings
+    /// @return Multiline rule, or nullptr if the settings are not valid
+    std::shared_ptr<const MultilineRule> ParseMultilineRule(const std::string& path, const YAML::Node& node)
+    {
+        try
+        {
+            const auto start = PatternList(node["start"]);
+            const auto continuation = PatternList(node["continuation"]);
+
+            if (start.empty() && continuation.empty())
+            {
+                throw std::invalid_argument("a start or continuation pattern is required");
+            }
+
+            auto rule = std::make_shared<MultilineRule>(start, continuation);
+            rule->maxLines = node["max_lines"].as<size_t>(rule->maxLines);
+
+            if (node["max_bytes"])
+            {
+                rule->maxBytes = ParseSizeUnit(node["max_bytes"].as<std::string>());
+            }
+
+            if (node["timeout"])
+            {
+                rule->timeout = std::chrono::milliseconds(ParseTimeUnit(node["timeout"].as<std::string>()));
+            }
+
+            if (rule->maxLines == 0 || rule->maxBytes == 0)
+            {
+                throw std::invalid_argument("max_lines and max_bytes must be greater than 0");
+            }
+
+            return rule;
+        }
+        catch (const std::exception& e)
+        {
+            LogWarn("Invalid multiline settings for '{}': {}. Each line will be sent as a log.", path, e.what());
+            return nullptr;
+        }
+    }
+} // namespace
+
 void Logcollector::Start()
 {
     if (!m_enabled)
@@ -30,14 +100,27 @@ void Logcollector::Start()
     }
 
     LogInfo("Logcollector module started.");
+
+    std::vector<std::thread> threads;
+
+    for (size_t i = 1; i < m_threadCount; ++i)
+    {
+        threads.emplace_back([this]() { m_ioContext.run(); });
+    }
+
     m_ioContext.run();
+
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
 }
 
 void Logcollector::EnqueueTask(boost::asio::awaitable<void> task)
 {
     // NOLINTBEGIN(cppcoreguidelines-avoid-capturing-lambda-coroutines)
     boost::asio::co_spawn(
-        m_ioContext,
+        boost::asio::make_strand(m_ioContext),
         [task = std::move(task), this]() mutable -> boost::asio::awaitable<void>
         {
             try
@@ -67,12 +150,31 @@ void Logcollector::Setup(std::shared_ptr<const configuration::ConfigurationParse
     m_enabled =
         configurationParser->GetConfigOrDefault(config::logcollector::DEFAULT_ENABLED, "logcollector", "enabled");
 
+    m_threadCount = configurationParser->GetConfigInRangeOrDefault<size_t>(config::logcollector::DEFAULT_THREAD_COUNT,
+                                                                           std::optional<size_t>(1),
+                                                                           std::optional<size_t> {},
+                                                                           "logcollector",
+                                                                           "thread_count");
+
     if (m_ioContext.stopped())
     {
         m_ioContext.restart();
     }
 
+    const auto dbFolderPath = configurationParser->GetConfigOrDefault(config::DEFAULT_DATA_PATH, "agent", "path.data");
+
+    try
+    {
+        m_bookmarks = std::make_shared<BookmarkStore>(dbFolderPath);
+    }
+    catch (const std::exception& e)
+    {
+        LogWarn("Cannot load bookmarks: {}. Files and journal will be read from the end.", e.what());
+        m_bookmarks.reset();
+    }
+
     SetupFileReader(configurationParser);
+    SetupSyslogReader(configurationParser);
     AddPlatformSpecificReader(configurationParser);
 }
 
@@ -84,20 +186,111 @@ void Logcollector::SetupFileReader(const std::shared_ptr<const configuration::Co
     const auto reloadInterval = configurationParser->GetTimeConfigOrDefault(
         config::logcollector::DEFAULT_RELOAD_INTERVAL, "logcollector", "reload_interval");
 
-    const auto localFilesDefault = std::vector<std::string> {config::logcollector::DEFAULT_LOCALFILES};
+    const auto watchFiles = configurationParser->GetConfigOrDefault(
+        config::logcollector::DEFAULT_FILE_NOTIFICATIONS, "logcollector", "file_notifications");
 
-    const auto localfiles = configurationParser->GetConfigOrDefault(localFilesDefault, "logcollector", "localfiles");
+    auto localFilesDefault = YAML::Node(YAML::NodeType::Sequence);
+    localFilesDefault.push_back(config::logcollector::DEFAULT_LOCALFILES);
+
+    const auto localfiles =
+        configurationParser->GetConfigOrDefault<YAML::Node>(localFilesDefault, "logcollector", "localfiles");
 
     for (const auto& lf : localfiles)
     {
-        AddReader(std::make_shared<FileReader>(*this, lf, fileWait, reloadInterval));
+        // Each entry is either a path, or a map with the path, its include/exclude patterns and its multiline rule
+        if (lf.IsScalar())
+        {
+            AddReader(std::make_shared<FileReader>(
+                *this, lf.as<std::string>(), fileWait, reloadInterval, m_bookmarks, nullptr, nullptr, watchFiles));
+            continue;
+        }
+
+        if (!lf.IsMap() || !lf["path"])
+        {
+            LogWarn("Invalid localfile entry, it must be a path or have a 'path' field.");
+            continue;
+        }
+
+        const auto path = lf["path"].as<std::string>();
+        const auto include = lf["include"].as<std::vector<std::string>>(std::vector<std::string> {});
+        const auto exclude = lf["exclude"].as<std::vector<std::string>>(std::vector<std::string> {});
+        std::shared_ptr<const LineFilter> filter;
+
+        if (!include.empty() || !exclude.empty())
+        {
+            try
+            {
+                filter = std::make_shared<const LineFilter>(include, exclude);
+            }
+            catch (const std::regex_error& e)
+            {
+                LogWarn("Invalid filter pattern for '{}': {}. All its lines will be sent.", path, e.what());
+            }
+        }
+
+        std::shared_ptr<const MultilineRule> multiline;
+
+        if (lf["multiline"])
+        {
+            multiline = ParseMultilineRule(path, lf["multiline"]);
+        }
+
+        AddReader(std::make_shared<FileReader>(
+            *this, path, fileWait, reloadInterval, m_bookmarks, filter, multiline, watchFiles));
+    }
+}
+
+void Logcollector::SetupSyslogReader(
+    const std::shared_ptr<const configuration::ConfigurationParser> configurationParser)
+{
+    const auto listeners = configurationParser->GetConfigOrDefault<YAML::Node>(
+        YAML::Node(YAML::NodeType::Sequence), "logcollector", "syslog");
+
+    for (const auto& listener : listeners)
+    {
+        if (!listener.IsMap())
+        {
+            LogWarn("Invalid syslog entry, it must be a map.");
+            continue;
+        }
+
+        const auto protocolName = listener["protocol"].as<std::string>("udp");
+        const auto address = listener["address"].as<std::string>(config::logcollector::DEFAULT_SYSLOG_ADDRESS);
+        const auto port = listener["port"].as<unsigned int>(config::logcollector::DEFAULT_SYSLOG_PORT);
+
+        if (protocolName != "udp" && protocolName != "tcp")
+        {
+            LogWarn("Invalid syslog protocol '{}', it must be 'udp' or 'tcp'.", protocolName);
+            continue;
+        }
+
+        if (port > std::numeric_limits<unsigned short>::max())
+        {
+            LogWarn("Invalid syslog port {}.", port);
+            continue;
+        }
+
+        const auto protocol = protocolName == "udp" ? SyslogReader::Protocol::UDP : SyslogReader::Protocol::TCP;
+        AddReader(std::make_shared<SyslogReader>(*this, protocol, address, static_cast<unsigned short>(port)));
     }
 }
 
 void Logcollector::Stop()
 {
     CleanAllReaders();
+
+    if (m_bookmarks)
+    {
+        m_bookmarks->Flush();
+    }
+
     m_ioContext.stop();
+
+    if (const auto dropped = m_droppedLogs.load(); dropped > 0)
+    {
+        LogWarn("{} logs were dropped because the message queue was full.", dropped);
+    }
+
     LogInfo("Logcollector module stopped.");
 }
 
@@ -127,53 +320,169 @@ void Logcollector::SetPushMessageFunction(const std::function<int(Message)>& pus
 }
 
 void Logcollector::SendMessage(const std::string& location, const std::string& log, const std::string& collectorType)
+{
+    SendMessages(location, {log}, collectorType);
+}
+
+void Logcollector::SendMessages(const std::string& location,
+                                const std::vector<std::string>& logs,
+                                const std::string& collectorType)
+{
+    if (!TrySendMessages(location, logs, collectorType))
+    {
+        m_droppedLogs += logs.size();
+        LogDebug("Message queue full, {} logs from '{}' dropped", logs.size(), location);
+    }
+}
+
+bool Logcollector::TrySendMessages(const std::string& location,
+                                   const std::vector<std::string>& logs,
+                                   const std::string& collectorType)
 {
     if (!m_pushMessage)
     {
         throw std::runtime_error("Message queue not set, cannot send message.");
     }
 
-    auto metadata = nlohmann::json::object();
-    auto data = nlohmann::json::object();
+    if (logs.empty())
+    {
+        return true;
+    }
+
+    std::string metadata;
+    {
+        const std::lock_guard<std::mutex> lock(m_metadataMutex);
+        auto it = m_metadata.find(collectorType);
+
+        if (it == m_metadata.end())
+        {
+            auto metadataJson = nlohmann::json::object();
+            metadataJson["module"] = m_moduleName;
+            metadataJson["collector"] = collectorType;
+            it = m_metadata.emplace(collectorType, metadataJson.dump()).first;
+        }
+
+        metadata = it->second;
+    }
 
-    metadata["module"] = m_moduleName;
-    metadata["collector"] = collectorType;
+    const auto isFile = collectorType == FILE_READER_TYPE;
+    const auto created = Utils::getCurrentISO8601();
 
-    if (collectorType == FILE_READER_TYPE)
+    // A single log is pushed as an object, a batch as an array stored in one transaction
+    auto data = nlohmann::json::array();
+
+    for (const auto& log : logs)
     {
-        data["log"]["file"]["path"] = location;
+        auto& element = data.emplace_back(nlohmann::json::object());
+        auto& eventField = element["event"];
+
+        if (isFile)
+        {
+            element["log"]["file"]["path"] = location;
+        }
+        else
+        {
+            eventField["provider"] = location;
+        }
+
+        eventField["created"] = created;
+        eventField["original"] = log;
     }
-    else
+
+    if (data.size() == 1)
     {
-        data["event"]["provider"] = location;
+        data = std::move(data[0]);
     }
-    data["event"]["original"] = log;
-    data["event"]["created"] = Utils::getCurrentISO8601();
 
-    auto message = Message(MessageType::STATELESS, data, m_moduleName, collectorType, metadata.dump());
-    m_pushMessage(message);
+    auto message = Message(MessageType::STATELESS, std::move(data), m_moduleName, collectorType, std::move(metadata));
 
-    LogTrace("Message pushed: '{}':'{}'", location, log);
+    if (m_pushMessage(std::move(message)) <= 0)
+    {
+        if (!m_queueFull.exchange(true))
+        {
+            LogWarn("Message queue is full, log collection is throttled until there is space.");
+        }
+
+        return false;
+    }
+
+    if (m_queueFull.exchange(false))
+    {
+        LogInfo("Message queue accepts logs again. Logs dropped so far: {}.", m_droppedLogs.load());
+    }
+
+    LogTrace("{} messages pushed: '{}'", logs.size(), location);
+    return true;
 }
 
 void Logcollector::AddReader(std::shared_ptr<IReader> reader)
 {
-    m_readers.push_back(reader);
+    {
+        const std::lock_guard<std::mutex> lock(m_readersMutex);
+        m_readers.push_back(reader);
+    }
+
     EnqueueTask(reader->Run());
 }
 
+std::shared_ptr<IFileWatcher> Logcollector::FileWatcher(boost::asio::any_io_executor executor)
+{
+    std::shared_ptr<IFileWatcher> watcher;
+
+    {
+        const std::lock_guard<std::mutex> lock(m_fileWatcherMutex);
+
+        if (m_fileWatcherCreated)
+        {
+            return m_fileWatcher;
+        }
+
+        m_fileWatcherCreated = true;
+        m_fileWatcher = CreateFileWatcher(std::move(executor));
+        watcher = m_fileWatcher;
+    }
+
+    if (watcher)
+    {
+        EnqueueTask(watcher->Run());
+    }
+
+    return watcher;
+}
+
 void Logcollector::CleanAllReaders()
 {
-    for (const auto& reader : m_readers)
+    std::list<std::shared_ptr<IReader>> readers;
+
+    {
+        const std::lock_guard<std::mutex> lock(m_readersMutex);
+        readers = m_readers;
+    }
+
+    for (const auto& reader : readers)
     {
         reader->Stop();
     }
 
+    {
+        // Readers do not take the watcher once stopped, so a new one is only created by the next readers
+        const std::lock_guard<std::mutex> lock(m_fileWatcherMutex);
+
+        if (m_fileWatcher)
+        {
+            m_fileWatcher->Stop();
+        }
+
+        m_fileWatcher.reset();
+        m_fileWatcherCreated = false;
+    }
+
     {
         const std::lock_guard<std::mutex> lock(m_timersMutex);
         for (const auto& timer : m_timers)
         {
-            timer->cancel();
+            // Timers are not thread safe, cancel them on the strand of their coroutine
+            boost::asio::post(timer->get_executor(), [timer]() { timer->cancel(); });
         }
     }
 
@@ -181,6 +490,8 @@ void Logcollector::CleanAllReaders()
     {
         std::this_thread::sleep_for(std::chrono::milliseconds(ACTIVE_READERS_WAIT_MS));
     }
+
+    const std::lock_guard<std::mutex> lock(m_readersMutex);
     m_readers.clear();
 }
 
@@ -188,14 +499,14 @@ Awaitable Logcollector::Wait(std::chrono::milliseconds ms)
 {
     if (!m_ioContext.stopped())
     {
-        auto timer = boost::asio::steady_timer(m_ioContext, ms);
+        auto timer = std::make_shared<boost::asio::steady_timer>(co_await boost::asio::this_coro::executor, ms);
         {
             std::lock_guard<std::mutex> lock(m_timersMutex);
-            m_timers.push_back(&timer);
+            m_timers.push_back(timer);
         }
 
         boost::system::error_code ec;
-        co_await timer.async_wait(boost::asio::redirect_error(boost::asio::use_awaitable, ec));
+        co_await timer->async_wait(boost::asio::redirect_error(boost::asio::use_awaitable, ec));
 
         if (ec)
         {
@@ -211,7 +522,7 @@ Awaitable Logcollector::Wait(std::chrono::milliseconds ms)
 
         {
             std::lock_guard<std::mutex> lock(m_timersMutex);
-            m_timers.remove(&timer);
+            m_timers.remove(timer);
         }
     }
 }
@@ -16,6 +16,9 @@ namespace logcollector
         const auto fileWait = configurationParser->GetTimeConfigOrDefault(
             config::logcollector::DEFAULT_FILE_WAIT, "logcollector", "read_interval");
 
+        const auto maxCatchup = configurationParser->GetTimeConfigOrDefault(
+            config::logcollector::DEFAULT_JOURNALD_MAX_CATCHUP, "logcollector", "journald_max_catchup");
+
         for (const auto& config : journaldConfigs)
         {
             if (!config.IsMap())
@@ -35,8 +38,12 @@ namespace logcollector
                 if (!filters.empty())
                 {
                     // Create a reader with all conditions
-                    AddReader(std::make_shared<JournaldReader>(
-                        *this, filters, config["ignore_if_missing"].as<bool>(false), fileWait));
+                    AddReader(std::make_shared<JournaldReader>(*this,
+                                                               filters,
+                                                               config["ignore_if_missing"].as<bool>(false),
+                                                               fileWait,
+                                                               maxCatchup,
+                                                               m_bookmarks));
                 }
             }
             else
@@ -46,8 +53,12 @@ namespace logcollector
                                             config["value"].as<std::string>(),
                                             config["exact_match"].as<bool>(true)}};
 
-                AddReader(std::make_shared<JournaldReader>(
-                    *this, filters, config["ignore_if_missing"].as<bool>(false), fileWait));
+                AddReader(std::make_shared<JournaldReader>(*this,
+                                                           filters,
+                                                           config["ignore_if_missing"].as<bool>(false),
+                                                           fileWait,
+                                                           maxCatchup,
+                                                           m_bookmarks));
             }
         }
     }
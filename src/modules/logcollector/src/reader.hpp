@@ -5,12 +5,22 @@
 #include <boost/asio/awaitable.hpp>
 #include <logcollector.hpp>
 
+#include <algorithm>
 #include <atomic>
+#include <chrono>
+#include <string>
+#include <vector>
 
 namespace logcollector
 {
     using Awaitable = boost::asio::awaitable<void>;
 
+    /// @brief First delay before retrying a push rejected by a full queue
+    constexpr std::chrono::milliseconds QUEUE_FULL_MIN_DELAY {50};
+
+    /// @brief Maximum delay between retries of a push rejected by a full queue
+    constexpr std::chrono::milliseconds QUEUE_FULL_MAX_DELAY {1000};
+
     /// @brief Interface for log readers
     class IReader
     {
@@ -33,6 +43,37 @@ namespace logcollector
         virtual void Stop() = 0;
 
     protected:
+        /// @brief Sends a batch of logs, waiting while the queue is full
+        ///
+        /// The push is retried with an increasing delay instead of dropping the
+        /// logs, so readers that save their position after this returns never
+        /// skip undelivered logs: they stay in the source until there is space.
+        /// The queue does not notify when space frees, so the logs may be sent
+        /// up to QUEUE_FULL_MAX_DELAY after that.
+        ///
+        /// @param location Location of the logs
+        /// @param logs Logs to send
+        /// @param collectorType Type of logcollector
+        /// @return True once the queue accepted the logs, false if the reader was stopped first
+        boost::asio::awaitable<bool>
+        DeliverLogs(const std::string& location, const std::vector<std::string>& logs, const std::string& collectorType)
+        {
+            auto delay = QUEUE_FULL_MIN_DELAY;
+
+            while (!m_logcollector.TrySendMessages(location, logs, collectorType))
+            {
+                if (!m_keepRunning.load())
+                {
+                    co_return false;
+                }
+
+                co_await m_logcollector.Wait(delay);
+                delay = std::min(delay * 2, QUEUE_FULL_MAX_DELAY);
+            }
+
+            co_return true;
+        }
+
         /// @brief Indicates if the log reader should keep running
         std::atomic<bool> m_keepRunning = true;
 
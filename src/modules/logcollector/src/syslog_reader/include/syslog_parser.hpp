@@ -0,0 +1,80 @@
+#pragma once
+
+#include <cstddef>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+namespace logcollector
+{
+    /// @brief Fields of a syslog message
+    ///
+    /// The fields are views of the parsed data, so they are valid as long as
+    /// the data is. Fields that are missing or have the nil value ("-") are empty.
+    struct SyslogMessage
+    {
+        /// @brief Priority (facility * 8 + severity), or -1 if the message has no priority
+        int priority {-1};
+
+        /// @brief Protocol version: 1 for RFC 5424 messages, 0 for RFC 3164 messages
+        int version {0};
+
+        /// @brief Timestamp, as it was written
+        std::string_view timestamp;
+
+        /// @brief Host that originated the message
+        std::string_view hostname;
+
+        /// @brief Application name (the tag in RFC 3164)
+        std::string_view appName;
+
+        /// @brief Process id
+        std::string_view procId;
+
+        /// @brief Message type (RFC 5424 only)
+        std::string_view msgId;
+
+        /// @brief Structured data elements, brackets included (RFC 5424 only)
+        std::string_view structuredData;
+
+        /// @brief Free-form message
+        std::string_view message;
+
+        /// @brief Gets the facility of the message
+        /// @return Facility, or -1 if the message has no priority
+        inline int Facility() const
+        {
+            return priority < 0 ? -1 : priority / 8;
+        }
+
+        /// @brief Gets the severity of the message
+        /// @return Severity, or -1 if the message has no priority
+        inline int Severity() const
+        {
+            return priority < 0 ? -1 : priority % 8;
+        }
+    };
+
+    /// @brief Parses a syslog message
+    ///
+    /// Messages with a version after the priority are parsed as RFC 5424.
+    /// Otherwise, they are parsed as RFC 3164, where every field is optional:
+    /// anything that does not look like a header is kept in the message.
+    ///
+    /// @param data Message, trailing line terminators are ignored
+    /// @return Fields of the message
+    SyslogMessage ParseSyslog(std::string_view data);
+
+    /// @brief Splits a syslog TCP stream into messages
+    ///
+    /// Each message is either octet-counted ("LENGTH SP MESSAGE") or terminated
+    /// by a newline, as described in RFC 6587. The framing is detected for each
+    /// message from its first characters, so senders may mix both.
+    ///
+    /// @param data Received data not yet split
+    /// @param frames Vector where the complete messages are appended
+    /// @param maxSize Maximum message size. Longer newline-terminated messages are split
+    /// @return Number of bytes consumed, or nullopt if an octet count is larger than maxSize
+    std::optional<size_t>
+    SplitSyslogFrames(std::string_view data, std::vector<std::string_view>& frames, size_t maxSize);
+} // namespace logcollector
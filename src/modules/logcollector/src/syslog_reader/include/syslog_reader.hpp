@@ -0,0 +1,126 @@
+#pragma once
+
+#include <reader.hpp>
+
+#include <boost/asio/any_io_executor.hpp>
+#include <boost/asio/awaitable.hpp>
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/asio/ip/udp.hpp>
+
+#include <atomic>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace logcollector
+{
+    const std::string SYSLOG_READER_TYPE = "syslog";
+
+    /// @brief Syslog reader class
+    ///
+    /// Receives syslog messages from the network, over UDP or TCP. Datagrams are
+    /// received in batches (with a single recvmmsg call on Linux), and TCP streams
+    /// accept both octet-counting and newline framing. The messages of each batch
+    /// are grouped by the host in their header, or the sender address if they have
+    /// none, and each group is sent to the queue with a single push.
+    class SyslogReader
+        : public IReader
+        , public std::enable_shared_from_this<SyslogReader>
+    {
+    public:
+        /// @brief Transport protocol
+        enum class Protocol
+        {
+            UDP,
+            TCP
+        };
+
+        /// @brief Constructor
+        /// @param logcollector Logcollector instance
+        /// @param protocol Transport protocol
+        /// @param address Address to listen on
+        /// @param port Port to listen on, 0 for any free port
+        SyslogReader(Logcollector& logcollector, Protocol protocol, std::string address, unsigned short port);
+
+        /// @brief Runs the syslog reader
+        /// @return Awaitable result
+        Awaitable Run() override;
+
+        /// @brief Stops the syslog reader
+        void Stop() override;
+
+        /// @brief Gets the port the reader is listening on
+        /// @return Port, or 0 if the socket is not bound yet
+        inline unsigned short LocalPort() const
+        {
+            return m_localPort.load();
+        }
+
+    private:
+        /// @brief Messages received in a batch, grouped by location
+        struct Batch
+        {
+            /// @brief Location and messages of each group
+            std::vector<std::pair<std::string, std::vector<std::string>>> groups;
+        };
+
+        /// @brief Receives datagrams until the reader is stopped
+        /// @return Awaitable result
+        Awaitable ReceiveDatagrams();
+
+        /// @brief Accepts TCP connections until the reader is stopped
+        /// @return Awaitable result
+        Awaitable AcceptConnections();
+
+        /// @brief Reads the messages of a TCP connection until it is closed
+        /// @param socket Connected socket
+        /// @return Awaitable result
+        Awaitable ReadConnection(std::shared_ptr<boost::asio::ip::tcp::socket> socket);
+
+        /// @brief Adds a message to a batch
+        /// @param batch Batch
+        /// @param data Message
+        /// @param peer Address of the sender, used as the location if the message has no hostname
+        void AddToBatch(Batch& batch, std::string_view data, std::string_view peer) const;
+
+        /// @brief Sends the messages of a batch, waiting while the queue is full
+        /// @param batch Batch, empty on return
+        /// @return Awaitable that returns false if the reader was stopped first
+        boost::asio::awaitable<bool> SendBatch(Batch& batch);
+
+        /// @brief Closes the sockets, to wake up the coroutines that use them
+        /// @note Must be called on the executor of the reader
+        void CloseSockets();
+
+        /// @brief Transport protocol
+        Protocol m_protocol;
+
+        /// @brief Address to listen on
+        std::string m_address;
+
+        /// @brief Port to listen on
+        unsigned short m_port;
+
+        /// @brief Port the socket is bound to
+        std::atomic<unsigned short> m_localPort {0};
+
+        /// @brief Mutex to access the executor and the sockets from Stop()
+        std::mutex m_mutex;
+
+        /// @brief Executor of the reader, where all its sockets are used
+        boost::asio::any_io_executor m_executor;
+
+        /// @brief UDP socket
+        std::unique_ptr<boost::asio::ip::udp::socket> m_udpSocket;
+
+        /// @brief TCP acceptor
+        std::unique_ptr<boost::asio::ip::tcp::acceptor> m_acceptor;
+
+        /// @brief Open TCP connections
+        std::list<std::weak_ptr<boost::asio::ip::tcp::socket>> m_connections;
+    };
+} // namespace logcollector
@@ -0,0 +1,345 @@
+#include "syslog_parser.hpp"
+
+#include <cctype>
+#include <string_view>
+
+using namespace logcollector;
+
+namespace
+{
+    /// @brief Value of the RFC 5424 fields that are not present
+    constexpr std::string_view NILVALUE = "-";
+
+    /// @brief Byte order mark that may precede an RFC 5424 message
+    constexpr std::string_view UTF8_BOM = "\xEF\xBB\xBF";
+
+    /// @brief Length of an RFC 3164 timestamp ("Mmm dd hh:mm:ss")
+    constexpr size_t BSD_TIMESTAMP_SIZE = 15;
+
+    /// @brief Maximum number of digits of an octet count
+    constexpr size_t MAX_OCTET_COUNT_DIGITS = 9;
+
+    inline bool IsDigit(char c)
+    {
+        return c >= '0' && c <= '9';
+    }
+
+    inline bool IsAlpha(char c)
+    {
+        return std::isalpha(static_cast<unsigned char>(c)) != 0;
+    }
+
+    /// @brief Takes the next field delimited by a space
+    std::string_view NextField(std::string_view& data)
+    {
+        const auto end = data.find(' ');
+        const auto field = data.substr(0, end);
+        data.remove_prefix(end == std::string_view::npos ? data.size() : end + 1);
+        return field;
+    }
+
+    /// @brief Maps the nil value to an empty field
+    std::string_view NilToEmpty(std::string_view field)
+    {
+        return field == NILVALUE ? std::string_view() : field;
+    }
+
+    /// @brief Takes the priority ("<PRI>") from the beginning of a message
+    bool ParsePriority(std::string_view& data, int& priority)
+    {
+        if (data.size() < 3 || data[0] != '<')
+        {
+            return false;
+        }
+
+        int value = 0;
+        size_t pos = 1;
+
+        // The priority has up to three digits and its maximum value is 191
+        for (; pos < data.size() && pos <= 3 && IsDigit(data[pos]); ++pos)
+        {
+            value = value * 10 + (data[pos] - '0');
+        }
+
+        if (pos == 1 || pos >= data.size() || data[pos] != '>' || value > 191)
+        {
+            return false;
+        }
+
+        priority = value;
+        data.remove_prefix(pos + 1);
+        return true;
+    }
+
+    /// @brief Checks if a message begins with an RFC 3164 timestamp followed by a space
+    bool IsBsdTimestamp(std::string_view data)
+    {
+        // The day of the month is padded with a space: "Jan  1 00:00:00"
+        return data.size() > BSD_TIMESTAMP_SIZE && IsAlpha(data[0]) && IsAlpha(data[1]) && IsAlpha(data[2]) &&
+               data[3] == ' ' && (data[4] == ' ' || IsDigit(data[4])) && IsDigit(data[5]) && data[6] == ' ' &&
+               IsDigit(data[7]) && IsDigit(data[8]) && data[9] == ':' && IsDigit(data[10]) && IsDigit(data[11]) &&
+               data[12] == ':' && IsDigit(data[13]) && IsDigit(data[14]) && data[BSD_TIMESTAMP_SIZE] == ' ';
+    }
+
+    /// @brief Checks if a message begins with an ISO 8601 timestamp, which some RFC 3164 senders use
+    bool IsIsoTimestamp(std::string_view data)
+    {
+        return data.size() > 10 && IsDigit(data[0]) && IsDigit(data[1]) && IsDigit(data[2]) && IsDigit(data[3]) &&
+               data[4] == '-' && IsDigit(data[5]) && IsDigit(data[6]) && data[7] == '-' && IsDigit(data[8]) &&
+               IsDigit(data[9]) && data[10] == 'T';
+    }
+
+    /// @brief Gets the length of the RFC 5424 structured data at the beginning of a message
+    /// @return Length, or 0 if there is no valid structured data
+    size_t StructuredDataLength(std::string_view data)
+    {
+        size_t pos = 0;
+
+        // One or more elements: [id name="value" ...], where values may contain escaped quotes and brackets
+        while (pos < data.size() && data[pos] == '[')
+        {
+            bool quoted = false;
+
+            for (++pos; pos < data.size(); ++pos)
+            {
+                const auto c = data[pos];
+
+                if (quoted && c == '\\')
+                {
+                    ++pos;
+                }
+                else if (c == '"')
+                {
+                    quoted = !quoted;
+                }
+                else if (c == ']' && !quoted)
+                {
+                    break;
+                }
+            }
+
+            if (pos >= data.size())
+            {
+                return 0;
+            }
+
+            ++pos;
+        }
+
+        return pos;
+    }
+
+    /// @brief Parses the header of an RFC 5424 message, after the version
+    void ParseRfc5424(std::string_view data, SyslogMessage& result)
+    {
+        result.version = 1;
+        result.timestamp = NilToEmpty(NextField(data));
+        result.hostname = NilToEmpty(NextField(data));
+        result.appName = NilToEmpty(NextField(data));
+        result.procId = NilToEmpty(NextField(data));
+        result.msgId = NilToEmpty(NextField(data));
+
+        if (data.starts_with(NILVALUE))
+        {
+            data.remove_prefix(NILVALUE.size());
+        }
+        else
+        {
+            const auto length = StructuredDataLength(data);
+            result.structuredData = data.substr(0, length);
+            data.remove_prefix(length);
+        }
+
+        if (data.starts_with(' '))
+        {
+            data.remove_prefix(1);
+        }
+
+        if (data.starts_with(UTF8_BOM))
+        {
+            data.remove_prefix(UTF8_BOM.size());
+        }
+
+        result.message = data;
+    }
+
+    /// @brief Parses the header of an RFC 3164 message, after the priority
+    void ParseRfc3164(std::string_view data, SyslogMessage& result)
+    {
+        if (IsBsdTimestamp(data))
+        {
+            result.timestamp = data.substr(0, BSD_TIMESTAMP_SIZE);
+            data.remove_prefix(BSD_TIMESTAMP_SIZE + 1);
+        }
+        else if (IsIsoTimestamp(data))
+        {
+            result.timestamp = NextField(data);
+        }
+
+        // The hostname follows the timestamp, unless the next word is already the tag
+        if (!result.timestamp.empty())
+        {
+            const auto end = data.find(' ');
+            const auto word = data.substr(0, end);
+
+            if (end != std::string_view::npos && !word.empty() && word.back() != ':' &&
+                word.find('[') == std::string_view::npos)
+            {
+                result.hostname = word;
+                data.remove_prefix(end + 1);
+            }
+        }
+
+        // The tag is "name:" or "name[pid]:", anything else is part of the message
+        const auto tagEnd = data.find_first_of("[: ");
+
+        if (tagEnd == std::string_view::npos || tagEnd == 0 || data[tagEnd] == ' ')
+        {
+            result.message = data;
+            return;
+        }
+
+        auto rest = data.substr(tagEnd);
+        std::string_view procId;
+
+        if (rest[0] == '[')
+        {
+            const auto close = rest.find(']');
+
+            if (close == std::string_view::npos)
+            {
+                result.message = data;
+                return;
+            }
+
+            procId = rest.substr(1, close - 1);
+            rest.remove_prefix(close + 1);
+        }
+
+        if (!rest.starts_with(':'))
+        {
+            result.message = data;
+            return;
+        }
+
+        rest.remove_prefix(1);
+
+        if (rest.starts_with(' '))
+        {
+            rest.remove_prefix(1);
+        }
+
+        result.appName = data.substr(0, tagEnd);
+        result.procId = procId;
+        result.message = rest;
+    }
+} // namespace
+
+namespace logcollector
+{
+    SyslogMessage ParseSyslog(std::string_view data)
+    {
+        SyslogMessage result;
+
+        while (!data.empty() && (data.back() == '\n' || data.back() == '\r' || data.back() == '\0'))
+        {
+            data.remove_suffix(1);
+        }
+
+        auto rest = data;
+
+        if (!ParsePriority(rest, result.priority))
+        {
+            result.message = data;
+            return result;
+        }
+
+        if (rest.size() >= 2 && rest[0] == '1' && rest[1] == ' ')
+        {
+            ParseRfc5424(rest.substr(2), result);
+        }
+        else
+        {
+            ParseRfc3164(rest, result);
+        }
+
+        return result;
+    }
+
+    std::optional<size_t>
+    SplitSyslogFrames(std::string_view data, std::vector<std::string_view>& frames, size_t maxSize)
+    {
+        size_t pos = 0;
+
+        while (pos < data.size())
+        {
+            // Octet counting: the length has no leading zeros and is followed by a space
+            if (data[pos] >= '1' && data[pos] <= '9')
+            {
+                size_t digitsEnd = pos;
+                size_t length = 0;
+
+                while (digitsEnd < data.size() && digitsEnd - pos < MAX_OCTET_COUNT_DIGITS && IsDigit(data[digitsEnd]))
+                {
+                    length = length * 10 + static_cast<size_t>(data[digitsEnd] - '0');
+                    ++digitsEnd;
+                }
+
+                if (digitsEnd == data.size())
+                {
+                    // The length is not complete yet
+                    break;
+                }
+
+                if (data[digitsEnd] == ' ')
+                {
+                    if (length > maxSize)
+                    {
+                        return std::nullopt;
+                    }
+
+                    if (data.size() - digitsEnd - 1 < length)
+                    {
+                        break;
+                    }
+
+                    frames.push_back(data.substr(digitsEnd + 1, length));
+                    pos = digitsEnd + 1 + length;
+                    continue;
+                }
+            }
+
+            // Newline framing: messages longer than the maximum size are split
+            const auto newline = data.find('\n', pos);
+            const auto length = (newline == std::string_view::npos ? data.size() : newline) - pos;
+
+            if (newline == std::string_view::npos ? length >= maxSize : length > maxSize)
+            {
+                frames.push_back(data.substr(pos, maxSize));
+                pos += maxSize;
+                continue;
+            }
+
+            if (newline == std::string_view::npos)
+            {
+                break;
+            }
+
+            auto frame = data.substr(pos, length);
+
+            if (frame.ends_with('\r'))
+            {
+                frame.remove_suffix(1);
+            }
+
+            if (!frame.empty())
+            {
+                frames.push_back(frame);
+            }
+
+            pos = newline + 1;
+        }
+
+        return pos;
+    }
+} // namespace logcollector
@@ -0,0 +1,477 @@
+#include "syslog_reader.hpp"
+
+#include <logcollector.hpp>
+#include <logger.hpp>
+#include <syslog_parser.hpp>
+
+#include <boost/asio/buffer.hpp>
+#include <boost/asio/co_spawn.hpp>
+#include <boost/asio/detached.hpp>
+#include <boost/asio/ip/address.hpp>
+#include <boost/asio/post.hpp>
+#include <boost/asio/redirect_error.hpp>
+#include <boost/asio/this_coro.hpp>
+#include <boost/asio/use_awaitable.hpp>
+
+#if defined(__linux__)
+#include <sys/socket.h>
+#endif
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <utility>
+
+using namespace logcollector;
+
+namespace
+{
+    /// @brief Maximum size of a message. Longer datagrams are truncated
+    constexpr size_t MAX_MESSAGE_SIZE = 8192;
+
+    /// @brief Maximum number of datagrams received at once
+    constexpr size_t UDP_BATCH_SIZE = 64;
+
+    /// @brief Receive buffer requested for the UDP socket, to absorb bursts
+    constexpr int UDP_RECEIVE_BUFFER_SIZE = 4 * 1024 * 1024;
+
+    /// @brief Number of bytes requested on each TCP read
+    constexpr size_t TCP_READ_SIZE = 64 * 1024;
+
+    /// @brief Number of locations kept in a batch between sends
+    constexpr size_t MAX_BATCH_GROUPS = 64;
+
+    /// @brief Time to wait before accepting connections again after an error
+    constexpr std::chrono::milliseconds ACCEPT_RETRY_DELAY {1000};
+
+    /// @brief Removes the line terminators at the end of a message
+    std::string_view TrimMessage(std::string_view data)
+    {
+        while (!data.empty() && (data.back() == '\n' || data.back() == '\r' || data.back() == '\0'))
+        {
+            data.remove_suffix(1);
+        }
+
+        return data;
+    }
+} // namespace
+
+SyslogReader::SyslogReader(Logcollector& logcollector, Protocol protocol, std::string address, unsigned short port)
+    : IReader(logcollector)
+    , m_protocol(protocol)
+    , m_address(std::move(address))
+    , m_port(port)
+{
+}
+
+Awaitable SyslogReader::Run()
+{
+    const auto executor = co_await boost::asio::this_coro::executor;
+
+    {
+        // Sockets are closed on this executor, so that it never races with their operations
+        const std::lock_guard<std::mutex> lock(m_mutex);
+
+        if (!m_keepRunning.load())
+        {
+            co_return;
+        }
+
+        m_executor = executor;
+    }
+
+    if (m_protocol == Protocol::UDP)
+    {
+        co_await ReceiveDatagrams();
+    }
+    else
+    {
+        co_await AcceptConnections();
+    }
+}
+
+void SyslogReader::Stop()
+{
+    m_keepRunning.store(false);
+
+    boost::asio::any_io_executor executor;
+
+    {
+        const std::lock_guard<std::mutex> lock(m_mutex);
+        executor = m_executor;
+    }
+
+    if (executor)
+    {
+        boost::asio::post(executor, [self = shared_from_this()]() { self->CloseSockets(); });
+    }
+}
+
+void SyslogReader::CloseSockets()
+{
+    const std::lock_guard<std::mutex> lock(m_mutex);
+    boost::system::error_code ec;
+
+    if (m_udpSocket)
+    {
+        m_udpSocket->close(ec);
+    }
+
+    if (m_acceptor)
+    {
+        m_acceptor->close(ec);
+    }
+
+    for (const auto& connection : m_connections)
+    {
+        if (auto socket = connection.lock())
+        {
+            socket->close(ec);
+        }
+    }
+
+    m_connections.clear();
+}
+
+Awaitable SyslogReader::ReceiveDatagrams()
+{
+    boost::system::error_code ec;
+    const auto address = boost::asio::ip::make_address(m_address, ec);
+
+    if (ec)
+    {
+        LogError("Invalid syslog address '{}': {}.", m_address, ec.message());
+        co_return;
+    }
+
+    const boost::asio::ip::udp::endpoint endpoint(address, m_port);
+
+    {
+        const std::lock_guard<std::mutex> lock(m_mutex);
+        m_udpSocket = std::make_unique<boost::asio::ip::udp::socket>(m_executor);
+        m_udpSocket->open(endpoint.protocol(), ec);
+
+        if (!ec)
+        {
+            m_udpSocket->bind(endpoint, ec);
+        }
+    }
+
+    if (ec)
+    {
+        LogError("Cannot listen for syslog messages on {}:{}/udp: {}.", m_address, m_port, ec.message());
+        co_return;
+    }
+
+    auto& socket = *m_udpSocket;
+    boost::system::error_code optionError;
+    socket.set_option(boost::asio::socket_base::receive_buffer_size(UDP_RECEIVE_BUFFER_SIZE), optionError);
+    m_localPort.store(socket.local_endpoint(ec).port());
+    LogInfo("Listening for syslog messages on {}:{}/udp.", m_address, m_localPort.load());
+
+    Batch batch;
+
+#if defined(__linux__)
+    std::vector<char> buffer(UDP_BATCH_SIZE * MAX_MESSAGE_SIZE);
+    std::vector<mmsghdr> headers(UDP_BATCH_SIZE);
+    std::vector<iovec> vectors(UDP_BATCH_SIZE);
+    std::vector<sockaddr_storage> senders(UDP_BATCH_SIZE);
+    boost::asio::ip::udp::endpoint lastSender;
+    std::string lastSenderAddress;
+
+    for (size_t i = 0; i < UDP_BATCH_SIZE; ++i)
+    {
+        vectors[i].iov_base = buffer.data() + i * MAX_MESSAGE_SIZE;
+        vectors[i].iov_len = MAX_MESSAGE_SIZE;
+    }
+
+    while (m_keepRunning.load())
+    {
+        co_await socket.async_wait(boost::asio::ip::udp::socket::wait_read,
+                                   boost::asio::redirect_error(boost::asio::use_awaitable, ec));
+
+        if (ec)
+        {
+            break;
+        }
+
+        for (size_t i = 0; i < UDP_BATCH_SIZE; ++i)
+        {
+            headers[i] = {};
+            headers[i].msg_hdr.msg_iov = &vectors[i];
+            headers[i].msg_hdr.msg_iovlen = 1;
+            headers[i].msg_hdr.msg_name = &senders[i];
+            headers[i].msg_hdr.msg_namelen = sizeof(sockaddr_storage);
+        }
+
+        // A single call receives all the queued datagrams, up to the batch size
+        const auto count = recvmmsg(
+            socket.native_handle(), headers.data(), static_cast<unsigned int>(UDP_BATCH_SIZE), MSG_DONTWAIT, nullptr);
+
+        if (count < 0)
+        {
+            if (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)
+            {
+                continue;
+            }
+
+            LogWarn("Cannot receive syslog messages: {}.", std::strerror(errno));
+            break;
+        }
+
+        for (size_t i = 0; i < static_cast<size_t>(count); ++i)
+        {
+            const auto& header = headers[i].msg_hdr;
+            boost::asio::ip::udp::endpoint sender;
+            std::memcpy(sender.data(), &senders[i], std::min<size_t>(header.msg_namelen, sender.capacity()));
+            sender.resize(std::min<size_t>(header.msg_namelen, sender.capacity()));
+
+            if (sender != lastSender || lastSenderAddress.empty())
+            {
+                lastSender = sender;
+                lastSenderAddress = sender.address().to_string();
+            }
+
+            if ((header.msg_flags & MSG_TRUNC) != 0)
+            {
+                LogDebug("Syslog message from {} truncated to {} bytes.", lastSenderAddress, MAX_MESSAGE_SIZE);
+            }
+
+            AddToBatch(batch,
+                       std::string_view(buffer.data() + i * MAX_MESSAGE_SIZE, headers[i].msg_len),
+                       lastSenderAddress);
+        }
+
+        if (!co_await SendBatch(batch))
+        {
+            break;
+        }
+    }
+#else
+    std::vector<char> buffer(MAX_MESSAGE_SIZE);
+    boost::asio::ip::udp::endpoint sender;
+
+    while (m_keepRunning.load())
+    {
+        auto length = co_await socket.async_receive_from(
+            boost::asio::buffer(buffer), sender, boost::asio::redirect_error(boost::asio::use_awaitable, ec));
+
+        if (ec && ec != boost::asio::error::message_size)
+        {
+            break;
+        }
+
+        AddToBatch(batch, std::string_view(buffer.data(), length), sender.address().to_string());
+
+        // Take the datagrams that are already queued, so that they are sent with a single push
+        for (size_t i = 1; i < UDP_BATCH_SIZE && socket.available(ec) > 0 && !ec; ++i)
+        {
+            length = socket.receive_from(boost::asio::buffer(buffer), sender, 0, ec);
+
+            if (ec && ec != boost::asio::error::message_size)
+            {
+                break;
+            }
+
+            AddToBatch(batch, std::string_view(buffer.data(), length), sender.address().to_string());
+        }
+
+        if (!co_await SendBatch(batch))
+        {
+            break;
+        }
+    }
+#endif
+}
+
+Awaitable SyslogReader::AcceptConnections()
+{
+    boost::system::error_code ec;
+    const auto address = boost::asio::ip::make_address(m_address, ec);
+
+    if (ec)
+    {
+        LogError("Invalid syslog address '{}': {}.", m_address, ec.message());
+        co_return;
+    }
+
+    const boost::asio::ip::tcp::endpoint endpoint(address, m_port);
+
+    {
+        const std::lock_guard<std::mutex> lock(m_mutex);
+        m_acceptor = std::make_unique<boost::asio::ip::tcp::acceptor>(m_executor);
+        m_acceptor->open(endpoint.protocol(), ec);
+
+        if (!ec)
+        {
+            m_acceptor->set_option(boost::asio::socket_base::reuse_address(true), ec);
+            m_acceptor->bind(endpoint, ec);
+        }
+
+        if (!ec)
+        {
+            m_acceptor->listen(boost::asio::socket_base::max_listen_connections, ec);
+        }
+    }
+
+    if (ec)
+    {
+        LogError("Cannot listen for syslog messages on {}:{}/tcp: {}.", m_address, m_port, ec.message());
+        co_return;
+    }
+
+    m_localPort.store(m_acceptor->local_endpoint(ec).port());
+    LogInfo("Listening for syslog messages on {}:{}/tcp.", m_address, m_localPort.load());
+
+    while (m_keepRunning.load())
+    {
+        auto socket = std::make_shared<boost::asio::ip::tcp::socket>(m_executor);
+        co_await m_acceptor->async_accept(*socket, boost::asio::redirect_error(boost::asio::use_awaitable, ec));
+
+        if (ec)
+        {
+            if (!m_keepRunning.load() || ec == boost::asio::error::operation_aborted)
+            {
+                break;
+            }
+
+            // E.g. out of file descriptors, accepting again right away would fail too
+            LogWarn("Cannot accept syslog connection: {}.", ec.message());
+            co_await m_logcollector.Wait(ACCEPT_RETRY_DELAY);
+            continue;
+        }
+
+        {
+            const std::lock_guard<std::mutex> lock(m_mutex);
+            m_connections.remove_if([](const auto& connection) { return connection.expired(); });
+            m_connections.push_back(socket);
+        }
+
+        // Connections run on the executor of the reader, so that Stop() can close them safely
+        boost::asio::co_spawn(
+            m_executor,
+            [self = shared_from_this(), socket]() { return self->ReadConnection(socket); },
+            boost::asio::detached);
+    }
+}
+
+Awaitable SyslogReader::ReadConnection(std::shared_ptr<boost::asio::ip::tcp::socket> socket)
+{
+    boost::system::error_code ec;
+    const auto remote = socket->remote_endpoint(ec);
+    const auto peer = ec ? std::string() : remote.address().to_string();
+
+    // Pending data is always shorter than a message plus its octet count, so there is room for another read
+    std::vector<char> buffer(TCP_READ_SIZE + MAX_MESSAGE_SIZE);
+    std::vector<std::string_view> frames;
+    size_t begin = 0;
+    size_t end = 0;
+    Batch batch;
+
+    LogDebug("Syslog connection from {}.", peer);
+
+    while (m_keepRunning.load())
+    {
+        if (buffer.size() - end < MAX_MESSAGE_SIZE)
+        {
+            std::memmove(buffer.data(), buffer.data() + begin, end - begin);
+            end -= begin;
+            begin = 0;
+        }
+
+        const auto length = co_await socket->async_read_some(
+            boost::asio::buffer(buffer.data() + end, buffer.size() - end),
+            boost::asio::redirect_error(boost::asio::use_awaitable, ec));
+
+        if (ec)
+        {
+            break;
+        }
+
+        end += length;
+        const auto consumed =
+            SplitSyslogFrames(std::string_view(buffer.data() + begin, end - begin), frames, MAX_MESSAGE_SIZE);
+
+        if (!consumed)
+        {
+            LogWarn("Syslog message from {} is longer than {} bytes, closing the connection.", peer, MAX_MESSAGE_SIZE);
+            break;
+        }
+
+        for (const auto frame : frames)
+        {
+            AddToBatch(batch, frame, peer);
+        }
+
+        frames.clear();
+        begin += *consumed;
+
+        if (begin == end)
+        {
+            begin = 0;
+            end = 0;
+        }
+
+        if (!co_await SendBatch(batch))
+        {
+            break;
+        }
+    }
+
+    // The last message may not be terminated when the sender closes the connection
+    if (ec == boost::asio::error::eof && begin < end)
+    {
+        AddToBatch(batch, std::string_view(buffer.data() + begin, end - begin), peer);
+        co_await SendBatch(batch);
+    }
+
+    LogDebug("Syslog connection from {} closed.", peer);
+    socket->close(ec);
+}
+
+void SyslogReader::AddToBatch(Batch& batch, std::string_view data, std::string_view peer) const
+{
+    data = TrimMessage(data);
+
+    if (data.empty())
+    {
+        return;
+    }
+
+    const auto message = ParseSyslog(data);
+    const auto location = message.hostname.empty() ? peer : message.hostname;
+
+    auto group = std::find_if(
+        batch.groups.begin(), batch.groups.end(), [location](const auto& entry) { return entry.first == location; });
+
+    if (group == batch.groups.end())
+    {
+        group = batch.groups.insert(batch.groups.end(), {std::string(location), {}});
+    }
+
+    group->second.emplace_back(data);
+}
+
+boost::asio::awaitable<bool> SyslogReader::SendBatch(Batch& batch)
+{
+    bool delivered = true;
+
+    for (auto& group : batch.groups)
+    {
+        if (delivered && !group.second.empty())
+        {
+            delivered = co_await DeliverLogs(group.first, group.second, SYSLOG_READER_TYPE);
+        }
+
+        group.second.clear();
+    }
+
+    // The groups are kept to reuse their buffers, unless messages come from many hosts
+    if (batch.groups.size() > MAX_BATCH_GROUPS)
+    {
+        batch.groups.clear();
+    }
+
+    co_return delivered;
+}
@@ -0,0 +1,434 @@
+// Measures the file reader pipeline: a generator appends lines to a set of
+// temporary files at a fixed rate, optionally rotating them, while Logcollector
+// tails them into an in-memory sink or into the real message queue. Reports the
+// delivered lines per second, the delay from write to push and the CPU used by
+// the readers, so that polling and notifications, or different thread counts and
+// intervals, can be compared.
+//
+// Options (--name=value):
+//   --files         Number of files                          (4)
+//   --rate          Lines per second per file                (10000)
+//   --size          Line size in bytes                       (200)
+//   --duration      Seconds of generation                    (5)
+//   --rotate-every  Lines between rotations, 0 to not rotate (0)
+//   --sink          memory or queue                          (memory)
+//   --threads       Logcollector threads                     (1)
+//   --interval      Read interval in milliseconds            (500)
+//   --polling       1 to disable file notifications          (0)
+
+#include <logcollector.hpp>
+#include <multitype_queue.hpp>
+
+#include <sys/resource.h>
+
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+using namespace logcollector;
+
+namespace
+{
+    constexpr auto TICK = std::chrono::milliseconds(1);
+    constexpr auto STARTUP_DELAY = std::chrono::milliseconds(500);
+    constexpr auto DRAIN_TIMEOUT = std::chrono::seconds(3);
+    constexpr std::string_view TIMESTAMP_KEY = "ts=";
+
+    /// @brief Benchmark options
+    struct Options
+    {
+        size_t files {4};
+        size_t rate {10000};
+        size_t size {200};
+        size_t duration {5};
+        size_t rotateEvery {0};
+        std::string sink {"memory"};
+        size_t threads {1};
+        size_t interval {500};
+        bool polling {false};
+    };
+
+    /// @brief Parses the --name=value options
+    Options ParseOptions(int argc, char* argv[])
+    {
+        std::map<std::string, std::string> values;
+
+        for (int i = 1; i < argc; ++i)
+        {
+            const std::string_view arg = argv[i];
+            const auto separator = arg.find('=');
+
+            if (arg.substr(0, 2) == "--" && separator != std::string_view::npos)
+            {
+                values[std::string(arg.substr(2, separator - 2))] = std::string(arg.substr(separator + 1));
+            }
+        }
+
+        const auto number = [&values](const std::string& name, size_t fallback)
+        {
+            const auto it = values.find(name);
+            return it == values.end() ? fallback : static_cast<size_t>(std::stoull(it->second));
+        };
+
+        Options options;
+        options.files = std::max<size_t>(number("files", options.files), 1);
+        options.rate = number("rate", options.rate);
+        options.size = number("size", options.size);
+        options.duration = number("duration", options.duration);
+        options.rotateEvery = number("rotate-every", options.rotateEvery);
+        options.sink = values.count("sink") != 0 ? values["sink"] : options.sink;
+        options.threads = std::max<size_t>(number("threads", options.threads), 1);
+        options.interval = number("interval", options.interval);
+        options.polling = number("polling", 0) != 0;
+        return options;
+    }
+
+    /// @brief Gets the current time of the steady clock in nanoseconds
+    int64_t Now()
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                   std::chrono::steady_clock::now().time_since_epoch())
+            .count();
+    }
+
+    /// @brief Gets the CPU time used by the calling thread, in seconds
+    double ThreadCpu()
+    {
+        timespec ts {};
+        clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+        return static_cast<double>(ts.tv_sec) + static_cast<double>(ts.tv_nsec) / 1e9;
+    }
+
+    /// @brief Gets the CPU time used by the process, in seconds
+    double ProcessCpu()
+    {
+        rusage usage {};
+        getrusage(RUSAGE_SELF, &usage);
+        const auto seconds = [](const timeval& tv)
+        {
+            return static_cast<double>(tv.tv_sec) + static_cast<double>(tv.tv_usec) / 1e6;
+        };
+        return seconds(usage.ru_utime) + seconds(usage.ru_stime);
+    }
+
+    /// @brief Records the delay between the write and the push of each line
+    class DelayRecorder
+    {
+    public:
+        /// @brief Measures the delays of the logs of a message, before it is pushed
+        static std::vector<int64_t> Measure(const nlohmann::json& data)
+        {
+            const auto now = Now();
+            std::vector<int64_t> delays;
+
+            // A batch of logs is pushed as an array, a single log as an object
+            if (data.is_array())
+            {
+                delays.reserve(data.size());
+
+                for (const auto& log : data)
+                {
+                    delays.push_back(now - Written(log));
+                }
+            }
+            else
+            {
+                delays.push_back(now - Written(data));
+            }
+
+            return delays;
+        }
+
+        /// @brief Records the delays of a pushed message
+        void Add(const std::vector<int64_t>& delays)
+        {
+            const std::lock_guard<std::mutex> lock(m_mutex);
+            m_delays.insert(m_delays.end(), delays.begin(), delays.end());
+        }
+
+        size_t Count()
+        {
+            const std::lock_guard<std::mutex> lock(m_mutex);
+            return m_delays.size();
+        }
+
+        std::vector<int64_t> TakeDelays()
+        {
+            const std::lock_guard<std::mutex> lock(m_mutex);
+            return std::move(m_delays);
+        }
+
+    private:
+        /// @brief Gets the time when a log was written, from its timestamp field
+        static int64_t Written(const nlohmann::json& log)
+        {
+            const auto& line = log["event"]["original"].get_ref<const std::string&>();
+            const auto start = line.find(TIMESTAMP_KEY);
+            int64_t written = 0;
+
+            if (start != std::string::npos)
+            {
+                const auto* first = line.data() + start + TIMESTAMP_KEY.size();
+                std::from_chars(first, line.data() + line.size(), written);
+            }
+
+            return written;
+        }
+
+        std::mutex m_mutex;
+        std::vector<int64_t> m_delays;
+    };
+
+    /// @brief Logcollector with a public constructor
+    class BenchmarkLogcollector : public Logcollector
+    {
+    public:
+        BenchmarkLogcollector() = default;
+    };
+
+    /// @brief Appends lines to the files at the configured rate, rotating them every rotateEvery lines
+    /// @return Number of lines written
+    size_t GenerateLines(const Options& options, const std::vector<std::string>& paths, double& cpu)
+    {
+        std::vector<std::ofstream> files;
+        std::vector<size_t> sinceRotation(paths.size(), 0);
+        size_t written = 0;
+        size_t sequence = 0;
+
+        for (const auto& path : paths)
+        {
+            files.emplace_back(path, std::ios::app);
+        }
+
+        const auto start = std::chrono::steady_clock::now();
+        const auto end = start + std::chrono::seconds(options.duration);
+        std::string line;
+
+        for (auto now = start; now < end; now = std::chrono::steady_clock::now())
+        {
+            // Every tick writes the lines that are due since the start
+            const auto elapsed = std::chrono::duration<double>(now - start).count();
+            const auto due = static_cast<size_t>(elapsed * static_cast<double>(options.rate));
+            const auto perFile = written / paths.size();
+
+            for (size_t lines = perFile; lines < due; ++lines)
+            {
+                for (size_t i = 0; i < paths.size(); ++i)
+                {
+                    if (options.rotateEvery > 0 && sinceRotation[i] == options.rotateEvery)
+                    {
+                        files[i].close();
+                        std::filesystem::rename(paths[i], paths[i] + ".1");
+                        files[i].open(paths[i], std::ios::app);
+                        sinceRotation[i] = 0;
+                    }
+
+                    line = std::string(TIMESTAMP_KEY) + std::to_string(Now()) + " seq=" + std::to_string(sequence++) +
+                           " file=" + std::to_string(i) + " ";
+                    line.resize(std::max(options.size, line.size() + 1), 'x');
+                    line.back() = '\n';
+                    files[i] << line;
+                    ++sinceRotation[i];
+                    ++written;
+                }
+            }
+
+            for (auto& file : files)
+            {
+                file.flush();
+            }
+
+            std::this_thread::sleep_for(TICK);
+        }
+
+        cpu = ThreadCpu();
+        return written;
+    }
+
+    /// @brief Builds the configuration of the module and the queue
+    std::string Configuration(const Options& options,
+                              const std::filesystem::path& directory,
+                              const std::vector<std::string>& paths)
+    {
+        std::string config = "agent:\n"
+                             "  path.data: " +
+                             directory.string() +
+                             "\n"
+                             "  queue_size: 1000000\n"
+                             "logcollector:\n"
+                             "  enabled: true\n"
+                             "  thread_count: " +
+                             std::to_string(options.threads) +
+                             "\n"
+                             "  read_interval: " +
+                             std::to_string(options.interval) +
+                             "ms\n"
+                             "  reload_interval: 60s\n"
+                             "  file_notifications: " +
+                             (options.polling ? "false" : "true") +
+                             "\n"
+                             "  localfiles:\n";
+
+        for (const auto& path : paths)
+        {
+            config += "    - " + path + "\n";
+        }
+
+        return config;
+    }
+
+    /// @brief Gets a percentile of the sorted delays, in milliseconds
+    double Percentile(const std::vector<int64_t>& sorted, double fraction)
+    {
+        if (sorted.empty())
+        {
+            return 0;
+        }
+
+        const auto index = static_cast<size_t>(fraction * static_cast<double>(sorted.size() - 1));
+        return static_cast<double>(sorted[index]) / 1e6;
+    }
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    const auto options = ParseOptions(argc, argv);
+    const auto directory = std::filesystem::temp_directory_path() / ("file_reader_benchmark_" + std::to_string(Now()));
+    std::filesystem::create_directories(directory);
+
+    std::vector<std::string> paths;
+
+    for (size_t i = 0; i < options.files; ++i)
+    {
+        paths.push_back((directory / ("bench" + std::to_string(i) + ".log")).string());
+        std::ofstream(paths.back()).close();
+    }
+
+    auto config =
+        std::make_shared<configuration::ConfigurationParser>(Configuration(options, directory, paths));
+    DelayRecorder recorder;
+    std::shared_ptr<MultiTypeQueue> queue;
+    std::atomic<bool> consuming {true};
+    std::thread consumer;
+    double consumerCpu = 0;
+
+    BenchmarkLogcollector logcollector;
+
+    if (options.sink == "queue")
+    {
+        // A consumer drains the queue, as the agent's stateless sender would
+        queue = std::make_shared<MultiTypeQueue>(config);
+        consumer = std::thread(
+            [&queue, &consuming, &consumerCpu]()
+            {
+                while (consuming.load())
+                {
+                    if (const auto stored = queue->storedItems(MessageType::STATELESS); stored > 0)
+                    {
+                        queue->popN(MessageType::STATELESS, stored);
+                    }
+                    else
+                    {
+                        std::this_thread::sleep_for(TICK);
+                    }
+                }
+
+                consumerCpu = ThreadCpu();
+            });
+
+        logcollector.SetPushMessageFunction(
+            [&queue, &recorder](Message message)
+            {
+                const auto delays = DelayRecorder::Measure(message.data);
+                const auto pushed = queue->push(std::move(message));
+
+                if (pushed > 0)
+                {
+                    recorder.Add(delays);
+                }
+
+                return pushed;
+            });
+    }
+    else
+    {
+        logcollector.SetPushMessageFunction(
+            [&recorder](Message message) // NOLINT(performance-unnecessary-value-param)
+            {
+                recorder.Add(DelayRecorder::Measure(message.data));
+                return 1;
+            });
+    }
+
+    logcollector.Setup(config);
+
+    const auto cpuBefore = ProcessCpu();
+    std::thread module([&logcollector]() { logcollector.Start(); });
+
+    // Files without a saved position are read from the end, so the readers must open them first
+    std::this_thread::sleep_for(STARTUP_DELAY);
+
+    const auto start = std::chrono::steady_clock::now();
+    double generatorCpu = 0;
+    const auto written = GenerateLines(options, paths, generatorCpu);
+
+    // The readers are done when every line is pushed, or no more lines arrive
+    auto last = std::chrono::steady_clock::now();
+    size_t received = recorder.Count();
+
+    while (received < written && std::chrono::steady_clock::now() - last < DRAIN_TIMEOUT)
+    {
+        std::this_thread::sleep_for(TICK);
+
+        if (const auto current = recorder.Count(); current != received)
+        {
+            received = current;
+            last = std::chrono::steady_clock::now();
+        }
+    }
+
+    const auto elapsed = std::chrono::duration<double>(last - start).count();
+    const auto readersCpu = ProcessCpu() - cpuBefore - generatorCpu;
+
+    logcollector.Stop();
+    module.join();
+
+    if (consumer.joinable())
+    {
+        consuming.store(false);
+        consumer.join();
+    }
+
+    auto delays = recorder.TakeDelays();
+    std::sort(delays.begin(), delays.end());
+
+    const auto cpu = std::max(readersCpu - consumerCpu, 0.0) / elapsed * 100;
+    const auto lost = written > received ? written - received : 0;
+
+    std::cout << "files " << options.files << "  rate " << options.rate << " lines/s/file  size " << options.size
+              << " B  rotate every " << options.rotateEvery << "  sink " << options.sink << "  threads "
+              << options.threads << "  " << (options.polling ? "polling" : "notifications") << "\n";
+    std::cout << "written " << written << "  received " << received << "  lost " << lost << "\n";
+    std::cout << "throughput " << static_cast<double>(received) / elapsed << " lines/s\n";
+    std::cout << "delay p50 " << Percentile(delays, 0.5) << " ms  p99 " << Percentile(delays, 0.99) << " ms  max "
+              << Percentile(delays, 1) << " ms\n";
+    std::cout << "cpu " << cpu << "% of a core, " << cpu / static_cast<double>(options.files) << "% per reader\n";
+
+    queue.reset();
+    std::filesystem::remove_all(directory);
+    return 0;
+}
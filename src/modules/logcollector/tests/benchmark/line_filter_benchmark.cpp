@@ -0,0 +1,135 @@
+// Measures the cost per line of the localfile filters, compared with checking
+// every pattern with its own regular expression.
+
+#include <line_filter.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <iostream>
+#include <random>
+#include <regex>
+#include <string>
+#include <vector>
+
+using namespace logcollector;
+
+namespace
+{
+    constexpr size_t LINE_COUNT = 20000;
+    constexpr unsigned int SEED = 42;
+
+    /// @brief Generates syslog-like lines from a small set of services
+    std::vector<std::string> GenerateLines()
+    {
+        const std::vector<std::string> messages = {
+            "sshd[1234]: Failed password for invalid user admin from 10.0.0.1 port 22 ssh2",
+            "sshd[1234]: Accepted publickey for deploy from 10.0.0.2 port 51234 ssh2",
+            "sudo: deploy : TTY=pts/0 ; PWD=/home/deploy ; USER=root ; COMMAND=/usr/bin/systemctl restart nginx",
+            "CRON[4321]: (root) CMD (run-parts /etc/cron.hourly)",
+            "kernel: [12345.678901] EXT4-fs (sda1): re-mounted. Opts: errors=remount-ro",
+            "systemd[1]: Started Session 42 of user deploy.",
+            "nginx[999]: 10.0.0.3 - - \"GET /index.html HTTP/1.1\" 200 612",
+        };
+
+        std::mt19937 random(SEED);
+        std::uniform_int_distribution<size_t> pick(0, messages.size() - 1);
+        std::vector<std::string> lines;
+        lines.reserve(LINE_COUNT);
+
+        for (size_t i = 0; i < LINE_COUNT; ++i)
+        {
+            lines.push_back("Jan  1 00:00:00 host " + messages[pick(random)]);
+        }
+
+        return lines;
+    }
+
+    /// @brief Generates patterns, a fifth of them plain literals and the rest regular expressions
+    std::vector<std::string> GeneratePatterns(size_t count)
+    {
+        std::vector<std::string> patterns;
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            const auto id = std::to_string(i);
+
+            switch (i % 5)
+            {
+                case 0: patterns.push_back("service" + id + ": started"); break;
+                case 1: patterns.push_back("user" + id + " from \\d+\\.\\d+"); break;
+                case 2: patterns.push_back("^\\w+ +\\d+ .*daemon" + id + "\\["); break;
+                case 3: patterns.push_back("COMMAND=/usr/bin/tool" + id + "( |$)"); break;
+                default: patterns.push_back("error code " + id + "\\b"); break;
+            }
+        }
+
+        return patterns;
+    }
+
+    /// @brief Runs a check over all lines and returns the nanoseconds per line
+    template<typename Check>
+    double NanosecondsPerLine(const std::vector<std::string>& lines, Check check, size_t& matches)
+    {
+        const auto start = std::chrono::steady_clock::now();
+
+        for (const auto& line : lines)
+        {
+            matches += check(line) ? 1U : 0U;
+        }
+
+        const auto elapsed = std::chrono::steady_clock::now() - start;
+        return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()) /
+               static_cast<double>(lines.size());
+    }
+} // namespace
+
+int main()
+{
+    const auto lines = GenerateLines();
+
+    std::cout << "patterns  filter ns/line  regex-only ns/line\n";
+
+    for (const size_t count : {1UL, 50UL, 500UL})
+    {
+        const auto patterns = GeneratePatterns(count);
+        const LineFilter filter({}, patterns);
+
+        std::vector<std::regex> regexes;
+
+        for (const auto& pattern : patterns)
+        {
+            regexes.emplace_back(pattern, std::regex::ECMAScript | std::regex::optimize);
+        }
+
+        size_t filterMatches = 0;
+        size_t regexMatches = 0;
+
+        const auto filterTime =
+            NanosecondsPerLine(lines, [&filter](const std::string& line) { return !filter.Accepts(line); }, filterMatches);
+
+        const auto regexTime = NanosecondsPerLine(
+            lines,
+            [&regexes](const std::string& line)
+            {
+                for (const auto& regex : regexes)
+                {
+                    if (std::regex_search(line, regex))
+                    {
+                        return true;
+                    }
+                }
+                return false;
+            },
+            regexMatches);
+
+        if (filterMatches != regexMatches)
+        {
+            std::cerr << "Mismatch with " << count << " patterns: " << filterMatches << " != " << regexMatches << "\n";
+            return 1;
+        }
+
+        std::cout << count << "\t  " << filterTime << "\t  " << regexTime << "\n";
+    }
+
+    return 0;
+}
@@ -0,0 +1,179 @@
+// Measures the syslog reader throughput with a local generator, over UDP and
+// TCP, and the cost per message of the header parser.
+
+#include <logcollector.hpp>
+#include <syslog_parser.hpp>
+#include <syslog_reader.hpp>
+
+#include <boost/asio/co_spawn.hpp>
+#include <boost/asio/detached.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/ip/address.hpp>
+#include <boost/asio/write.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace logcollector;
+
+namespace
+{
+    constexpr size_t MESSAGE_COUNT = 200000;
+    constexpr size_t PARSE_ROUNDS = 10;
+    constexpr auto IDLE_TIMEOUT = std::chrono::seconds(1);
+
+    /// @brief Logcollector that counts the pushed logs instead of queueing them
+    class CountingLogcollector : public Logcollector
+    {
+    public:
+        CountingLogcollector()
+        {
+            SetPushMessageFunction(
+                [this](Message message) // NOLINT(performance-unnecessary-value-param)
+                {
+                    m_received += message.data.is_array() ? message.data.size() : 1;
+                    return 1;
+                });
+        }
+
+        std::atomic<size_t> m_received {0};
+    };
+
+    /// @brief Generates messages from a few hosts, in both header formats
+    std::vector<std::string> GenerateMessages()
+    {
+        std::vector<std::string> messages;
+        messages.reserve(MESSAGE_COUNT);
+
+        for (size_t i = 0; i < MESSAGE_COUNT; ++i)
+        {
+            const auto host = "host" + std::to_string(i % 4);
+            const auto id = std::to_string(i);
+
+            if (i % 2 == 0)
+            {
+                messages.push_back("<38>Oct  9 22:33:20 " + host + " sshd[4321]: Accepted publickey for user" + id +
+                                   " from 10.0.0.1 port 51234 ssh2");
+            }
+            else
+            {
+                messages.push_back("<165>1 2024-10-11T22:14:15.003Z " + host + " evntslog 1234 ID47 [origin ip=\"" +
+                                   id + "\"] An application event");
+            }
+        }
+
+        return messages;
+    }
+
+    /// @brief Runs a reader while a generator sends the messages, and returns the received logs per second
+    template<typename Generator>
+    double MessagesPerSecond(SyslogReader::Protocol protocol, Generator generate, size_t& received)
+    {
+        CountingLogcollector logcollector;
+        boost::asio::io_context ioContext;
+        auto reader = std::make_shared<SyslogReader>(logcollector, protocol, "127.0.0.1", 0);
+        boost::asio::co_spawn(ioContext, reader->Run(), boost::asio::detached);
+        std::thread readerThread([&ioContext]() { ioContext.run(); });
+
+        while (reader->LocalPort() == 0)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+
+        const auto start = std::chrono::steady_clock::now();
+        std::thread generatorThread([&generate, &reader]() { generate(reader->LocalPort()); });
+
+        // Datagrams may be lost, so the reader is done when no more logs arrive
+        auto last = start;
+        size_t count = 0;
+
+        while (count < MESSAGE_COUNT && std::chrono::steady_clock::now() - last < IDLE_TIMEOUT)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+            if (const auto current = logcollector.m_received.load(); current != count)
+            {
+                count = current;
+                last = std::chrono::steady_clock::now();
+            }
+        }
+
+        generatorThread.join();
+        reader->Stop();
+        ioContext.stop();
+        readerThread.join();
+
+        received = count;
+        const auto elapsed = std::chrono::duration<double>(last - start).count();
+        return elapsed > 0 ? static_cast<double>(count) / elapsed : 0;
+    }
+} // namespace
+
+int main()
+{
+    const auto messages = GenerateMessages();
+    const auto address = boost::asio::ip::make_address("127.0.0.1");
+    size_t received = 0;
+
+    const auto udpRate = MessagesPerSecond(
+        SyslogReader::Protocol::UDP,
+        [&messages, &address](unsigned short port)
+        {
+            boost::asio::io_context ioContext;
+            boost::asio::ip::udp::socket socket(ioContext);
+            const boost::asio::ip::udp::endpoint endpoint(address, port);
+            socket.open(endpoint.protocol());
+
+            for (const auto& message : messages)
+            {
+                socket.send_to(boost::asio::buffer(message), endpoint);
+            }
+        },
+        received);
+
+    std::cout << "udp  " << received << "/" << MESSAGE_COUNT << " msgs  " << udpRate << " msgs/s\n";
+
+    const auto tcpRate = MessagesPerSecond(
+        SyslogReader::Protocol::TCP,
+        [&messages, &address](unsigned short port)
+        {
+            boost::asio::io_context ioContext;
+            boost::asio::ip::tcp::socket socket(ioContext);
+            socket.connect({address, port});
+
+            // Half of the messages are octet-counted, the other half are newline-terminated
+            std::string stream;
+
+            for (size_t i = 0; i < messages.size(); ++i)
+            {
+                stream += i % 2 == 0 ? std::to_string(messages[i].size()) + " " + messages[i] : messages[i] + "\n";
+            }
+
+            boost::asio::write(socket, boost::asio::buffer(stream));
+        },
+        received);
+
+    std::cout << "tcp  " << received << "/" << MESSAGE_COUNT << " msgs  " << tcpRate << " msgs/s\n";
+
+    size_t parsed = 0;
+    const auto start = std::chrono::steady_clock::now();
+
+    for (size_t round = 0; round < PARSE_ROUNDS; ++round)
+    {
+        for (const auto& message : messages)
+        {
+            parsed += ParseSyslog(message).hostname.empty() ? 0U : 1U;
+        }
+    }
+
+    const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+    std::cout << "parser  " << static_cast<double>(elapsed.count()) / static_cast<double>(parsed) << " ns/msg\n";
+
+    return 0;
+}
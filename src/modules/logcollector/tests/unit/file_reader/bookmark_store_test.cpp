@@ -0,0 +1,221 @@
+#include <gtest/gtest.h>
+
+#include <bookmark_store.hpp>
+#include <mocks_persistence.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace logcollector;
+using ::testing::_;
+using ::testing::Return;
+
+namespace
+{
+    const FileBookmark BOOKMARK_A {1, 2, 3, "abcd"};
+    const FileBookmark BOOKMARK_B {4, 5, 6, "ef01"};
+} // namespace
+
+class BookmarkStoreTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        auto persistence = std::make_unique<MockPersistence>();
+        m_persistence = persistence.get();
+
+        EXPECT_CALL(*m_persistence, TableExists("file_bookmarks")).WillOnce(Return(false));
+        EXPECT_CALL(*m_persistence, CreateTable("file_bookmarks", _)).Times(1);
+        EXPECT_CALL(*m_persistence, TableExists("journal_cursors")).WillOnce(Return(false));
+        EXPECT_CALL(*m_persistence, CreateTable("journal_cursors", _)).Times(1);
+
+        m_store = std::make_unique<BookmarkStore>("db_path", std::chrono::hours(1), std::move(persistence));
+    }
+
+    MockPersistence* m_persistence = nullptr;
+    std::unique_ptr<BookmarkStore> m_store;
+};
+
+TEST_F(BookmarkStoreTest, GetFromDatabase)
+{
+    const std::vector<column::Row> rows = {{column::ColumnValue("path", column::ColumnType::TEXT, "/tmp/A.log"),
+                                            column::ColumnValue("device", column::ColumnType::INTEGER, "1"),
+                                            column::ColumnValue("inode", column::ColumnType::INTEGER, "2"),
+                                            column::ColumnValue("offset", column::ColumnType::INTEGER, "3"),
+                                            column::ColumnValue("head_hash", column::ColumnType::TEXT, "abcd")}};
+
+    EXPECT_CALL(*m_persistence, Select("file_bookmarks", _, _, _, _, _, _)).WillOnce(Return(rows));
+
+    const auto bookmark = m_store->Get("/tmp/A.log");
+    ASSERT_TRUE(bookmark.has_value());
+    ASSERT_EQ(bookmark->device, 1u);
+    ASSERT_EQ(bookmark->inode, 2u);
+    ASSERT_EQ(bookmark->offset, 3u);
+    ASSERT_EQ(bookmark->headHash, "abcd");
+}
+
+TEST_F(BookmarkStoreTest, GetMissing)
+{
+    EXPECT_CALL(*m_persistence, Select("file_bookmarks", _, _, _, _, _, _))
+        .WillOnce(Return(std::vector<column::Row> {}));
+
+    ASSERT_FALSE(m_store->Get("/tmp/A.log").has_value());
+}
+
+TEST_F(BookmarkStoreTest, GetPendingWithoutDatabase)
+{
+    EXPECT_CALL(*m_persistence, Select(_, _, _, _, _, _, _)).Times(0);
+
+    // Pending bookmarks are written when the store is destroyed
+    EXPECT_CALL(*m_persistence, BeginTransaction()).WillOnce(Return(1));
+    EXPECT_CALL(*m_persistence, Remove("file_bookmarks", _, _)).Times(2);
+    EXPECT_CALL(*m_persistence, Insert("file_bookmarks", _)).Times(1);
+    EXPECT_CALL(*m_persistence, CommitTransaction(1)).Times(1);
+
+    m_store->Set("/tmp/A.log", BOOKMARK_A);
+    m_store->Remove("/tmp/B.log");
+
+    ASSERT_EQ(m_store->Get("/tmp/A.log")->offset, BOOKMARK_A.offset);
+    ASSERT_FALSE(m_store->Get("/tmp/B.log").has_value());
+}
+
+TEST_F(BookmarkStoreTest, FlushWritesOneTransaction)
+{
+    m_store->Set("/tmp/A.log", BOOKMARK_A);
+    m_store->Set("/tmp/A.log", BOOKMARK_B);
+    m_store->Set("/tmp/B.log", BOOKMARK_B);
+    m_store->Remove("/tmp/C.log");
+
+    EXPECT_CALL(*m_persistence, BeginTransaction()).WillOnce(Return(1));
+    EXPECT_CALL(*m_persistence, Remove("file_bookmarks", _, _)).Times(3);
+    EXPECT_CALL(*m_persistence, Insert("file_bookmarks", _)).Times(2);
+    EXPECT_CALL(*m_persistence, CommitTransaction(1)).Times(1);
+
+    ASSERT_TRUE(m_store->Flush());
+
+    // Nothing pending anymore
+    ASSERT_TRUE(m_store->Flush());
+}
+
+TEST_F(BookmarkStoreTest, FlushFailureKeepsPending)
+{
+    m_store->Set("/tmp/A.log", BOOKMARK_A);
+
+    EXPECT_CALL(*m_persistence, BeginTransaction()).WillOnce(Return(1)).WillOnce(Return(2));
+    EXPECT_CALL(*m_persistence, Remove("file_bookmarks", _, _)).Times(2);
+    EXPECT_CALL(*m_persistence, Insert("file_bookmarks", _))
+        .WillOnce(::testing::Throw(std::runtime_error("Error Insert")))
+        .WillOnce(Return());
+    EXPECT_CALL(*m_persistence, RollbackTransaction(1)).Times(1);
+    EXPECT_CALL(*m_persistence, CommitTransaction(2)).Times(1);
+
+    ASSERT_FALSE(m_store->Flush());
+    ASSERT_TRUE(m_store->Flush());
+}
+
+TEST_F(BookmarkStoreTest, FlushIfDueWaitsForInterval)
+{
+    EXPECT_CALL(*m_persistence, BeginTransaction()).Times(0);
+
+    m_store->Set("/tmp/A.log", BOOKMARK_A);
+    m_store->FlushIfDue();
+
+    ::testing::Mock::VerifyAndClearExpectations(m_persistence);
+
+    // Pending bookmarks are written when the store is destroyed
+    EXPECT_CALL(*m_persistence, BeginTransaction()).WillOnce(Return(1));
+    EXPECT_CALL(*m_persistence, Remove("file_bookmarks", _, _)).Times(1);
+    EXPECT_CALL(*m_persistence, Insert("file_bookmarks", _)).Times(1);
+    EXPECT_CALL(*m_persistence, CommitTransaction(1)).Times(1);
+}
+
+TEST_F(BookmarkStoreTest, GetCursorFromDatabase)
+{
+    const std::vector<column::Row> rows = {{column::ColumnValue("reader", column::ColumnType::TEXT, "journald"),
+                                            column::ColumnValue("cursor", column::ColumnType::TEXT, "s=1;i=2")}};
+
+    EXPECT_CALL(*m_persistence, Select("journal_cursors", _, _, _, _, _, _))
+        .WillOnce(Return(rows))
+        .WillOnce(Return(std::vector<column::Row> {}));
+
+    ASSERT_EQ(m_store->GetCursor("journald"), "s=1;i=2");
+    ASSERT_FALSE(m_store->GetCursor("other").has_value());
+}
+
+TEST_F(BookmarkStoreTest, FlushWritesCursors)
+{
+    m_store->SetCursor("journald", "s=1;i=1");
+    m_store->SetCursor("journald", "s=1;i=2");
+    m_store->Set("/tmp/A.log", BOOKMARK_A);
+
+    EXPECT_CALL(*m_persistence, Select(_, _, _, _, _, _, _)).Times(0);
+    ASSERT_EQ(m_store->GetCursor("journald"), "s=1;i=2");
+
+    EXPECT_CALL(*m_persistence, BeginTransaction()).WillOnce(Return(1));
+    EXPECT_CALL(*m_persistence, Remove("file_bookmarks", _, _)).Times(1);
+    EXPECT_CALL(*m_persistence, Insert("file_bookmarks", _)).Times(1);
+    EXPECT_CALL(*m_persistence, Remove("journal_cursors", _, _)).Times(1);
+    EXPECT_CALL(*m_persistence, Insert("journal_cursors", _)).Times(1);
+    EXPECT_CALL(*m_persistence, CommitTransaction(1)).Times(1);
+
+    ASSERT_TRUE(m_store->Flush());
+}
+
+TEST(BookmarkStore, FlushIfDueAfterInterval)
+{
+    auto persistence = std::make_unique<MockPersistence>();
+    auto* mock = persistence.get();
+
+    EXPECT_CALL(*mock, TableExists("file_bookmarks")).WillOnce(Return(true));
+    EXPECT_CALL(*mock, TableExists("journal_cursors")).WillOnce(Return(true));
+    EXPECT_CALL(*mock, BeginTransaction()).WillOnce(Return(1));
+    EXPECT_CALL(*mock, Remove("file_bookmarks", _, _)).Times(1);
+    EXPECT_CALL(*mock, Insert("file_bookmarks", _)).Times(1);
+    EXPECT_CALL(*mock, CommitTransaction(1)).Times(1);
+
+    BookmarkStore store("db_path", std::chrono::milliseconds(0), std::move(persistence));
+    store.Set("/tmp/A.log", BOOKMARK_A);
+    store.FlushIfDue();
+}
+
+TEST(BookmarkStore, CannotCreateTable)
+{
+    auto persistence = std::make_unique<MockPersistence>();
+
+    EXPECT_CALL(*persistence, TableExists("file_bookmarks")).WillOnce(Return(false));
+    EXPECT_CALL(*persistence, CreateTable("file_bookmarks", _))
+        .WillOnce(::testing::Throw(std::runtime_error("Error CreateTable")));
+
+    ASSERT_THROW(BookmarkStore("db_path", std::chrono::hours(1), std::move(persistence)), std::runtime_error);
+}
+
+TEST(BookmarkStore, KeepsLargeDeviceAndInodeNumbers)
+{
+    const auto dbFolder = std::filesystem::temp_directory_path() / "bookmark_store_large";
+    std::filesystem::create_directories(dbFolder);
+    const FileBookmark bookmark {std::numeric_limits<uint64_t>::max(), (uint64_t {1} << 63) + 1, 7, "abcd"};
+
+    {
+        BookmarkStore store(dbFolder.string());
+        store.Set("/tmp/A.log", bookmark);
+    }
+
+    {
+        // The values above the signed 64-bit range are read back exactly from SQLite
+        BookmarkStore store(dbFolder.string());
+        const auto stored = store.Get("/tmp/A.log");
+
+        ASSERT_TRUE(stored.has_value());
+        ASSERT_EQ(stored->device, bookmark.device);
+        ASSERT_EQ(stored->inode, bookmark.inode);
+        ASSERT_EQ(stored->offset, bookmark.offset);
+    }
+
+    std::filesystem::remove_all(dbFolder);
+}
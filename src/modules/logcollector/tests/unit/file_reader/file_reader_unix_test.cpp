@@ -1,11 +1,21 @@
 #include <gtest/gtest.h>
+#include <filesystem>
 #include <list>
 #include <spdlog/spdlog.h>
 #include <sstream>
 
+#include <boost/asio/co_spawn.hpp>
+#include <boost/asio/detached.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <boost/asio/this_coro.hpp>
+#include <boost/asio/use_awaitable.hpp>
+
+#include <config.h>
 #include <file_reader.hpp>
 #include <logcollector.hpp>
 #include <logcollector_mock.hpp>
+#include <mocks_persistence.hpp>
 #include <tempfile.hpp>
 
 using namespace logcollector;
@@ -16,6 +26,21 @@ public:
     MOCK_METHOD(void, Call, (const std::string&), ());
 };
 
+namespace
+{
+    /// @brief Makes the mock wait for real, so that reading loops return to the context
+    void UseTimers(LogcollectorMock& logcollector)
+    {
+        EXPECT_CALL(logcollector, Wait(::testing::_))
+            .WillRepeatedly(::testing::Invoke(
+                [](std::chrono::milliseconds ms) -> boost::asio::awaitable<void>
+                {
+                    boost::asio::steady_timer timer(co_await boost::asio::this_coro::executor, ms);
+                    co_await timer.async_wait(boost::asio::use_awaitable);
+                }));
+    }
+} // namespace
+
 TEST(Localfile, FullLine)
 {
     auto stream = std::make_shared<std::stringstream>();
@@ -40,6 +65,67 @@ TEST(Localfile, PartialLine)
     ASSERT_EQ(answer, "Hello World");
 }
 
+TEST(Localfile, EmptyLinesAndCarriageReturns)
+{
+    auto stream = std::make_shared<std::stringstream>();
+    auto lf = Localfile(stream);
+
+    *stream << "\n\nHello\r\n\r\nWorld\n";
+    ASSERT_EQ(lf.NextLog(), "Hello");
+    ASSERT_EQ(lf.NextLog(), "World");
+    ASSERT_EQ(lf.NextLog(), "");
+    ASSERT_EQ(lf.Offset(), stream->str().size());
+}
+
+TEST(Localfile, LongLine)
+{
+    auto stream = std::make_shared<std::stringstream>();
+    auto lf = Localfile(stream);
+    const auto maxLength = static_cast<size_t>(config::logcollector::BUFFER_SIZE) - 1;
+
+    *stream << std::string(maxLength, 'A') << std::string(maxLength, 'B');
+    ASSERT_EQ(lf.NextLog(), std::string(maxLength, 'A'));
+    ASSERT_EQ(lf.NextLog(), "");
+
+    *stream << "BBB\nHello World\n";
+    ASSERT_EQ(lf.NextLog(), "Hello World");
+    ASSERT_EQ(lf.Offset(), stream->str().size());
+}
+
+TEST(Localfile, LongTerminatedLine)
+{
+    auto stream = std::make_shared<std::stringstream>();
+    auto lf = Localfile(stream);
+    const auto maxLength = static_cast<size_t>(config::logcollector::BUFFER_SIZE) - 1;
+
+    // The newline is already buffered, so the line is truncated without waiting for more data
+    *stream << std::string(2 * maxLength, 'A') << "\nnext\n";
+    ASSERT_EQ(lf.NextLog().length(), maxLength);
+    ASSERT_EQ(lf.NextLog(), "next");
+    ASSERT_EQ(lf.NextLog(), "");
+    ASSERT_EQ(lf.Offset(), stream->str().size());
+}
+
+TEST(Localfile, ManyBlocks)
+{
+    constexpr size_t LINES = 100000;
+    auto stream = std::make_shared<std::stringstream>();
+    auto lf = Localfile(stream);
+
+    for (size_t i = 0; i < LINES; ++i)
+    {
+        *stream << "Line " << i << "\n";
+    }
+
+    for (size_t i = 0; i < LINES; ++i)
+    {
+        ASSERT_EQ(lf.NextLog(), "Line " + std::to_string(i));
+    }
+
+    ASSERT_EQ(lf.NextLog(), "");
+    ASSERT_EQ(lf.Offset(), stream->str().size());
+}
+
 TEST(Localfile, OpenError)
 {
     try
@@ -65,6 +151,28 @@ TEST(Localfile, Rotated)
     ASSERT_TRUE(lf.Rotated());
 }
 
+TEST(Localfile, RotatedByRename)
+{
+    auto fileA = TempFile("/tmp/A.log", "Line 1\n");
+    auto lf = Localfile("/tmp/A.log");
+
+    lf.SeekEnd();
+
+    // The new file is already longer than the reading position
+    auto fileB = TempFile("/tmp/B.log", "Line 3\nLine 4\n");
+    std::filesystem::rename("/tmp/B.log", "/tmp/A.log");
+    ASSERT_TRUE(lf.Rotated());
+
+    // The old file can be read until it is reopened
+    fileA.Write("Line 2\n");
+    ASSERT_EQ(lf.NextLog(), "Line 2");
+    ASSERT_EQ(lf.NextLog(), "");
+
+    lf.Reopen();
+    ASSERT_FALSE(lf.Rotated());
+    ASSERT_EQ(lf.NextLog(), "Line 3");
+}
+
 TEST(Localfile, Deleted)
 {
     auto fileA = std::make_unique<TempFile>("/tmp/A.log", "Hello World");
@@ -83,6 +191,75 @@ TEST(Localfile, Deleted)
     }
 }
 
+TEST(Localfile, ResumeFromBookmark)
+{
+    auto fileA = TempFile("/tmp/A.log", "Line 1\n");
+    FileBookmark bookmark;
+
+    {
+        auto lf = Localfile("/tmp/A.log");
+        ASSERT_EQ(lf.NextLog(), "Line 1");
+        bookmark = lf.Bookmark();
+        ASSERT_EQ(bookmark.offset, 7u);
+    }
+
+    fileA.Write("Line 2\n");
+
+    auto lf = Localfile("/tmp/A.log");
+    ASSERT_TRUE(lf.Resume(bookmark));
+    ASSERT_EQ(lf.Offset(), 7u);
+    ASSERT_EQ(lf.NextLog(), "Line 2");
+}
+
+TEST(Localfile, ResumeTruncatedFile)
+{
+    auto fileA = TempFile("/tmp/A.log", "Line 1\nLine 2\n");
+    auto lf = Localfile("/tmp/A.log");
+
+    lf.SeekEnd();
+    const auto bookmark = lf.Bookmark();
+
+    fileA.Truncate();
+    fileA.Write("Line 3\n");
+
+    auto reopened = Localfile("/tmp/A.log");
+    ASSERT_FALSE(reopened.Resume(bookmark));
+    ASSERT_EQ(reopened.Offset(), 0u);
+    ASSERT_EQ(reopened.NextLog(), "Line 3");
+}
+
+TEST(Localfile, ResumeRewrittenFile)
+{
+    auto fileA = TempFile("/tmp/A.log", "Line 1\n");
+    auto lf = Localfile("/tmp/A.log");
+
+    lf.SeekEnd();
+    const auto bookmark = lf.Bookmark();
+
+    fileA.Truncate();
+    fileA.Write("Line 2\nLine 3\n");
+
+    auto reopened = Localfile("/tmp/A.log");
+    ASSERT_FALSE(reopened.Resume(bookmark));
+    ASSERT_EQ(reopened.NextLog(), "Line 2");
+}
+
+TEST(Localfile, ResumeReplacedFile)
+{
+    auto fileA = std::make_unique<TempFile>("/tmp/A.log", "Line 1\n");
+    auto lf = Localfile("/tmp/A.log");
+
+    lf.SeekEnd();
+    const auto bookmark = lf.Bookmark();
+
+    auto fileB = TempFile("/tmp/B.log", "Line 1\nLine 2\n");
+    std::filesystem::rename("/tmp/B.log", "/tmp/A.log");
+
+    auto reopened = Localfile("/tmp/A.log");
+    ASSERT_FALSE(reopened.Resume(bookmark));
+    ASSERT_EQ(reopened.NextLog(), "Line 1");
+}
+
 TEST(FileReader, Reload)
 {
     spdlog::default_logger()->sinks().clear();
@@ -104,3 +281,354 @@ TEST(FileReader, Reload)
     auto d = TempFile("/tmp/fileD.log");
     reader.Reload([&](Localfile& lf) { mockCallback.Call(lf.Filename()); });
 }
+
+TEST(FileReader, ReloadEntries)
+{
+    MockCallback mockCallback;
+
+    EXPECT_CALL(mockCallback, Call("/tmp/entryA.log")).Times(1);
+    EXPECT_CALL(mockCallback, Call("/tmp/entryB.log")).Times(1);
+
+    auto a = TempFile("/tmp/entryA.log");
+    auto b = TempFile("/tmp/entryB.log");
+    auto other = TempFile("/tmp/entryC.txt");
+    auto hidden = TempFile("/tmp/.entryD.log");
+
+    FileReader reader(Logcollector::Instance(), "/tmp/entry*.log", 500, 60000); // NOLINT
+    const auto callback = [&](Localfile& lf)
+    {
+        mockCallback.Call(lf.Filename());
+    };
+
+    reader.ReloadEntries({"entryA.log", "entryC.txt", ".entryD.log", "entryE.log"}, callback);
+    reader.ReloadEntries({"entryA.log", "entryB.log"}, callback);
+}
+
+TEST(FileReader, ReloadSkipsLinksToReadFiles)
+{
+    MockCallback mockCallback;
+
+    EXPECT_CALL(mockCallback, Call(::testing::_)).Times(1);
+
+    auto target = TempFile("/tmp/alias_target.log");
+    std::filesystem::remove("/tmp/alias_link.log");
+    std::filesystem::create_symlink("/tmp/alias_target.log", "/tmp/alias_link.log");
+
+    FileReader reader(Logcollector::Instance(), "/tmp/alias_*.log", 500, 60000); // NOLINT
+    reader.Reload([&](Localfile& lf) { mockCallback.Call(lf.Filename()); });
+
+    std::filesystem::remove("/tmp/alias_link.log");
+}
+
+TEST(FileReader, ReadsRestOfRotatedFile)
+{
+    auto logcollector = LogcollectorMock();
+    auto persistence = std::make_unique<::testing::NiceMock<MockPersistence>>();
+    auto bookmarks = std::make_shared<BookmarkStore>("db_path", std::chrono::hours(1), std::move(persistence));
+    auto rotated = TempFile("/tmp/A.log.1", "Line 1\n");
+    std::vector<std::string> logs;
+
+    {
+        auto lf = Localfile(rotated.Path());
+        ASSERT_EQ(lf.NextLog(), "Line 1");
+        bookmarks->Set("/tmp/A.log", lf.Bookmark());
+    }
+
+    // The file was written and rotated after the last read
+    rotated.Write("Line 2\n");
+    auto current = TempFile("/tmp/A.log", "Line 3\n");
+
+    logcollector.SetPushMessageFunction(
+        [&logs](Message message) // NOLINT(performance-unnecessary-value-param)
+        {
+            EXPECT_EQ(message.data["log"]["file"]["path"], "/tmp/A.log");
+            logs.push_back(message.data["event"]["original"].get<std::string>());
+            return 1;
+        });
+
+    EXPECT_CALL(logcollector, EnqueueTask(::testing::_)).Times(::testing::AnyNumber());
+
+    auto reader = std::make_shared<FileReader>(logcollector, "/tmp/A.log", 500, 60000, bookmarks); // NOLINT
+    boost::asio::io_context ioContext;
+
+    boost::asio::co_spawn(ioContext, reader->Run(), boost::asio::detached);
+    ioContext.run_for(std::chrono::milliseconds(50));
+    reader->Stop();
+    logcollector.Stop();
+    ioContext.run_for(std::chrono::milliseconds(50));
+
+    ASSERT_EQ(logs, std::vector<std::string> {"Line 2"});
+}
+
+TEST(FileReader, ReopensRotatedFileOnceCreated)
+{
+    auto logcollector = LogcollectorMock();
+    auto persistence = std::make_unique<::testing::NiceMock<MockPersistence>>();
+    auto bookmarks = std::make_shared<BookmarkStore>("db_path", std::chrono::hours(1), std::move(persistence));
+    auto rotated = TempFile("/tmp/reopen.log.1");
+    std::filesystem::remove(rotated.Path());
+    auto file = std::make_unique<TempFile>("/tmp/reopen.log");
+    boost::asio::io_context ioContext;
+    std::vector<std::string> logs;
+
+    logcollector.SetPushMessageFunction(
+        [&logs](Message message) // NOLINT(performance-unnecessary-value-param)
+        {
+            logs.push_back(message.data["event"]["original"].get<std::string>());
+            return 1;
+        });
+
+    EXPECT_CALL(logcollector, EnqueueTask(::testing::_))
+        .WillRepeatedly(::testing::Invoke([&ioContext](Awaitable task)
+                                          { boost::asio::co_spawn(ioContext, std::move(task), boost::asio::detached); }));
+    UseTimers(logcollector);
+
+    // With a long read interval, only the notifications and the reopen retries drive the reader
+    auto reader = std::make_shared<FileReader>(logcollector, file->Path(), 10000, 60000, bookmarks); // NOLINT
+    boost::asio::co_spawn(ioContext, reader->Run(), boost::asio::detached);
+    ioContext.run_for(std::chrono::milliseconds(50));
+
+    // The file is renamed, and the new one is created after the reader noticed it
+    std::filesystem::rename(file->Path(), rotated.Path());
+    ioContext.run_for(std::chrono::milliseconds(20));
+    file.reset();
+    file = std::make_unique<TempFile>("/tmp/reopen.log", "Line 1\n");
+
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+
+    while (logs.empty() && std::chrono::steady_clock::now() < deadline)
+    {
+        ioContext.run_for(std::chrono::milliseconds(10));
+    }
+
+    reader->Stop();
+    logcollector.Stop();
+    ioContext.run_for(std::chrono::milliseconds(50));
+
+    ASSERT_EQ(logs, std::vector<std::string> {"Line 1"});
+}
+
+TEST(FileReader, PollingReopensFileCreatedAfterRename)
+{
+    auto logcollector = LogcollectorMock();
+    auto persistence = std::make_unique<::testing::NiceMock<MockPersistence>>();
+    auto bookmarks = std::make_shared<BookmarkStore>("db_path", std::chrono::hours(1), std::move(persistence));
+    auto rotated = TempFile("/tmp/polled_reopen.log.1");
+    std::filesystem::remove(rotated.Path());
+    auto file = std::make_unique<TempFile>("/tmp/polled_reopen.log");
+    boost::asio::io_context ioContext;
+    std::vector<std::string> logs;
+
+    logcollector.SetPushMessageFunction(
+        [&logs](Message message) // NOLINT(performance-unnecessary-value-param)
+        {
+            logs.push_back(message.data["event"]["original"].get<std::string>());
+            return 1;
+        });
+
+    EXPECT_CALL(logcollector, EnqueueTask(::testing::_))
+        .WillRepeatedly(::testing::Invoke([&ioContext](Awaitable task)
+                                          { boost::asio::co_spawn(ioContext, std::move(task), boost::asio::detached); }));
+    UseTimers(logcollector);
+
+    auto reader = std::make_shared<FileReader>(
+        logcollector, file->Path(), 100, 60000, bookmarks, nullptr, nullptr, false); // NOLINT
+    boost::asio::co_spawn(ioContext, reader->Run(), boost::asio::detached);
+    ioContext.run_for(std::chrono::milliseconds(50));
+
+    // The reader polls while the path is missing, and the new file is created afterwards
+    std::filesystem::rename(file->Path(), rotated.Path());
+    ioContext.run_for(std::chrono::milliseconds(150));
+    file.reset();
+    file = std::make_unique<TempFile>("/tmp/polled_reopen.log", "Line 1\n");
+
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+
+    while (logs.empty() && std::chrono::steady_clock::now() < deadline)
+    {
+        ioContext.run_for(std::chrono::milliseconds(10));
+    }
+
+    reader->Stop();
+    ioContext.run_for(std::chrono::milliseconds(50));
+
+    ASSERT_EQ(logs, std::vector<std::string> {"Line 1"});
+}
+
+TEST(FileReader, ReadsFilesCreatedAfterStartupFromTheBeginning)
+{
+    auto logcollector = LogcollectorMock();
+    auto existing = TempFile("/tmp/late_existing.log", "Old line\n");
+    std::unique_ptr<TempFile> created;
+    boost::asio::io_context ioContext;
+    std::vector<std::string> logs;
+
+    logcollector.SetPushMessageFunction(
+        [&logs](Message message) // NOLINT(performance-unnecessary-value-param)
+        {
+            logs.push_back(message.data["event"]["original"].get<std::string>());
+            return 1;
+        });
+
+    EXPECT_CALL(logcollector, EnqueueTask(::testing::_))
+        .WillRepeatedly(::testing::Invoke([&ioContext](Awaitable task)
+                                          { boost::asio::co_spawn(ioContext, std::move(task), boost::asio::detached); }));
+    UseTimers(logcollector);
+
+    auto reader = std::make_shared<FileReader>(
+        logcollector, "/tmp/late_*.log", 100, 100, nullptr, nullptr, nullptr, false); // NOLINT
+    boost::asio::co_spawn(ioContext, reader->Run(), boost::asio::detached);
+    ioContext.run_for(std::chrono::milliseconds(50));
+
+    // The file is written before the next scan finds it
+    created = std::make_unique<TempFile>("/tmp/late_created.log", "New line\n");
+
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+
+    while (logs.empty() && std::chrono::steady_clock::now() < deadline)
+    {
+        ioContext.run_for(std::chrono::milliseconds(10));
+    }
+
+    reader->Stop();
+    ioContext.run_for(std::chrono::milliseconds(50));
+
+    ASSERT_EQ(logs, std::vector<std::string> {"New line"});
+}
+
+TEST(FileReader, PollsWithoutNotifications)
+{
+    auto logcollector = LogcollectorMock();
+    auto file = TempFile("/tmp/polled.log");
+
+    // Only the file is read, no watcher task is started
+    EXPECT_CALL(logcollector, EnqueueTask(::testing::_)).Times(1);
+    UseTimers(logcollector);
+
+    auto reader = std::make_shared<FileReader>(
+        logcollector, file.Path(), 500, 60000, nullptr, nullptr, nullptr, false); // NOLINT
+    boost::asio::io_context ioContext;
+
+    boost::asio::co_spawn(ioContext, reader->Run(), boost::asio::detached);
+    ioContext.run_for(std::chrono::milliseconds(50));
+    reader->Stop();
+    ioContext.run_for(std::chrono::milliseconds(50));
+}
+
+TEST(FileReader, WaitsForQueueSpace)
+{
+    auto logcollector = LogcollectorMock();
+    auto file = TempFile("/tmp/queue_full.log", "Line 1\nLine 2\n");
+    auto lf = Localfile(file.Path());
+    int attempts = 0;
+    std::vector<std::string> logs;
+
+    // The queue rejects the first pushes, as if it were full
+    logcollector.SetPushMessageFunction(
+        [&attempts, &logs](Message message) // NOLINT(performance-unnecessary-value-param)
+        {
+            if (++attempts <= 3)
+            {
+                return 0;
+            }
+
+            for (const auto& event : message.data)
+            {
+                logs.push_back(event["event"]["original"].get<std::string>());
+            }
+
+            return 1;
+        });
+
+    UseTimers(logcollector);
+    auto reader = std::make_shared<FileReader>(logcollector, file.Path(), 500, 60000); // NOLINT
+    boost::asio::io_context ioContext;
+
+    boost::asio::co_spawn(ioContext, reader->ReadLocalfile(&lf), boost::asio::detached);
+
+    // The retries are spaced by an increasing delay
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+
+    while (logs.empty() && std::chrono::steady_clock::now() < deadline)
+    {
+        ioContext.run_for(std::chrono::milliseconds(10));
+    }
+
+    reader->Stop();
+    ioContext.run_for(std::chrono::milliseconds(50));
+
+    ASSERT_EQ(attempts, 4);
+    ASSERT_EQ(logs, (std::vector<std::string> {"Line 1", "Line 2"}));
+    ASSERT_EQ(logcollector.DroppedLogs(), 0u);
+}
+
+TEST(FileReader, KeepsBookmarkWhileQueueIsFull)
+{
+    auto logcollector = LogcollectorMock();
+    auto persistence = std::make_unique<::testing::NiceMock<MockPersistence>>();
+    auto bookmarks = std::make_shared<BookmarkStore>("db_path", std::chrono::hours(1), std::move(persistence));
+    auto file = TempFile("/tmp/queue_full.log", "Line 1\n");
+    auto lf = Localfile(file.Path());
+
+    logcollector.SetPushMessageFunction([](Message) { return 0; }); // NOLINT(performance-unnecessary-value-param)
+    UseTimers(logcollector);
+
+    auto reader = std::make_shared<FileReader>(logcollector, file.Path(), 500, 60000, bookmarks); // NOLINT
+    boost::asio::io_context ioContext;
+
+    boost::asio::co_spawn(ioContext, reader->ReadLocalfile(&lf), boost::asio::detached);
+    ioContext.run_for(std::chrono::milliseconds(50));
+    reader->Stop();
+    ioContext.run_for(std::chrono::milliseconds(50));
+
+    // The undelivered line is read again on the next run
+    ASSERT_FALSE(bookmarks->Get(file.Path()).has_value());
+}
+
+TEST(FileReader, JoinsMultilineEvents)
+{
+    auto logcollector = LogcollectorMock();
+    auto persistence = std::make_unique<::testing::NiceMock<MockPersistence>>();
+    auto bookmarks = std::make_shared<BookmarkStore>("db_path", std::chrono::hours(1), std::move(persistence));
+    const std::string first = "2024-01-01 Exception\n  at a\n  at b\n";
+    const std::string second = "2024-01-02 Exception\n  at c\n";
+    auto file = TempFile("/tmp/multiline.log", first + second);
+    auto lf = Localfile(file.Path());
+    std::vector<std::string> logs;
+
+    logcollector.SetPushMessageFunction(
+        [&logs](Message message) // NOLINT(performance-unnecessary-value-param)
+        {
+            logs.push_back(message.data["event"]["original"].get<std::string>());
+            return 1;
+        });
+    UseTimers(logcollector);
+
+    auto rule = std::make_shared<MultilineRule>(std::vector<std::string> {"^\\d{4}-"}, std::vector<std::string> {});
+    rule->timeout = std::chrono::milliseconds(100);
+    auto reader =
+        std::make_shared<FileReader>(logcollector, file.Path(), 500, 60000, bookmarks, nullptr, rule); // NOLINT
+    boost::asio::io_context ioContext;
+
+    boost::asio::co_spawn(ioContext, reader->ReadLocalfile(&lf), boost::asio::detached);
+    ioContext.run_for(std::chrono::milliseconds(20));
+
+    // The second event may still continue, so the bookmark stays at its first line
+    ASSERT_EQ(logs, std::vector<std::string> {"2024-01-01 Exception\n  at a\n  at b"});
+    ASSERT_EQ(bookmarks->Get(file.Path())->offset, first.size());
+
+    // It is sent when the timeout expires, without waiting for the read interval
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+
+    while (logs.size() < 2 && std::chrono::steady_clock::now() < deadline)
+    {
+        ioContext.run_for(std::chrono::milliseconds(10));
+    }
+
+    ASSERT_EQ(logs.size(), 2u);
+    ASSERT_EQ(logs[1], "2024-01-02 Exception\n  at c");
+    ASSERT_EQ(bookmarks->Get(file.Path())->offset, first.size() + second.size());
+
+    reader->Stop();
+    ioContext.run_for(std::chrono::milliseconds(50));
+}
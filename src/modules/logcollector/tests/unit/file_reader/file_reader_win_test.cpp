@@ -3,6 +3,7 @@
 #include <spdlog/spdlog.h>
 #include <sstream>
 
+#include <config.h>
 #include <file_reader.hpp>
 #include <logcollector.hpp>
 #include <logcollector_mock.hpp>
@@ -48,6 +49,33 @@ TEST(Localfile, PartialLine)
     ASSERT_EQ(answer, "Hello World");
 }
 
+TEST(Localfile, EmptyLinesAndCarriageReturns)
+{
+    auto stream = std::make_shared<std::stringstream>();
+    auto lf = Localfile(stream);
+
+    *stream << "\n\nHello\r\n\r\nWorld\n";
+    ASSERT_EQ(lf.NextLog(), "Hello");
+    ASSERT_EQ(lf.NextLog(), "World");
+    ASSERT_EQ(lf.NextLog(), "");
+    ASSERT_EQ(lf.Offset(), stream->str().size());
+}
+
+TEST(Localfile, LongLine)
+{
+    auto stream = std::make_shared<std::stringstream>();
+    auto lf = Localfile(stream);
+    const auto maxLength = static_cast<size_t>(config::logcollector::BUFFER_SIZE) - 1;
+
+    *stream << std::string(maxLength, 'A') << std::string(maxLength, 'B');
+    ASSERT_EQ(lf.NextLog(), std::string(maxLength, 'A'));
+    ASSERT_EQ(lf.NextLog(), "");
+
+    *stream << "BBB\nHello World\n";
+    ASSERT_EQ(lf.NextLog(), "Hello World");
+    ASSERT_EQ(lf.Offset(), stream->str().size());
+}
+
 TEST(Localfile, OpenError)
 {
     try
@@ -93,6 +121,43 @@ TEST(Localfile, Deleted)
     }
 }
 
+TEST(Localfile, ResumeFromBookmark)
+{
+    auto fileA = TempFile(GetFullFileName("A.log"), "Line 1\n");
+    FileBookmark bookmark;
+
+    {
+        auto lf = Localfile(GetFullFileName("A.log"));
+        ASSERT_EQ(lf.NextLog(), "Line 1");
+        bookmark = lf.Bookmark();
+    }
+
+    fileA.Write("Line 2\n");
+
+    auto lf = Localfile(GetFullFileName("A.log"));
+    ASSERT_TRUE(lf.Resume(bookmark));
+    ASSERT_EQ(lf.NextLog(), "Line 2");
+}
+
+TEST(Localfile, ResumeTruncatedFile)
+{
+    auto fileA = TempFile(GetFullFileName("A.log"), "Line 1\nLine 2\n");
+    FileBookmark bookmark;
+
+    {
+        auto lf = Localfile(GetFullFileName("A.log"));
+        lf.SeekEnd();
+        bookmark = lf.Bookmark();
+    }
+
+    fileA.Truncate();
+    fileA.Write("Line 3\n");
+
+    auto lf = Localfile(GetFullFileName("A.log"));
+    ASSERT_FALSE(lf.Resume(bookmark));
+    ASSERT_EQ(lf.NextLog(), "Line 3");
+}
+
 TEST(FileReader, Reload)
 {
     spdlog::default_logger()->sinks().clear();
@@ -0,0 +1,348 @@
+#include <gtest/gtest.h>
+
+#include <boost/asio/co_spawn.hpp>
+#include <boost/asio/detached.hpp>
+#include <boost/asio/io_context.hpp>
+
+#include <file_reader.hpp>
+#include <file_watcher.hpp>
+#include <logcollector_mock.hpp>
+#include <tempfile.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <vector>
+
+using namespace logcollector;
+using namespace std::chrono_literals;
+
+namespace
+{
+    constexpr auto LONG_TIMEOUT = std::chrono::milliseconds(60000);
+    constexpr auto TEST_DEADLINE = 5s;
+
+    /// @brief Runs the context until the condition holds or the deadline expires
+    template<typename Condition>
+    void RunUntil(boost::asio::io_context& ioContext, Condition condition)
+    {
+        const auto deadline = std::chrono::steady_clock::now() + TEST_DEADLINE;
+
+        while (!condition() && std::chrono::steady_clock::now() < deadline)
+        {
+            ioContext.run_for(10ms);
+        }
+    }
+
+    /// @brief Spawns a coroutine that waits on the watcher and stores the result
+    void SpawnWait(boost::asio::io_context& ioContext,
+                   std::shared_ptr<IFileWatcher> watcher,
+                   int wd,
+                   std::optional<uint32_t>& result)
+    {
+        boost::asio::co_spawn(
+            ioContext,
+            [watcher, wd, &result]() -> boost::asio::awaitable<void>
+            { result = co_await watcher->Wait(wd, LONG_TIMEOUT); },
+            boost::asio::detached);
+    }
+} // namespace
+
+class FileWatcherTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        m_watcher = CreateFileWatcher(m_ioContext.get_executor());
+
+        if (!m_watcher)
+        {
+            GTEST_SKIP() << "File notifications not supported";
+        }
+
+        boost::asio::co_spawn(m_ioContext, m_watcher->Run(), boost::asio::detached);
+    }
+
+    void TearDown() override
+    {
+        if (m_watcher)
+        {
+            m_watcher->Stop();
+            m_ioContext.run_for(10ms);
+        }
+    }
+
+    boost::asio::io_context m_ioContext;
+    std::shared_ptr<IFileWatcher> m_watcher;
+};
+
+TEST_F(FileWatcherTest, Modified)
+{
+    auto file = TempFile("/tmp/watcher_modified.log");
+    const auto wd = m_watcher->AddFile(file.Path());
+    ASSERT_GE(wd, 0);
+
+    std::optional<uint32_t> result;
+    SpawnWait(m_ioContext, m_watcher, wd, result);
+    m_ioContext.run_for(10ms);
+    ASSERT_FALSE(result.has_value());
+
+    file.Write("Hello World\n");
+    RunUntil(m_ioContext, [&]() { return result.has_value(); });
+
+    ASSERT_TRUE(result.has_value());
+    ASSERT_TRUE(*result & FILE_MODIFIED);
+}
+
+TEST_F(FileWatcherTest, PendingEventsReturnImmediately)
+{
+    auto file = TempFile("/tmp/watcher_pending.log");
+    const auto wd = m_watcher->AddFile(file.Path());
+    ASSERT_GE(wd, 0);
+
+    file.Write("Hello World\n");
+    m_ioContext.run_for(50ms);
+
+    std::optional<uint32_t> result;
+    SpawnWait(m_ioContext, m_watcher, wd, result);
+    RunUntil(m_ioContext, [&]() { return result.has_value(); });
+
+    ASSERT_TRUE(result.has_value());
+    ASSERT_TRUE(*result & FILE_MODIFIED);
+}
+
+TEST_F(FileWatcherTest, Moved)
+{
+    auto file = TempFile("/tmp/watcher_moved.log");
+    const auto wd = m_watcher->AddFile(file.Path());
+    ASSERT_GE(wd, 0);
+
+    std::optional<uint32_t> result;
+    SpawnWait(m_ioContext, m_watcher, wd, result);
+    m_ioContext.run_for(10ms);
+
+    std::filesystem::rename(file.Path(), "/tmp/watcher_moved.log.1");
+    RunUntil(m_ioContext, [&]() { return result.has_value(); });
+    std::filesystem::rename("/tmp/watcher_moved.log.1", file.Path());
+
+    ASSERT_TRUE(result.has_value());
+    ASSERT_TRUE(*result & FILE_MOVED);
+}
+
+TEST_F(FileWatcherTest, DirectoryChanged)
+{
+    const auto directory = std::filesystem::temp_directory_path() / "watcher_directory";
+    std::filesystem::create_directories(directory);
+    const auto wd = m_watcher->AddDirectory(directory.string());
+    ASSERT_GE(wd, 0);
+
+    std::optional<uint32_t> result;
+    SpawnWait(m_ioContext, m_watcher, wd, result);
+    m_ioContext.run_for(10ms);
+
+    {
+        auto file = TempFile((directory / "new.log").string());
+        RunUntil(m_ioContext, [&]() { return result.has_value(); });
+    }
+
+    std::filesystem::remove_all(directory);
+
+    ASSERT_TRUE(result.has_value());
+    ASSERT_TRUE(*result & DIRECTORY_CHANGED);
+}
+
+TEST_F(FileWatcherTest, DirectoryEntries)
+{
+    const auto directory = std::filesystem::temp_directory_path() / "watcher_entries";
+    std::filesystem::create_directories(directory);
+    const auto wd = m_watcher->AddDirectory(directory.string());
+    ASSERT_GE(wd, 0);
+
+    std::optional<uint32_t> result;
+    SpawnWait(m_ioContext, m_watcher, wd, result);
+    m_ioContext.run_for(10ms);
+
+    std::vector<std::string> names;
+
+    {
+        auto file = TempFile((directory / "first.log").string());
+        RunUntil(m_ioContext, [&]() { return result.has_value(); });
+        ASSERT_TRUE(m_watcher->TakeEntries(wd, names));
+    }
+
+    std::filesystem::remove_all(directory);
+
+    ASSERT_EQ(names, std::vector<std::string> {"first.log"});
+    names.clear();
+    ASSERT_FALSE(m_watcher->TakeEntries(-1, names));
+    ASSERT_TRUE(names.empty());
+}
+
+TEST_F(FileWatcherTest, UnwatchedPathFails)
+{
+    ASSERT_EQ(m_watcher->AddFile("/tmp/unexisting_watcher.file"), -1);
+}
+
+TEST_F(FileWatcherTest, StopWakesWaiters)
+{
+    auto file = TempFile("/tmp/watcher_stop.log");
+    const auto wd = m_watcher->AddFile(file.Path());
+
+    std::optional<uint32_t> result;
+    SpawnWait(m_ioContext, m_watcher, wd, result);
+    m_ioContext.run_for(10ms);
+
+    m_watcher->Stop();
+    RunUntil(m_ioContext, [&]() { return result.has_value(); });
+
+    ASSERT_TRUE(result.has_value());
+    ASSERT_EQ(*result, 0u);
+}
+
+TEST(FileReader, ReadsOnNotification)
+{
+    auto logcollector = LogcollectorMock();
+    auto file = TempFile("/tmp/notified.log", "Old line\n");
+    auto reader = std::make_shared<FileReader>(logcollector, file.Path(), LONG_TIMEOUT.count(), LONG_TIMEOUT.count());
+    boost::asio::io_context ioContext;
+
+    if (!CreateFileWatcher(ioContext.get_executor()))
+    {
+        GTEST_SKIP() << "File notifications not supported";
+    }
+
+    std::vector<std::string> logs;
+
+    logcollector.SetPushMessageFunction(
+        [&logs](Message message) // NOLINT(performance-unnecessary-value-param)
+        {
+            const auto events = message.data.is_array() ? message.data : nlohmann::json::array({message.data});
+
+            for (const auto& event : events)
+            {
+                logs.push_back(event["event"]["original"].get<std::string>());
+            }
+
+            return 1;
+        });
+
+    EXPECT_CALL(logcollector, EnqueueTask(::testing::_))
+        .WillRepeatedly(::testing::Invoke(
+            [&ioContext](Awaitable task)
+            { boost::asio::co_spawn(ioContext, std::move(task), boost::asio::detached); }));
+
+    boost::asio::co_spawn(ioContext, reader->Run(), boost::asio::detached);
+    ioContext.run_for(50ms);
+
+    file.Write("New line\n");
+    RunUntil(ioContext, [&]() { return !logs.empty(); });
+
+    reader->Stop();
+    logcollector.Stop();
+    ioContext.run_for(50ms);
+
+    ASSERT_EQ(logs, std::vector<std::string> {"New line"});
+}
+
+TEST(FileReader, ReadsCreatedFileOnNotification)
+{
+    auto logcollector = LogcollectorMock();
+    const auto directory = std::filesystem::temp_directory_path() / "reader_created";
+    std::filesystem::create_directories(directory);
+    auto reader = std::make_shared<FileReader>(
+        logcollector, (directory / "*.log").string(), LONG_TIMEOUT.count(), LONG_TIMEOUT.count());
+    boost::asio::io_context ioContext;
+
+    if (!CreateFileWatcher(ioContext.get_executor()))
+    {
+        GTEST_SKIP() << "File notifications not supported";
+    }
+
+    std::vector<std::string> logs;
+    size_t tasks = 0;
+
+    logcollector.SetPushMessageFunction(
+        [&logs](Message message) // NOLINT(performance-unnecessary-value-param)
+        {
+            const auto events = message.data.is_array() ? message.data : nlohmann::json::array({message.data});
+
+            for (const auto& event : events)
+            {
+                logs.push_back(event["event"]["original"].get<std::string>());
+            }
+
+            return 1;
+        });
+
+    EXPECT_CALL(logcollector, EnqueueTask(::testing::_))
+        .WillRepeatedly(::testing::Invoke(
+            [&ioContext, &tasks](Awaitable task)
+            {
+                ++tasks;
+                boost::asio::co_spawn(ioContext, std::move(task), boost::asio::detached);
+            }));
+
+    boost::asio::co_spawn(ioContext, reader->Run(), boost::asio::detached);
+    ioContext.run_for(50ms);
+    ASSERT_EQ(tasks, 1u);
+
+    {
+        // The directory is not scanned again before the reload interval, so only the notification adds the file
+        auto ignored = TempFile((directory / "new.txt").string());
+        auto file = TempFile((directory / "new.log").string());
+        RunUntil(ioContext, [&]() { return tasks == 2; });
+
+        file.Write("First line\n");
+        RunUntil(ioContext, [&]() { return !logs.empty(); });
+    }
+
+    reader->Stop();
+    logcollector.Stop();
+    ioContext.run_for(50ms);
+    std::filesystem::remove_all(directory);
+
+    ASSERT_EQ(tasks, 2u);
+    ASSERT_EQ(logs, std::vector<std::string> {"First line"});
+}
+
+TEST(FileReader, SharesFileWatcher)
+{
+    auto logcollector = LogcollectorMock();
+    auto first = TempFile("/tmp/shared_watcher_1.log");
+    auto second = TempFile("/tmp/shared_watcher_2.log");
+    auto firstReader =
+        std::make_shared<FileReader>(logcollector, first.Path(), LONG_TIMEOUT.count(), LONG_TIMEOUT.count());
+    auto secondReader =
+        std::make_shared<FileReader>(logcollector, second.Path(), LONG_TIMEOUT.count(), LONG_TIMEOUT.count());
+    boost::asio::io_context ioContext;
+
+    if (!CreateFileWatcher(ioContext.get_executor()))
+    {
+        GTEST_SKIP() << "File notifications not supported";
+    }
+
+    size_t tasks = 0;
+
+    EXPECT_CALL(logcollector, EnqueueTask(::testing::_))
+        .WillRepeatedly(::testing::Invoke(
+            [&ioContext, &tasks](Awaitable task)
+            {
+                ++tasks;
+                boost::asio::co_spawn(ioContext, std::move(task), boost::asio::detached);
+            }));
+
+    boost::asio::co_spawn(ioContext, firstReader->Run(), boost::asio::detached);
+    boost::asio::co_spawn(ioContext, secondReader->Run(), boost::asio::detached);
+    ioContext.run_for(50ms);
+
+    // A single watcher task serves both files
+    ASSERT_EQ(tasks, 3u);
+    ASSERT_EQ(logcollector.FileWatcher(ioContext.get_executor()), logcollector.FileWatcher(ioContext.get_executor()));
+
+    firstReader->Stop();
+    secondReader->Stop();
+    logcollector.Stop();
+    ioContext.run_for(50ms);
+}
@@ -0,0 +1,107 @@
+#include <gtest/gtest.h>
+
+#include <line_filter.hpp>
+
+#include <regex>
+#include <string>
+#include <vector>
+
+using namespace logcollector;
+
+TEST(MultiPatternMatcher, RequiredLiteral)
+{
+    ASSERT_EQ(MultiPatternMatcher::RequiredLiteral("sshd"), "sshd");
+    ASSERT_EQ(MultiPatternMatcher::RequiredLiteral("Failed password for \\w+"), "Failed password for ");
+    ASSERT_EQ(MultiPatternMatcher::RequiredLiteral("^error: .* at line \\d+$"), " at line ");
+    ASSERT_EQ(MultiPatternMatcher::RequiredLiteral("colou?r"), "colo");
+    ASSERT_EQ(MultiPatternMatcher::RequiredLiteral("ab+c"), "ab");
+    ASSERT_EQ(MultiPatternMatcher::RequiredLiteral("(warn|error)ing: disk"), "ing: disk");
+    ASSERT_EQ(MultiPatternMatcher::RequiredLiteral("[a-z]+\\.log"), ".log");
+    ASSERT_EQ(MultiPatternMatcher::RequiredLiteral("warn|error"), "");
+    ASSERT_EQ(MultiPatternMatcher::RequiredLiteral("\\d{3}"), "");
+}
+
+TEST(MultiPatternMatcher, RequiredLiteralSkipsCharacterCodes)
+{
+    ASSERT_EQ(MultiPatternMatcher::RequiredLiteral("\\x1b\\[31m"), "[31m");
+    ASSERT_EQ(MultiPatternMatcher::RequiredLiteral("caf\\u00e9 open"), " open");
+    ASSERT_EQ(MultiPatternMatcher::RequiredLiteral("\\cMend"), "end");
+    ASSERT_EQ(MultiPatternMatcher::RequiredLiteral("(ab)x\\1yz"), "yz");
+}
+
+TEST(MultiPatternMatcher, CharacterCodesAndBackReferences)
+{
+    const MultiPatternMatcher matcher({"\\x1b\\[31m", "\\u0041BC", "(\\w+)=\\1;"});
+
+    ASSERT_TRUE(matcher.Matches("\x1b[31mred"));
+    ASSERT_FALSE(matcher.Matches("[31m"));
+    ASSERT_TRUE(matcher.Matches("ABC"));
+    ASSERT_FALSE(matcher.Matches("0041BC"));
+    ASSERT_TRUE(matcher.Matches("key=key;"));
+    ASSERT_FALSE(matcher.Matches("key=value;"));
+}
+
+TEST(MultiPatternMatcher, Empty)
+{
+    const MultiPatternMatcher matcher({});
+
+    ASSERT_TRUE(matcher.Empty());
+    ASSERT_FALSE(matcher.Matches("anything"));
+}
+
+TEST(MultiPatternMatcher, Literals)
+{
+    const MultiPatternMatcher matcher({"he", "she", "hers", "his"});
+
+    ASSERT_TRUE(matcher.Matches("ushers"));
+    ASSERT_TRUE(matcher.Matches("this"));
+    ASSERT_TRUE(matcher.Matches("she"));
+    ASSERT_FALSE(matcher.Matches("hi you"));
+    ASSERT_FALSE(matcher.Matches(""));
+}
+
+TEST(MultiPatternMatcher, RegexConfirmation)
+{
+    const MultiPatternMatcher matcher({"port \\d+", "user=[a-z]+;"});
+
+    // The literal is found, but the expression does not match
+    ASSERT_FALSE(matcher.Matches("port unknown"));
+    ASSERT_FALSE(matcher.Matches("user=ROOT;"));
+
+    // The first occurrence of the literal does not match, but a later one does
+    ASSERT_TRUE(matcher.Matches("port x, port 22"));
+    ASSERT_TRUE(matcher.Matches("login user=admin;"));
+}
+
+TEST(MultiPatternMatcher, PatternsWithoutLiteral)
+{
+    const MultiPatternMatcher matcher({"^\\d{4}-", "kernel"});
+
+    ASSERT_TRUE(matcher.Matches("2024-01-01 boot"));
+    ASSERT_TRUE(matcher.Matches("Jan 1 kernel: boot"));
+    ASSERT_FALSE(matcher.Matches("Jan 1 systemd: boot"));
+}
+
+TEST(MultiPatternMatcher, InvalidPattern)
+{
+    ASSERT_THROW(MultiPatternMatcher({"valid", "(unclosed"}), std::regex_error);
+}
+
+TEST(LineFilter, IncludeAndExclude)
+{
+    const LineFilter filter({"sshd", "sudo"}, {"Accepted publickey", "pam_unix\\(sudo:session\\)"});
+
+    ASSERT_TRUE(filter.Accepts("sshd[42]: Failed password for root"));
+    ASSERT_TRUE(filter.Accepts("sudo: admin : TTY=pts/0 ; COMMAND=/bin/ls"));
+    ASSERT_FALSE(filter.Accepts("sshd[42]: Accepted publickey for admin"));
+    ASSERT_FALSE(filter.Accepts("sudo: pam_unix(sudo:session): session opened"));
+    ASSERT_FALSE(filter.Accepts("cron[7]: job started"));
+}
+
+TEST(LineFilter, ExcludeOnly)
+{
+    const LineFilter filter({}, {"DEBUG"});
+
+    ASSERT_TRUE(filter.Accepts("INFO started"));
+    ASSERT_FALSE(filter.Accepts("DEBUG connection pool size=10"));
+}
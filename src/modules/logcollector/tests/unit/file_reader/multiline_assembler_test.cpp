@@ -0,0 +1,120 @@
+#include <gtest/gtest.h>
+
+#include <multiline_assembler.hpp>
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace logcollector;
+
+namespace
+{
+    /// @brief Adds lines to an assembler and returns the completed events, the pending one included
+    std::vector<std::string> Assemble(MultilineAssembler& assembler, const std::vector<std::string_view>& lines)
+    {
+        std::vector<std::string> events;
+        uint64_t offset = 0;
+
+        for (const auto line : lines)
+        {
+            if (const auto event = assembler.Add(line, offset); !event.empty())
+            {
+                events.emplace_back(event);
+            }
+
+            offset += line.size() + 1;
+        }
+
+        if (const auto event = assembler.Flush(); !event.empty())
+        {
+            events.emplace_back(event);
+        }
+
+        return events;
+    }
+} // namespace
+
+TEST(MultilineAssembler, StartPattern)
+{
+    auto rule = std::make_shared<MultilineRule>(std::vector<std::string> {R"(^\d{4}-\d{2}-\d{2} )"},
+                                                std::vector<std::string> {});
+    MultilineAssembler assembler(rule);
+
+    const auto events = Assemble(assembler,
+                                 {"2024-01-01 ERROR java.lang.NullPointerException",
+                                  "    at com.example.Main.run(Main.java:10)",
+                                  "    at com.example.Main.main(Main.java:5)",
+                                  "2024-01-01 INFO recovered"});
+
+    ASSERT_EQ(events,
+              (std::vector<std::string> {"2024-01-01 ERROR java.lang.NullPointerException\n"
+                                         "    at com.example.Main.run(Main.java:10)\n"
+                                         "    at com.example.Main.main(Main.java:5)",
+                                         "2024-01-01 INFO recovered"}));
+}
+
+TEST(MultilineAssembler, ContinuationPattern)
+{
+    auto rule = std::make_shared<MultilineRule>(std::vector<std::string> {},
+                                                std::vector<std::string> {R"(^\s)", R"(^Caused by:)"});
+    MultilineAssembler assembler(rule);
+
+    const auto events = Assemble(assembler, {"first", "  at a", "Caused by: b", "second", "third", "\tat c"});
+
+    ASSERT_EQ(events, (std::vector<std::string> {"first\n  at a\nCaused by: b", "second", "third\n\tat c"}));
+}
+
+TEST(MultilineAssembler, StartAndContinuationPatterns)
+{
+    // Lines that match neither pattern are events on their own
+    auto rule = std::make_shared<MultilineRule>(std::vector<std::string> {"^\\{"}, std::vector<std::string> {"^ "});
+    MultilineAssembler assembler(rule);
+
+    const auto events = Assemble(assembler, {"{", " \"a\": 1", "}", "{", " \"b\": 2"});
+
+    ASSERT_EQ(events, (std::vector<std::string> {"{\n \"a\": 1", "}", "{\n \"b\": 2"}));
+}
+
+TEST(MultilineAssembler, Limits)
+{
+    auto rule = std::make_shared<MultilineRule>(std::vector<std::string> {"^start"}, std::vector<std::string> {});
+    rule->maxLines = 3;
+    rule->maxBytes = 16;
+    MultilineAssembler assembler(rule);
+
+    // Events are split when they reach the maximum number of lines
+    auto events = Assemble(assembler, {"start", "a", "b", "c", "d"});
+    ASSERT_EQ(events, (std::vector<std::string> {"start\na\nb", "c\nd"}));
+
+    // Events are split before they exceed the maximum size, and longer lines are truncated
+    events = Assemble(assembler, {"start", "0123456789", "0123456789abcdefghij"});
+    ASSERT_EQ(events, (std::vector<std::string> {"start\n0123456789", "0123456789abcdef"}));
+}
+
+TEST(MultilineAssembler, PendingEvent)
+{
+    auto rule = std::make_shared<MultilineRule>(std::vector<std::string> {"^start"}, std::vector<std::string> {});
+    rule->timeout = std::chrono::milliseconds(0);
+    MultilineAssembler assembler(rule);
+
+    ASSERT_FALSE(assembler.Pending());
+    ASSERT_TRUE(assembler.Flush().empty());
+
+    ASSERT_TRUE(assembler.Add("start 1", 0).empty());
+    ASSERT_EQ(assembler.Add("start 2", 8), "start 1");
+    ASSERT_TRUE(assembler.Add("more", 16).empty());
+
+    // Bookmarks stay at the first line of the pending event
+    ASSERT_TRUE(assembler.Pending());
+    ASSERT_EQ(assembler.PendingOffset(), 8u);
+    ASSERT_EQ(assembler.TimeLeft().count(), 0);
+
+    rule->timeout = std::chrono::hours(1);
+    ASSERT_GT(assembler.TimeLeft().count(), 0);
+
+    ASSERT_EQ(assembler.Flush(), "start 2\nmore");
+    ASSERT_FALSE(assembler.Pending());
+}
@@ -69,6 +69,35 @@ TEST_F(JournalLogTests, FilterMatching)
     }
 }
 
+TEST_F(JournalLogTests, CompiledFilterMatching)
+{
+    const CompiledJournalFilter exact(JournalFilter {"UNIT", "service1|service2", true});
+    const CompiledJournalFilter substring(JournalFilter {"UNIT", "sys|jour", false});
+
+    EXPECT_EQ(exact.values, (std::vector<std::string> {"service1", "service2"}));
+    EXPECT_FALSE(exact.in_journal_matches);
+    EXPECT_TRUE(exact.Matches("service2"));
+    EXPECT_FALSE(exact.Matches("service3"));
+    EXPECT_TRUE(substring.Matches("system"));
+    EXPECT_FALSE(substring.Matches("kernel"));
+}
+
+TEST_F(JournalLogTests, SubstringFiltersAreNotJournalMatches)
+{
+    const FilterGroup group {{"MESSAGE", "error", false}, {"_SYSTEMD_UNIT", "ssh.service|sshd.service", true}};
+
+    EXPECT_NO_THROW(journal->AddFilterGroup(group, false));
+    EXPECT_NO_THROW(journal->AddFilterGroup({{"SYSLOG_IDENTIFIER", "sudo", true}}, false));
+    EXPECT_NO_THROW(journal->SeekHead());
+    EXPECT_NO_THROW(journal->GetNextFilteredMessage(false));
+}
+
+TEST_F(JournalLogTests, FileDescriptor)
+{
+    EXPECT_GE(journal->GetFileDescriptor(), 0);
+    EXPECT_NO_THROW(journal->ProcessChanges());
+}
+
 TEST_F(JournalLogTests, BasicJournalOperations)
 {
     auto group = CreateBasicFilterGroup();
@@ -101,8 +130,7 @@ TEST_F(JournalLogTests, MessageProcessing)
     auto group = CreateBasicFilterGroup();
     journal->AddFilterGroup(group, true);
 
-    const FilterSet filters {group};
-    auto message = journal->GetNextFilteredMessage(filters, true);
+    auto message = journal->GetNextFilteredMessage(true);
 
     if (message)
     {
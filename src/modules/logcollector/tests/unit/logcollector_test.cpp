@@ -3,7 +3,11 @@
 #include <configuration_parser.hpp>
 #include <file_reader.hpp>
 #include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
 #include <regex>
+#include <thread>
 
 using namespace configuration;
 using namespace logcollector;
@@ -53,6 +57,133 @@ TEST(Logcollector, SetupFileReader)
     ASSERT_NE(capturedReader2, nullptr);
 }
 
+TEST(Logcollector, SetupFileReaderWithFilters)
+{
+    auto constexpr CONFIG_RAW = R"(
+    logcollector:
+      localfiles:
+        - /var/log/syslog
+        - path: /var/log/auth.log
+          include:
+            - sshd
+          exclude:
+            - Accepted publickey
+        - path: /var/log/kern.log
+          exclude:
+            - "(unclosed"
+        - include:
+            - missing path
+    )";
+
+    auto logcollector = LogcollectorMock();
+    auto config = std::make_shared<configuration::ConfigurationParser>(std::string(CONFIG_RAW));
+
+    // Entries with invalid patterns are read unfiltered, entries without a path are ignored
+    EXPECT_CALL(logcollector, AddReader(::testing::_)).Times(3);
+
+    logcollector.SetupFileReader(config);
+}
+
+TEST(Logcollector, SetupFileReaderWithMultiline)
+{
+    auto constexpr CONFIG_RAW = R"(
+    logcollector:
+      localfiles:
+        - path: /var/log/app.log
+          multiline:
+            start: '^\d{4}-\d{2}-\d{2}'
+            max_lines: 100
+            max_bytes: 32KB
+            timeout: 500ms
+        - path: /var/log/trace.log
+          multiline:
+            continuation:
+              - '^\s'
+              - '^Caused by:'
+        - path: /var/log/invalid.log
+          multiline:
+            max_lines: 10
+    )";
+
+    auto logcollector = LogcollectorMock();
+    auto config = std::make_shared<configuration::ConfigurationParser>(std::string(CONFIG_RAW));
+
+    // Entries with invalid multiline settings are read line by line
+    EXPECT_CALL(logcollector, AddReader(::testing::_)).Times(3);
+
+    logcollector.SetupFileReader(config);
+}
+
+TEST(Logcollector, SetupSyslogReader)
+{
+    auto constexpr CONFIG_RAW = R"(
+    logcollector:
+      syslog:
+        - protocol: udp
+        - protocol: tcp
+          address: 127.0.0.1
+          port: 1514
+        - protocol: sctp
+        - port: 70000
+        - not a map
+    )";
+
+    auto logcollector = LogcollectorMock();
+    auto config = std::make_shared<configuration::ConfigurationParser>(std::string(CONFIG_RAW));
+
+    // Entries with an unknown protocol or an invalid port are ignored
+    EXPECT_CALL(logcollector, AddReader(::testing::_)).Times(2);
+
+    logcollector.SetupSyslogReader(config);
+}
+
+TEST(Logcollector, StartRunsTasksOnThreadPool)
+{
+    auto constexpr CONFIG_RAW = R"(
+    agent:
+      path.data: /tmp
+    logcollector:
+      thread_count: 2
+      localfiles: []
+    )";
+
+    auto logcollector = LogcollectorMock();
+    auto config = std::make_shared<configuration::ConfigurationParser>(std::string(CONFIG_RAW));
+    std::atomic<int> started = 0;
+    std::atomic<int> concurrent = 0;
+
+    // Each task waits for the other one, which only succeeds if both run at the same time
+    // NOLINTNEXTLINE(cppcoreguidelines-avoid-capturing-lambda-coroutines)
+    auto task = [&]() -> Awaitable
+    {
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+        ++started;
+
+        while (started < 2 && std::chrono::steady_clock::now() < deadline)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+
+        if (started == 2)
+        {
+            ++concurrent;
+        }
+
+        co_return;
+    };
+
+    EXPECT_CALL(logcollector, EnqueueTask(::testing::_))
+        .WillRepeatedly(::testing::Invoke([&logcollector](Awaitable queued)
+                                          { logcollector.Logcollector::EnqueueTask(std::move(queued)); }));
+
+    logcollector.Setup(config);
+    logcollector.EnqueueTask(task());
+    logcollector.EnqueueTask(task());
+    logcollector.Start();
+
+    ASSERT_EQ(concurrent, 2);
+}
+
 TEST(Logcollector, SendMessageFile)
 {
     PushMessageMock mock;
@@ -103,6 +234,65 @@ TEST(Logcollector, SendMessageApp)
     ASSERT_EQ(capturedMessage.metaData, METADATA);
 }
 
+TEST(Logcollector, SendMessagesBatch)
+{
+    PushMessageMock mock;
+    LogcollectorMock logcollector;
+
+    logcollector.SetPushMessageFunction([&mock](Message message) { return mock.Call(std::move(message)); });
+
+    Message capturedMessage(MessageType::STATELESS, nlohmann::json::object(), "", "", "");
+
+    EXPECT_CALL(mock, Call(::testing::_))
+        .WillOnce(::testing::DoAll(::testing::SaveArg<0>(&capturedMessage), ::testing::Return(0)));
+
+    const auto LOCATION = "/test/location";
+    const std::vector<std::string> LOGS = {"first log", "second log", "third log"};
+    const auto METADATA = R"({"collector":"file","module":"logcollector"})";
+
+    logcollector.SendMessages(LOCATION, LOGS, "file");
+
+    ASSERT_EQ(capturedMessage.type, MessageType::STATELESS);
+    ASSERT_EQ(capturedMessage.metaData, METADATA);
+    ASSERT_TRUE(capturedMessage.data.is_array());
+    ASSERT_EQ(capturedMessage.data.size(), LOGS.size());
+
+    for (size_t i = 0; i < LOGS.size(); ++i)
+    {
+        ASSERT_EQ(capturedMessage.data[i]["log"]["file"]["path"], LOCATION);
+        ASSERT_EQ(capturedMessage.data[i]["event"]["original"], LOGS[i]);
+        ASSERT_TRUE(IsISO8601(capturedMessage.data[i]["event"]["created"]));
+    }
+}
+
+TEST(Logcollector, SendMessagesEmpty)
+{
+    PushMessageMock mock;
+    LogcollectorMock logcollector;
+
+    logcollector.SetPushMessageFunction([&mock](Message message) { return mock.Call(std::move(message)); });
+
+    EXPECT_CALL(mock, Call(::testing::_)).Times(0);
+
+    logcollector.SendMessages("/test/location", {}, "file");
+}
+
+TEST(Logcollector, SendMessagesCountsDrops)
+{
+    PushMessageMock mock;
+    LogcollectorMock logcollector;
+
+    logcollector.SetPushMessageFunction([&mock](Message message) { return mock.Call(std::move(message)); });
+
+    EXPECT_CALL(mock, Call(::testing::_)).WillOnce(::testing::Return(0)).WillOnce(::testing::Return(1));
+
+    logcollector.SendMessages("/test/location", {"first log", "second log"}, "file");
+    ASSERT_EQ(logcollector.DroppedLogs(), 2u);
+
+    logcollector.SendMessages("/test/location", {"third log"}, "file");
+    ASSERT_EQ(logcollector.DroppedLogs(), 2u);
+}
+
 int main(int argc, char** argv)
 {
     ::testing::InitGoogleTest(&argc, argv);
@@ -0,0 +1,149 @@
+#include <gtest/gtest.h>
+
+#include <syslog_parser.hpp>
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace logcollector;
+
+TEST(SyslogParser, Rfc5424)
+{
+    const auto message = ParseSyslog("<165>1 2003-10-11T22:14:15.003Z mymachine.example.com evntslog 1234 ID47 "
+                                     "[exampleSDID@32473 iut=\"3\" eventSource=\"Application\"] "
+                                     "An application event\n");
+
+    EXPECT_EQ(message.priority, 165);
+    EXPECT_EQ(message.Facility(), 20);
+    EXPECT_EQ(message.Severity(), 5);
+    EXPECT_EQ(message.version, 1);
+    EXPECT_EQ(message.timestamp, "2003-10-11T22:14:15.003Z");
+    EXPECT_EQ(message.hostname, "mymachine.example.com");
+    EXPECT_EQ(message.appName, "evntslog");
+    EXPECT_EQ(message.procId, "1234");
+    EXPECT_EQ(message.msgId, "ID47");
+    EXPECT_EQ(message.structuredData, "[exampleSDID@32473 iut=\"3\" eventSource=\"Application\"]");
+    EXPECT_EQ(message.message, "An application event");
+}
+
+TEST(SyslogParser, Rfc5424NilValues)
+{
+    const auto message = ParseSyslog("<34>1 - - su - - - \xEF\xBB\xBF'su root' failed on /dev/pts/8");
+
+    EXPECT_EQ(message.priority, 34);
+    EXPECT_TRUE(message.timestamp.empty());
+    EXPECT_TRUE(message.hostname.empty());
+    EXPECT_EQ(message.appName, "su");
+    EXPECT_TRUE(message.procId.empty());
+    EXPECT_TRUE(message.msgId.empty());
+    EXPECT_TRUE(message.structuredData.empty());
+    EXPECT_EQ(message.message, "'su root' failed on /dev/pts/8");
+}
+
+TEST(SyslogParser, Rfc5424EscapedStructuredData)
+{
+    const auto message = ParseSyslog(R"(<14>1 - host app - - [id a="x\"]y"][id2 b="z"] text)");
+
+    EXPECT_EQ(message.structuredData, R"([id a="x\"]y"][id2 b="z"])");
+    EXPECT_EQ(message.message, "text");
+}
+
+TEST(SyslogParser, Rfc3164)
+{
+    const auto message = ParseSyslog("<38>Oct  9 22:33:20 webserver sshd[4321]: Accepted publickey for deploy\r\n");
+
+    EXPECT_EQ(message.priority, 38);
+    EXPECT_EQ(message.version, 0);
+    EXPECT_EQ(message.timestamp, "Oct  9 22:33:20");
+    EXPECT_EQ(message.hostname, "webserver");
+    EXPECT_EQ(message.appName, "sshd");
+    EXPECT_EQ(message.procId, "4321");
+    EXPECT_EQ(message.message, "Accepted publickey for deploy");
+}
+
+TEST(SyslogParser, Rfc3164WithoutHostname)
+{
+    const auto message = ParseSyslog("<13>Oct  9 22:33:20 CRON[12]: (root) CMD (true)");
+
+    EXPECT_TRUE(message.hostname.empty());
+    EXPECT_EQ(message.appName, "CRON");
+    EXPECT_EQ(message.procId, "12");
+    EXPECT_EQ(message.message, "(root) CMD (true)");
+}
+
+TEST(SyslogParser, Rfc3164WithoutHeader)
+{
+    const auto message = ParseSyslog("<13>just some text: here");
+
+    EXPECT_EQ(message.priority, 13);
+    EXPECT_TRUE(message.timestamp.empty());
+    EXPECT_TRUE(message.appName.empty());
+    EXPECT_EQ(message.message, "just some text: here");
+}
+
+TEST(SyslogParser, InvalidPriority)
+{
+    for (const std::string_view data : {"no priority", "<192>too high", "<abc>text", "<13"})
+    {
+        const auto message = ParseSyslog(data);
+
+        EXPECT_EQ(message.priority, -1) << data;
+        EXPECT_EQ(message.message, data);
+    }
+}
+
+TEST(SyslogFraming, NewlineFraming)
+{
+    std::vector<std::string_view> frames;
+    const std::string data = "first\r\n\nsecond\npartial";
+
+    const auto consumed = SplitSyslogFrames(data, frames, 1024);
+
+    ASSERT_TRUE(consumed.has_value());
+    EXPECT_EQ(*consumed, data.find("partial"));
+    EXPECT_EQ(frames, (std::vector<std::string_view> {"first", "second"}));
+}
+
+TEST(SyslogFraming, OctetCounting)
+{
+    std::vector<std::string_view> frames;
+    const std::string data = "11 <13>a\nb c d5 hello3 ab";
+
+    const auto consumed = SplitSyslogFrames(data, frames, 1024);
+
+    // The last frame is incomplete, it is kept for the next read
+    ASSERT_TRUE(consumed.has_value());
+    EXPECT_EQ(*consumed, data.size() - 4);
+    EXPECT_EQ(frames, (std::vector<std::string_view> {"<13>a\nb c d", "hello"}));
+}
+
+TEST(SyslogFraming, MixedFraming)
+{
+    std::vector<std::string_view> frames;
+    const std::string data = "5 first1st is not a count\n6 second";
+
+    const auto consumed = SplitSyslogFrames(data, frames, 1024);
+
+    ASSERT_TRUE(consumed.has_value());
+    EXPECT_EQ(*consumed, data.size());
+    EXPECT_EQ(frames, (std::vector<std::string_view> {"first", "1st is not a count", "second"}));
+}
+
+TEST(SyslogFraming, LongMessages)
+{
+    std::vector<std::string_view> frames;
+
+    // Lines without a newline are split at the maximum size
+    const std::string line(10, 'x');
+    auto consumed = SplitSyslogFrames(line, frames, 4);
+
+    ASSERT_TRUE(consumed.has_value());
+    EXPECT_EQ(*consumed, 8U);
+    EXPECT_EQ(frames, (std::vector<std::string_view> {"xxxx", "xxxx"}));
+
+    // Octet counts larger than the maximum size are an error
+    frames.clear();
+    consumed = SplitSyslogFrames("5000 data", frames, 4096);
+    EXPECT_FALSE(consumed.has_value());
+}
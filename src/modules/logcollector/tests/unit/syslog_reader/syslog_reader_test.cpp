@@ -0,0 +1,166 @@
+#include <gtest/gtest.h>
+
+#include <boost/asio/co_spawn.hpp>
+#include <boost/asio/detached.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/ip/address.hpp>
+#include <boost/asio/write.hpp>
+
+#include <logcollector_mock.hpp>
+#include <syslog_reader.hpp>
+
+#include <chrono>
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
+using namespace logcollector;
+
+namespace
+{
+    /// @brief Collects the logs pushed by the readers, by provider
+    void CaptureLogs(LogcollectorMock& logcollector, std::map<std::string, std::vector<std::string>>& logs)
+    {
+        logcollector.SetPushMessageFunction(
+            [&logs](Message message) // NOLINT(performance-unnecessary-value-param)
+            {
+                const auto add = [&logs](const nlohmann::json& event)
+                {
+                    logs[event["event"]["provider"].get<std::string>()].push_back(
+                        event["event"]["original"].get<std::string>());
+                };
+
+                if (message.data.is_array())
+                {
+                    for (const auto& event : message.data)
+                    {
+                        add(event);
+                    }
+                }
+                else
+                {
+                    add(message.data);
+                }
+
+                return 1;
+            });
+    }
+
+    /// @brief Runs the context until a condition is met, or a few seconds pass
+    bool RunUntil(boost::asio::io_context& ioContext, const std::function<bool()>& condition)
+    {
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+
+        while (!condition() && std::chrono::steady_clock::now() < deadline)
+        {
+            ioContext.run_for(std::chrono::milliseconds(10));
+        }
+
+        return condition();
+    }
+
+    size_t CountLogs(const std::map<std::string, std::vector<std::string>>& logs)
+    {
+        size_t count = 0;
+
+        for (const auto& [provider, messages] : logs)
+        {
+            count += messages.size();
+        }
+
+        return count;
+    }
+} // namespace
+
+TEST(SyslogReader, ReceivesDatagrams)
+{
+    auto logcollector = LogcollectorMock();
+    std::map<std::string, std::vector<std::string>> logs;
+    CaptureLogs(logcollector, logs);
+
+    boost::asio::io_context ioContext;
+    auto reader = std::make_shared<SyslogReader>(logcollector, SyslogReader::Protocol::UDP, "127.0.0.1", 0);
+    boost::asio::co_spawn(ioContext, reader->Run(), boost::asio::detached);
+    ASSERT_TRUE(RunUntil(ioContext, [&reader]() { return reader->LocalPort() != 0; }));
+
+    boost::asio::ip::udp::socket sender(ioContext);
+    const boost::asio::ip::udp::endpoint endpoint(boost::asio::ip::make_address("127.0.0.1"), reader->LocalPort());
+    sender.open(endpoint.protocol());
+
+    for (const std::string message : {"<13>Oct  9 22:33:20 web1 app: one\n",
+                                      "<13>1 2024-01-01T00:00:00Z web2 app - - - two",
+                                      "<13>Oct  9 22:33:20 web1 app: three",
+                                      "no header"})
+    {
+        sender.send_to(boost::asio::buffer(message), endpoint);
+    }
+
+    ASSERT_TRUE(RunUntil(ioContext, [&logs]() { return CountLogs(logs) == 4; }));
+
+    // Messages are grouped by their host, or the sender address if they have none
+    EXPECT_EQ(logs["web1"],
+              (std::vector<std::string> {"<13>Oct  9 22:33:20 web1 app: one", "<13>Oct  9 22:33:20 web1 app: three"}));
+    EXPECT_EQ(logs["web2"], std::vector<std::string> {"<13>1 2024-01-01T00:00:00Z web2 app - - - two"});
+    EXPECT_EQ(logs["127.0.0.1"], std::vector<std::string> {"no header"});
+
+    reader->Stop();
+    ioContext.run_for(std::chrono::milliseconds(100));
+}
+
+TEST(SyslogReader, ReceivesStreams)
+{
+    auto logcollector = LogcollectorMock();
+    std::map<std::string, std::vector<std::string>> logs;
+    CaptureLogs(logcollector, logs);
+
+    boost::asio::io_context ioContext;
+    auto reader = std::make_shared<SyslogReader>(logcollector, SyslogReader::Protocol::TCP, "127.0.0.1", 0);
+    boost::asio::co_spawn(ioContext, reader->Run(), boost::asio::detached);
+    ASSERT_TRUE(RunUntil(ioContext, [&reader]() { return reader->LocalPort() != 0; }));
+
+    boost::asio::ip::tcp::socket sender(ioContext);
+    sender.connect({boost::asio::ip::make_address("127.0.0.1"), reader->LocalPort()});
+
+    // Octet-counted and newline-terminated messages, the last one closed by the end of the stream
+    const std::string counted = "<13>1 - host app - - - multi\nline";
+    const std::string stream = std::to_string(counted.size()) + " " + counted + "<13>Oct  9 22:33:20 host app: two\n" +
+                               "<13>Oct  9 22:33:20 host app: three";
+
+    boost::asio::write(sender, boost::asio::buffer(stream));
+    sender.shutdown(boost::asio::ip::tcp::socket::shutdown_send);
+
+    ASSERT_TRUE(RunUntil(ioContext, [&logs]() { return CountLogs(logs) == 3; }));
+    EXPECT_EQ(logs["host"],
+              (std::vector<std::string> {
+                  counted, "<13>Oct  9 22:33:20 host app: two", "<13>Oct  9 22:33:20 host app: three"}));
+
+    reader->Stop();
+    ioContext.run_for(std::chrono::milliseconds(100));
+}
+
+TEST(SyslogReader, StopClosesConnections)
+{
+    auto logcollector = LogcollectorMock();
+    std::map<std::string, std::vector<std::string>> logs;
+    CaptureLogs(logcollector, logs);
+
+    boost::asio::io_context ioContext;
+    auto reader = std::make_shared<SyslogReader>(logcollector, SyslogReader::Protocol::TCP, "127.0.0.1", 0);
+    boost::asio::co_spawn(ioContext, reader->Run(), boost::asio::detached);
+    ASSERT_TRUE(RunUntil(ioContext, [&reader]() { return reader->LocalPort() != 0; }));
+
+    boost::asio::ip::tcp::socket sender(ioContext);
+    sender.connect({boost::asio::ip::make_address("127.0.0.1"), reader->LocalPort()});
+    boost::asio::write(sender, boost::asio::buffer(std::string("<13>host app: one\n")));
+    ASSERT_TRUE(RunUntil(ioContext, [&logs]() { return CountLogs(logs) == 1; }));
+
+    reader->Stop();
+
+    // The reader closes its side of the connection
+    ioContext.run_for(std::chrono::milliseconds(100));
+    boost::system::error_code ec;
+    char byte = 0;
+    sender.read_some(boost::asio::buffer(&byte, 1), ec);
+    EXPECT_EQ(ec, boost::asio::error::eof);
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+class IMultiTypeQueue;
+
+namespace load_harness
+{
+    /// @brief Settings for the synthetic event producers
+    struct LoadGeneratorOptions
+    {
+        /// @brief Number of producer threads
+        size_t producers {4};
+
+        /// @brief Events per second per producer, 0 means as fast as the queue accepts them
+        size_t rate {0};
+
+        /// @brief Size in bytes of the synthetic event payload
+        size_t eventSize {256};
+
+        /// @brief Fraction [0, 1] of events pushed as stateful
+        double statefulRatio {0.0};
+    };
+
+    /// @brief Pushes synthetic events into the agent queue from several threads
+    ///
+    /// Every event carries the steady clock time at which it was enqueued, so that the mock
+    /// manager can compute the enqueue-to-ack latency when it acknowledges the batch.
+    class LoadGenerator
+    {
+    public:
+        /// @brief Constructor
+        /// @param queue Queue the events are pushed to
+        /// @param options Producer settings
+        LoadGenerator(std::shared_ptr<IMultiTypeQueue> queue, LoadGeneratorOptions options);
+
+        /// @brief Destructor, stops the producers if running
+        ~LoadGenerator();
+
+        LoadGenerator(const LoadGenerator&) = delete;
+        LoadGenerator& operator=(const LoadGenerator&) = delete;
+
+        /// @brief Starts the producer threads
+        void Start();
+
+        /// @brief Stops and joins the producer threads
+        void Stop();
+
+        /// @brief Number of events accepted by the queue
+        uint64_t Produced() const;
+
+        /// @brief Number of push attempts rejected because the queue was full
+        uint64_t Rejected() const;
+
+    private:
+        /// @brief Producer thread body
+        /// @param producerId Index of the producer
+        void Produce(size_t producerId);
+
+        std::shared_ptr<IMultiTypeQueue> m_queue;
+        LoadGeneratorOptions m_options;
+        std::vector<std::thread> m_threads;
+        std::atomic<bool> m_running {false};
+        std::atomic<uint64_t> m_produced {0};
+        std::atomic<uint64_t> m_rejected {0};
+    };
+} // namespace load_harness
@@ -0,0 +1,122 @@
+#pragma once
+
+#include <boost/asio/awaitable.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/asio/ssl/context.hpp>
+#include <boost/beast/http.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace load_harness
+{
+    /// @brief Behaviour knobs for the mock manager
+    struct MockManagerOptions
+    {
+        /// @brief Fixed latency added to every events and commands response
+        std::chrono::milliseconds latency {0};
+
+        /// @brief Upper bound of a uniformly distributed latency added on top of the fixed one
+        std::chrono::milliseconds latencyJitter {0};
+
+        /// @brief Probability [0, 1] of answering an events request with an error
+        double errorRate {0.0};
+
+        /// @brief HTTP status used for injected errors
+        unsigned int errorStatus {503};
+
+        /// @brief Time a commands request is held before answering 408
+        std::chrono::milliseconds commandsHold {1000};
+    };
+
+    /// @brief Counters collected by the mock manager
+    struct MockManagerStats
+    {
+        uint64_t authenticationRequests {0};
+        uint64_t statelessRequests {0};
+        uint64_t statefulRequests {0};
+        uint64_t commandsRequests {0};
+        uint64_t injectedErrors {0};
+        uint64_t ackedEvents {0};
+        uint64_t receivedBytes {0};
+
+        /// @brief Enqueue-to-ack latency of every acknowledged harness event, in microseconds
+        std::vector<uint64_t> latenciesUs;
+
+        /// @brief CPU time consumed by the mock manager thread
+        std::chrono::microseconds cpuTime {0};
+    };
+
+    /// @brief Local HTTPS server implementing the manager endpoints used by the agent communicator
+    ///
+    /// The server runs on its own thread so that its CPU usage can be measured and subtracted
+    /// from the figures reported for the agent pipeline.
+    class MockManager
+    {
+    public:
+        /// @brief Constructor
+        /// @param options Latency and error injection settings
+        explicit MockManager(MockManagerOptions options);
+
+        /// @brief Destructor, stops the server if running
+        ~MockManager();
+
+        MockManager(const MockManager&) = delete;
+        MockManager& operator=(const MockManager&) = delete;
+
+        /// @brief Binds to an ephemeral loopback port and starts serving
+        /// @return The port the server is listening on
+        unsigned short Start();
+
+        /// @brief Stops the server and joins its thread
+        void Stop();
+
+        /// @brief Number of harness events acknowledged so far
+        uint64_t AckedEvents() const;
+
+        /// @brief Returns the collected statistics. Only complete after Stop()
+        MockManagerStats Stats() const;
+
+    private:
+        using Request = boost::beast::http::request<boost::beast::http::string_body>;
+        using Response = boost::beast::http::response<boost::beast::http::string_body>;
+
+        /// @brief Accepts connections until the server is stopped
+        boost::asio::awaitable<void> Listener();
+
+        /// @brief Serves HTTP requests over a TLS connection
+        boost::asio::awaitable<void> Session(boost::asio::ip::tcp::socket socket);
+
+        /// @brief Dispatches a request to its endpoint handler
+        boost::asio::awaitable<Response> HandleRequest(const Request& request);
+
+        /// @brief Parses an events batch and records the latency of every harness event
+        void RecordEvents(const std::string& body);
+
+        /// @brief Waits for the configured latency plus jitter
+        boost::asio::awaitable<void> Delay(std::chrono::milliseconds fixed, std::chrono::milliseconds jitter);
+
+        /// @brief Decides whether the current request gets an injected error
+        bool InjectError();
+
+        /// @brief Builds a signed JWT accepted by the communicator
+        static std::string MakeToken();
+
+        MockManagerOptions m_options;
+        boost::asio::io_context m_ioContext;
+        boost::asio::ssl::context m_sslContext;
+        boost::asio::ip::tcp::acceptor m_acceptor;
+        std::thread m_thread;
+        std::atomic<bool> m_running {false};
+        std::mt19937_64 m_random;
+
+        std::atomic<uint64_t> m_ackedEvents {0};
+        MockManagerStats m_stats;
+    };
+} // namespace load_harness
@@ -0,0 +1,111 @@
+#include <load_generator.hpp>
+
+#include <imultitype_queue.hpp>
+#include <message.hpp>
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <string>
+
+namespace
+{
+    const std::string MODULE_NAME = "load_harness";
+    const std::string MODULE_TYPE = "synthetic";
+    const std::string METADATA = R"({"module":"load_harness","collector":"synthetic"})";
+    constexpr auto FULL_QUEUE_BACKOFF = std::chrono::milliseconds(1);
+} // namespace
+
+namespace load_harness
+{
+    LoadGenerator::LoadGenerator(std::shared_ptr<IMultiTypeQueue> queue, LoadGeneratorOptions options)
+        : m_queue(std::move(queue))
+        , m_options(options)
+    {
+    }
+
+    LoadGenerator::~LoadGenerator()
+    {
+        Stop();
+    }
+
+    void LoadGenerator::Start()
+    {
+        m_running.store(true);
+
+        for (size_t i = 0; i < m_options.producers; ++i)
+        {
+            m_threads.emplace_back([this, i]() { Produce(i); });
+        }
+    }
+
+    void LoadGenerator::Stop()
+    {
+        m_running.store(false);
+
+        for (auto& thread : m_threads)
+        {
+            if (thread.joinable())
+            {
+                thread.join();
+            }
+        }
+
+        m_threads.clear();
+    }
+
+    uint64_t LoadGenerator::Produced() const
+    {
+        return m_produced.load();
+    }
+
+    uint64_t LoadGenerator::Rejected() const
+    {
+        return m_rejected.load();
+    }
+
+    void LoadGenerator::Produce(size_t producerId)
+    {
+        const std::string payload(m_options.eventSize, 'x');
+        const auto period = m_options.rate > 0 ? std::chrono::nanoseconds(std::chrono::seconds(1)) /
+                                                     static_cast<std::chrono::nanoseconds::rep>(m_options.rate)
+                                               : std::chrono::nanoseconds(0);
+        const auto statefulEvery =
+            m_options.statefulRatio > 0.0 ? static_cast<uint64_t>(1.0 / std::min(m_options.statefulRatio, 1.0)) : 0;
+
+        auto deadline = std::chrono::steady_clock::now();
+        uint64_t sequence = 0;
+
+        while (m_running.load())
+        {
+            const auto type = statefulEvery != 0 && sequence % statefulEvery == 0 ? MessageType::STATEFUL
+                                                                                  : MessageType::STATELESS;
+            const auto sentNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                    std::chrono::steady_clock::now().time_since_epoch())
+                                    .count();
+
+            nlohmann::json data;
+            data["event"]["original"] = payload;
+            data["load_harness"]["producer"] = producerId;
+            data["load_harness"]["seq"] = sequence;
+            data["load_harness"]["sent_ns"] = sentNs;
+
+            if (m_queue->push(Message(type, std::move(data), MODULE_NAME, MODULE_TYPE, METADATA)) == 0)
+            {
+                m_rejected.fetch_add(1);
+                std::this_thread::sleep_for(FULL_QUEUE_BACKOFF);
+                continue;
+            }
+
+            m_produced.fetch_add(1);
+            ++sequence;
+
+            if (period.count() > 0)
+            {
+                deadline += period;
+                std::this_thread::sleep_until(deadline);
+            }
+        }
+    }
+} // namespace load_harness
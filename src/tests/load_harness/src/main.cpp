@@ -0,0 +1,315 @@
+#include <load_generator.hpp>
+#include <mock_manager.hpp>
+
+#include <communicator.hpp>
+#include <configuration_parser.hpp>
+#include <http_client.hpp>
+#include <logger.hpp>
+#include <message.hpp>
+#include <message_queue_utils.hpp>
+#include <multitype_queue.hpp>
+#include <task_manager.hpp>
+
+#include <boost/program_options.hpp>
+#include <nlohmann/json.hpp>
+#include <openssl/ssl.h>
+#include <sys/resource.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace program_options = boost::program_options;
+
+namespace
+{
+    const std::string AGENT_UUID = "00000000-0000-4000-8000-000000000000";
+    const std::string AGENT_KEY = "load-harness-key-0123456789abcdef";
+    const std::string AGENT_METADATA = R"({"agent":{"id":")" + AGENT_UUID + R"(","name":"load-harness"}})";
+    constexpr auto PROGRESS_INTERVAL = std::chrono::seconds(1);
+
+    /// @brief Resource usage of the whole process
+    struct ProcessUsage
+    {
+        std::chrono::microseconds cpuTime {0};
+        long rssKb {0};
+        long peakRssKb {0};
+    };
+
+    /// @brief Reads a "Vm*:" entry in kB from /proc/self/status
+    long ReadStatusKb(const std::string& key)
+    {
+        std::ifstream status("/proc/self/status");
+        std::string line;
+
+        while (std::getline(status, line))
+        {
+            if (line.starts_with(key))
+            {
+                return std::stol(line.substr(key.size()));
+            }
+        }
+
+        return 0;
+    }
+
+    ProcessUsage GetProcessUsage()
+    {
+        rusage usage {};
+        getrusage(RUSAGE_SELF, &usage);
+
+        const auto toMicroseconds = [](const timeval& tv)
+        {
+            return std::chrono::seconds(tv.tv_sec) + std::chrono::microseconds(tv.tv_usec);
+        };
+
+        return {toMicroseconds(usage.ru_utime) + toMicroseconds(usage.ru_stime),
+                ReadStatusKb("VmRSS:"),
+                ReadStatusKb("VmHWM:")};
+    }
+
+    uint64_t Percentile(const std::vector<uint64_t>& sorted, double percentile)
+    {
+        if (sorted.empty())
+        {
+            return 0;
+        }
+
+        const auto index = static_cast<size_t>(percentile * static_cast<double>(sorted.size() - 1));
+        return sorted[index];
+    }
+
+    std::string BuildConfiguration(unsigned short port,
+                                   const std::filesystem::path& dataPath,
+                                   const std::string& batchSize,
+                                   const std::string& queueSize,
+                                   const std::string& retryInterval)
+    {
+        return "agent:\n"
+               "  server_url: https://localhost:" +
+               std::to_string(port) +
+               "\n"
+               "  path.data: " +
+               dataPath.string() +
+               "\n"
+               "  retry_interval: " +
+               retryInterval +
+               "\n"
+               "  queue_size: " +
+               queueSize +
+               "\n"
+               "  verification_mode: none\n"
+               "events:\n"
+               "  batch_size: " +
+               batchSize + "\n";
+    }
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    const Logger logger;
+
+    SSL_library_init();
+    SSL_load_error_strings();
+    OpenSSL_add_all_algorithms();
+
+    load_harness::MockManagerOptions managerOptions;
+    load_harness::LoadGeneratorOptions generatorOptions;
+
+    size_t durationSeconds = 0;
+    size_t drainTimeoutSeconds = 0;
+    size_t threads = 0;
+    long long latencyMs = 0;
+    long long jitterMs = 0;
+    std::string batchSize;
+    std::string queueSize;
+    std::string retryInterval;
+    std::string logLevel;
+
+    program_options::options_description desc("Wazuh agent ingest load harness");
+    // clang-format off
+    desc.add_options()
+        ("help,h", "Show this help")
+        ("duration", program_options::value<size_t>(&durationSeconds)->default_value(30), "Seconds the producers run")
+        ("drain-timeout", program_options::value<size_t>(&drainTimeoutSeconds)->default_value(30), "Seconds to wait for the queue to drain")
+        ("producers", program_options::value<size_t>(&generatorOptions.producers)->default_value(4), "Producer threads")
+        ("rate", program_options::value<size_t>(&generatorOptions.rate)->default_value(0), "Events/s per producer (0: unbounded)")
+        ("event-size", program_options::value<size_t>(&generatorOptions.eventSize)->default_value(256), "Payload size in bytes")
+        ("stateful-ratio", program_options::value<double>(&generatorOptions.statefulRatio)->default_value(0.0), "Fraction of stateful events")
+        ("threads", program_options::value<size_t>(&threads)->default_value(4), "Agent task manager threads")
+        ("batch-size", program_options::value<std::string>(&batchSize)->default_value("1MB"), "events.batch_size")
+        ("queue-size", program_options::value<std::string>(&queueSize)->default_value("10000"), "agent.queue_size")
+        ("retry-interval", program_options::value<std::string>(&retryInterval)->default_value("1s"), "agent.retry_interval")
+        ("latency", program_options::value<long long>(&latencyMs)->default_value(0), "Mock manager latency (ms)")
+        ("jitter", program_options::value<long long>(&jitterMs)->default_value(0), "Mock manager latency jitter (ms)")
+        ("error-rate", program_options::value<double>(&managerOptions.errorRate)->default_value(0.0), "Fraction of events requests answered with an error")
+        ("error-status", program_options::value<unsigned int>(&managerOptions.errorStatus)->default_value(503), "HTTP status of injected errors")
+        ("log-level", program_options::value<std::string>(&logLevel)->default_value("warning"), "Agent log level")
+        ("json", "Print the report as JSON");
+    // clang-format on
+
+    program_options::variables_map validOptions;
+
+    try
+    {
+        program_options::store(program_options::parse_command_line(argc, argv, desc), validOptions);
+        program_options::notify(validOptions);
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << e.what() << "\n" << desc << "\n";
+        return 1;
+    }
+
+    if (validOptions.count("help"))
+    {
+        std::cout << desc << "\n";
+        return 0;
+    }
+
+    spdlog::set_level(spdlog::level::from_str(logLevel));
+
+    managerOptions.latency = std::chrono::milliseconds(latencyMs);
+    managerOptions.latencyJitter = std::chrono::milliseconds(jitterMs);
+
+    const auto dataPath = std::filesystem::temp_directory_path() / ("wazuh-load-harness-" + std::to_string(getpid()));
+    std::filesystem::create_directories(dataPath);
+
+    load_harness::MockManager manager(managerOptions);
+    const auto port = manager.Start();
+
+    auto configurationParser = std::make_shared<configuration::ConfigurationParser>(
+        BuildConfiguration(port, dataPath, batchSize, queueSize, retryInterval));
+
+    auto messageQueue = std::make_shared<MultiTypeQueue>(configurationParser);
+
+    communicator::Communicator communicator(std::make_unique<http_client::HttpClient>(),
+                                            configurationParser,
+                                            AGENT_UUID,
+                                            AGENT_KEY,
+                                            []() { return std::string("WazuhXDR/5.0.0 (load-harness)"); });
+
+    TaskManager taskManager;
+    taskManager.Start(threads);
+
+    if (!communicator.SendAuthenticationRequest())
+    {
+        std::cerr << "Cannot authenticate against the mock manager\n";
+        return 1;
+    }
+
+    taskManager.EnqueueTask(communicator.WaitForTokenExpirationAndAuthenticate(), "Authenticate");
+    taskManager.EnqueueTask(communicator.GetCommandsFromManager([](const int, const std::string&) {}),
+                            "FetchCommands");
+
+    for (const auto type : {MessageType::STATEFUL, MessageType::STATELESS})
+    {
+        auto getMessages = [messageQueue, type](const size_t numMessages)
+        {
+            return GetMessagesFromQueue(messageQueue, type, numMessages, []() { return AGENT_METADATA; });
+        };
+        auto onSuccess = [messageQueue, type](const int messageCount, const std::string&)
+        {
+            PopMessagesFromQueue(messageQueue, type, messageCount);
+        };
+
+        if (type == MessageType::STATEFUL)
+        {
+            taskManager.EnqueueTask(communicator.StatefulMessageProcessingTask(getMessages, onSuccess), "Stateful");
+        }
+        else
+        {
+            taskManager.EnqueueTask(communicator.StatelessMessageProcessingTask(getMessages, onSuccess), "Stateless");
+        }
+    }
+
+    const auto usageBefore = GetProcessUsage();
+    const auto start = std::chrono::steady_clock::now();
+
+    load_harness::LoadGenerator generator(messageQueue, generatorOptions);
+    generator.Start();
+
+    const auto producersDeadline = start + std::chrono::seconds(durationSeconds);
+
+    while (std::chrono::steady_clock::now() < producersDeadline)
+    {
+        std::this_thread::sleep_for(std::min<std::chrono::steady_clock::duration>(
+            PROGRESS_INTERVAL, producersDeadline - std::chrono::steady_clock::now()));
+
+        if (!validOptions.count("json"))
+        {
+            std::cerr << "produced=" << generator.Produced() << " acked=" << manager.AckedEvents()
+                      << " rejected=" << generator.Rejected() << "\n";
+        }
+    }
+
+    generator.Stop();
+
+    const auto drainDeadline = std::chrono::steady_clock::now() + std::chrono::seconds(drainTimeoutSeconds);
+
+    while (manager.AckedEvents() < generator.Produced() && std::chrono::steady_clock::now() < drainDeadline)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+
+    const auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    const auto usageAfter = GetProcessUsage();
+
+    communicator.Stop();
+    taskManager.Stop();
+    manager.Stop();
+
+    auto stats = manager.Stats();
+    std::sort(stats.latenciesUs.begin(), stats.latenciesUs.end());
+
+    const auto agentCpu = usageAfter.cpuTime - usageBefore.cpuTime - stats.cpuTime;
+
+    nlohmann::json report;
+    report["produced"] = generator.Produced();
+    report["rejected"] = generator.Rejected();
+    report["acked"] = stats.ackedEvents;
+    report["elapsed_s"] = elapsed;
+    report["events_per_second"] = static_cast<double>(stats.ackedEvents) / elapsed;
+    report["latency_us"]["p50"] = Percentile(stats.latenciesUs, 0.50);
+    report["latency_us"]["p99"] = Percentile(stats.latenciesUs, 0.99);
+    report["latency_us"]["max"] = stats.latenciesUs.empty() ? 0 : stats.latenciesUs.back();
+    report["cpu"]["agent_s"] = std::chrono::duration<double>(agentCpu).count();
+    report["cpu"]["agent_percent"] = 100.0 * std::chrono::duration<double>(agentCpu).count() / elapsed;
+    report["cpu"]["mock_manager_s"] = std::chrono::duration<double>(stats.cpuTime).count();
+    report["rss_kb"]["current"] = usageAfter.rssKb;
+    report["rss_kb"]["peak"] = usageAfter.peakRssKb;
+    report["requests"]["authentication"] = stats.authenticationRequests;
+    report["requests"]["stateless"] = stats.statelessRequests;
+    report["requests"]["stateful"] = stats.statefulRequests;
+    report["requests"]["commands"] = stats.commandsRequests;
+    report["requests"]["injected_errors"] = stats.injectedErrors;
+    report["received_bytes"] = stats.receivedBytes;
+
+    if (validOptions.count("json"))
+    {
+        std::cout << report.dump(2) << "\n";
+    }
+    else
+    {
+        std::cout << "events/s:        " << report["events_per_second"].get<double>() << "\n"
+                  << "acked/produced:  " << stats.ackedEvents << "/" << generator.Produced() << " (rejected "
+                  << generator.Rejected() << ")\n"
+                  << "latency p50/p99: " << report["latency_us"]["p50"] << "/" << report["latency_us"]["p99"]
+                  << " us\n"
+                  << "agent cpu:       " << report["cpu"]["agent_percent"].get<double>() << " % of one core\n"
+                  << "rss:             " << usageAfter.rssKb << " kB (peak " << usageAfter.peakRssKb << " kB)\n"
+                  << "requests:        " << report["requests"].dump() << "\n";
+    }
+
+    std::error_code ec;
+    std::filesystem::remove_all(dataPath, ec);
+
+    return stats.ackedEvents < generator.Produced() ? 2 : 0;
+}
@@ -0,0 +1,370 @@
+#include <mock_manager.hpp>
+
+#include <boost/asio/co_spawn.hpp>
+#include <boost/asio/detached.hpp>
+#include <boost/asio/redirect_error.hpp>
+#include <boost/asio/ssl.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <boost/asio/use_awaitable.hpp>
+#include <boost/beast/core.hpp>
+#include <boost/beast/ssl.hpp>
+#include <nlohmann/json.hpp>
+#include <openssl/evp.h>
+#include <openssl/hmac.h>
+#include <openssl/x509.h>
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <ctime>
+#include <memory>
+#include <stdexcept>
+#include <string_view>
+
+namespace http = boost::beast::http;
+
+namespace
+{
+    constexpr auto TOKEN_SECRET = "load-harness-secret";
+    constexpr auto TOKEN_LIFETIME = std::chrono::hours(1);
+    constexpr auto SENT_FIELD = std::string_view {"\"sent_ns\":"};
+    constexpr long CERTIFICATE_LIFETIME_SECONDS = 24L * 60 * 60;
+    constexpr uint64_t MAX_BODY_SIZE = 128ULL * 1024 * 1024;
+
+    /// @brief Encodes a buffer using the URL-safe, unpadded base64 alphabet used by JWT
+    std::string Base64UrlEncode(const unsigned char* data, size_t size)
+    {
+        std::string encoded(4 * ((size + 2) / 3), '\0');
+        const auto length =
+            EVP_EncodeBlock(reinterpret_cast<unsigned char*>(encoded.data()), data, static_cast<int>(size));
+        encoded.resize(static_cast<size_t>(length));
+
+        while (!encoded.empty() && encoded.back() == '=')
+        {
+            encoded.pop_back();
+        }
+
+        for (auto& c : encoded)
+        {
+            if (c == '+')
+            {
+                c = '-';
+            }
+            else if (c == '/')
+            {
+                c = '_';
+            }
+        }
+
+        return encoded;
+    }
+
+    std::string Base64UrlEncode(const std::string& data)
+    {
+        return Base64UrlEncode(reinterpret_cast<const unsigned char*>(data.data()), data.size());
+    }
+
+    /// @brief Installs a freshly generated self-signed certificate for localhost in the context
+    void UseSelfSignedCertificate(boost::asio::ssl::context& context)
+    {
+        const std::unique_ptr<EVP_PKEY, decltype(&EVP_PKEY_free)> key(EVP_EC_gen("prime256v1"), EVP_PKEY_free);
+        const std::unique_ptr<X509, decltype(&X509_free)> cert(X509_new(), X509_free);
+
+        if (!key || !cert)
+        {
+            throw std::runtime_error("Cannot allocate the mock manager certificate");
+        }
+
+        ASN1_INTEGER_set(X509_get_serialNumber(cert.get()), 1);
+        X509_gmtime_adj(X509_getm_notBefore(cert.get()), 0);
+        X509_gmtime_adj(X509_getm_notAfter(cert.get()), CERTIFICATE_LIFETIME_SECONDS);
+        X509_set_pubkey(cert.get(), key.get());
+
+        auto* name = X509_get_subject_name(cert.get());
+        X509_NAME_add_entry_by_txt(
+            name, "CN", MBSTRING_ASC, reinterpret_cast<const unsigned char*>("localhost"), -1, -1, 0);
+        X509_set_issuer_name(cert.get(), name);
+
+        if (X509_sign(cert.get(), key.get(), EVP_sha256()) == 0 ||
+            SSL_CTX_use_certificate(context.native_handle(), cert.get()) != 1 ||
+            SSL_CTX_use_PrivateKey(context.native_handle(), key.get()) != 1)
+        {
+            throw std::runtime_error("Cannot set up the mock manager certificate");
+        }
+    }
+
+    uint64_t SteadyNowNs()
+    {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                         std::chrono::steady_clock::now().time_since_epoch())
+                                         .count());
+    }
+
+    std::chrono::microseconds ThreadCpuTime()
+    {
+        timespec ts {};
+        clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+        return std::chrono::seconds(ts.tv_sec) +
+               std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::nanoseconds(ts.tv_nsec));
+    }
+} // namespace
+
+namespace load_harness
+{
+    MockManager::MockManager(MockManagerOptions options)
+        : m_options(options)
+        , m_sslContext(boost::asio::ssl::context::tls_server)
+        , m_acceptor(m_ioContext)
+        , m_random(std::random_device {}())
+    {
+        UseSelfSignedCertificate(m_sslContext);
+    }
+
+    MockManager::~MockManager()
+    {
+        Stop();
+    }
+
+    unsigned short MockManager::Start()
+    {
+        const boost::asio::ip::tcp::endpoint endpoint(boost::asio::ip::address_v4::loopback(), 0);
+        m_acceptor.open(endpoint.protocol());
+        m_acceptor.set_option(boost::asio::socket_base::reuse_address(true));
+        m_acceptor.bind(endpoint);
+        m_acceptor.listen();
+
+        m_running.store(true);
+        boost::asio::co_spawn(m_ioContext, Listener(), boost::asio::detached);
+
+        m_thread = std::thread(
+            [this]()
+            {
+                m_ioContext.run();
+                m_stats.cpuTime = ThreadCpuTime();
+            });
+
+        return m_acceptor.local_endpoint().port();
+    }
+
+    void MockManager::Stop()
+    {
+        if (!m_running.exchange(false))
+        {
+            return;
+        }
+
+        boost::asio::post(m_ioContext,
+                          [this]()
+                          {
+                              boost::system::error_code ec;
+                              m_acceptor.close(ec);
+                              m_ioContext.stop();
+                          });
+
+        if (m_thread.joinable())
+        {
+            m_thread.join();
+        }
+    }
+
+    uint64_t MockManager::AckedEvents() const
+    {
+        return m_ackedEvents.load();
+    }
+
+    MockManagerStats MockManager::Stats() const
+    {
+        auto stats = m_stats;
+        stats.ackedEvents = m_ackedEvents.load();
+        return stats;
+    }
+
+    boost::asio::awaitable<void> MockManager::Listener()
+    {
+        while (m_running.load())
+        {
+            boost::system::error_code ec;
+            auto socket =
+                co_await m_acceptor.async_accept(boost::asio::redirect_error(boost::asio::use_awaitable, ec));
+
+            if (ec)
+            {
+                break;
+            }
+
+            socket.set_option(boost::asio::ip::tcp::no_delay(true), ec);
+            boost::asio::co_spawn(m_ioContext, Session(std::move(socket)), boost::asio::detached);
+        }
+    }
+
+    boost::asio::awaitable<void> MockManager::Session(boost::asio::ip::tcp::socket socket)
+    {
+        boost::beast::ssl_stream<boost::beast::tcp_stream> stream(std::move(socket), m_sslContext);
+        boost::system::error_code ec;
+
+        co_await stream.async_handshake(boost::asio::ssl::stream_base::server,
+                                        boost::asio::redirect_error(boost::asio::use_awaitable, ec));
+
+        if (ec)
+        {
+            co_return;
+        }
+
+        boost::beast::flat_buffer buffer;
+
+        while (m_running.load())
+        {
+            http::request_parser<http::string_body> parser;
+            parser.body_limit(MAX_BODY_SIZE);
+
+            co_await http::async_read(
+                stream, buffer, parser, boost::asio::redirect_error(boost::asio::use_awaitable, ec));
+
+            if (ec)
+            {
+                break;
+            }
+
+            const auto request = parser.release();
+            auto response = co_await HandleRequest(request);
+            response.keep_alive(request.keep_alive());
+            response.prepare_payload();
+
+            co_await http::async_write(stream, response, boost::asio::redirect_error(boost::asio::use_awaitable, ec));
+
+            if (ec || !response.keep_alive())
+            {
+                break;
+            }
+        }
+
+        co_await stream.async_shutdown(boost::asio::redirect_error(boost::asio::use_awaitable, ec));
+    }
+
+    boost::asio::awaitable<MockManager::Response> MockManager::HandleRequest(const Request& request)
+    {
+        std::string target(request.target());
+        target = target.substr(0, target.find('?'));
+
+        Response response {http::status::ok, request.version()};
+        response.set(http::field::content_type, "application/json");
+        m_stats.receivedBytes += request.body().size();
+
+        if (target == "/api/v1/authentication")
+        {
+            ++m_stats.authenticationRequests;
+            response.body() = nlohmann::json {{"token", MakeToken()}}.dump();
+        }
+        else if (target == "/api/v1/events/stateless" || target == "/api/v1/events/stateful")
+        {
+            ++(target.ends_with("stateless") ? m_stats.statelessRequests : m_stats.statefulRequests);
+            co_await Delay(m_options.latency, m_options.latencyJitter);
+
+            if (InjectError())
+            {
+                ++m_stats.injectedErrors;
+                response.result(m_options.errorStatus);
+            }
+            else
+            {
+                RecordEvents(request.body());
+                response.body() = R"({"message":"ok"})";
+            }
+        }
+        else if (target == "/api/v1/commands")
+        {
+            ++m_stats.commandsRequests;
+            co_await Delay(m_options.commandsHold, std::chrono::milliseconds {0});
+            response.result(http::status::request_timeout);
+        }
+        else
+        {
+            response.result(http::status::not_found);
+        }
+
+        co_return response;
+    }
+
+    void MockManager::RecordEvents(const std::string& body)
+    {
+        const auto now = SteadyNowNs();
+        const std::string_view view(body);
+        uint64_t acked = 0;
+
+        for (auto pos = view.find(SENT_FIELD); pos != std::string_view::npos; pos = view.find(SENT_FIELD, pos))
+        {
+            pos += SENT_FIELD.size();
+
+            uint64_t sent = 0;
+            const auto [end, ec] = std::from_chars(view.data() + pos, view.data() + view.size(), sent);
+
+            if (ec == std::errc() && sent <= now)
+            {
+                m_stats.latenciesUs.push_back((now - sent) / 1000);
+                ++acked;
+            }
+
+            pos = static_cast<size_t>(end - view.data());
+        }
+
+        m_ackedEvents.fetch_add(acked);
+    }
+
+    boost::asio::awaitable<void> MockManager::Delay(std::chrono::milliseconds fixed, std::chrono::milliseconds jitter)
+    {
+        auto delay = fixed;
+
+        if (jitter.count() > 0)
+        {
+            std::uniform_int_distribution<long long> distribution(0, jitter.count());
+            delay += std::chrono::milliseconds(distribution(m_random));
+        }
+
+        if (delay.count() > 0)
+        {
+            boost::asio::steady_timer timer(co_await boost::asio::this_coro::executor, delay);
+            boost::system::error_code ec;
+            co_await timer.async_wait(boost::asio::redirect_error(boost::asio::use_awaitable, ec));
+        }
+    }
+
+    bool MockManager::InjectError()
+    {
+        if (m_options.errorRate <= 0.0)
+        {
+            return false;
+        }
+
+        std::bernoulli_distribution distribution(std::min(m_options.errorRate, 1.0));
+        return distribution(m_random);
+    }
+
+    std::string MockManager::MakeToken()
+    {
+        const auto now = std::chrono::system_clock::now();
+        const auto toSeconds = [](auto timePoint)
+        {
+            return std::chrono::duration_cast<std::chrono::seconds>(timePoint.time_since_epoch()).count();
+        };
+
+        const nlohmann::json header = {{"alg", "HS256"}, {"typ", "JWT"}};
+        const nlohmann::json payload = {{"iss", "Wazuh"},
+                                        {"aud", "Wazuh Communications API"},
+                                        {"iat", toSeconds(now)},
+                                        {"exp", toSeconds(now + TOKEN_LIFETIME)}};
+
+        const auto signingInput = Base64UrlEncode(header.dump()) + "." + Base64UrlEncode(payload.dump());
+
+        std::array<unsigned char, EVP_MAX_MD_SIZE> signature {};
+        unsigned int signatureSize = 0;
+        HMAC(EVP_sha256(),
+             TOKEN_SECRET,
+             static_cast<int>(std::char_traits<char>::length(TOKEN_SECRET)),
+             reinterpret_cast<const unsigned char*>(signingInput.data()),
+             signingInput.size(),
+             signature.data(),
+             &signatureSize);
+
+        return signingInput + "." + Base64UrlEncode(signature.data(), signatureSize);
+    }
+} // namespace load_harness